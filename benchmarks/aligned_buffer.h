@@ -0,0 +1,49 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <malloc.h>
+
+/// <summary>
+/// Aligned heap buffer for benchmark working sets and unbuffered I/O.
+/// </summary>
+class aligned_buffer {
+	void* _p = nullptr;
+
+public:
+	aligned_buffer(size_t bytes, size_t alignment = 64) :
+		_p(_aligned_malloc(bytes, alignment)) {}
+	~aligned_buffer() { _aligned_free(_p); }
+
+	template <typename T>
+	T* get() { return static_cast<T*>(_p); }
+
+	bool valid() const { return _p != nullptr; }
+
+private:
+	aligned_buffer() = delete;
+	aligned_buffer(const aligned_buffer&) = delete;
+	aligned_buffer& operator=(const aligned_buffer&) = delete;
+};
@@ -0,0 +1,103 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "benchmark_runner.h"
+
+benchmark_runner::benchmark_runner() {}
+
+benchmark_runner::~benchmark_runner() {
+	shutdown();
+}
+
+void benchmark_runner::start() {
+	if (_running)
+		return;
+
+	if (_worker.joinable())
+		_worker.join();
+
+	reset();
+	_error.clear();
+	_progress = 0.f;
+	_stop = false;
+	_running = true;
+
+	try {
+		_worker = std::thread([this]() {
+			try {
+				run();
+			}
+			catch (const std::exception& e) {
+				_error = e.what();
+			}
+
+			if (_error.empty() && _stop)
+				_error = "Benchmark stopped";
+
+			_progress = 100.f;
+			_running = false;
+			});
+	}
+	catch (const std::exception& e) {
+		_error = e.what();
+		_running = false;
+	}
+}
+
+bool benchmark_runner::running() {
+	return _running;
+}
+
+bool benchmark_runner::running(float& progress) {
+	progress = _progress;
+	return _running;
+}
+
+void benchmark_runner::stop() {
+	_stop = true;
+}
+
+bool benchmark_runner::finish(std::string& error) {
+	if (_running) {
+		error = "Benchmark still running";
+		return false;
+	}
+
+	if (_worker.joinable())
+		_worker.join();
+
+	if (!_error.empty()) {
+		error = _error;
+		return false;
+	}
+
+	return true;
+}
+
+void benchmark_runner::shutdown() {
+	stop();
+
+	if (_worker.joinable())
+		_worker.join();
+}
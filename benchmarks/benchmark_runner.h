@@ -0,0 +1,99 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/// <summary>
+/// Base class for benchmarks that run on a worker thread.
+/// </summary>
+/// <remarks>
+/// Call <see cref="start"/> then poll <see cref="running"/> until it returns false, then get the
+/// results from the derived class. Derived classes implement <see cref="run"/>, report progress
+/// through _progress, check _stop between steps and must call <see cref="shutdown"/> in their
+/// destructor so the worker thread never outlives their members.
+/// </remarks>
+class benchmark_runner {
+public:
+	benchmark_runner();
+	virtual ~benchmark_runner();
+
+	/// <summary>
+	/// Start the benchmark on a worker thread.
+	/// </summary>
+	void start();
+
+	/// <summary>
+	/// Check whether the benchmark is still running.
+	/// </summary>
+	bool running();
+
+	/// <summary>
+	/// Check whether the benchmark is still running.
+	/// </summary>
+	/// <param name="progress">The progress, as a percentage.</param>
+	bool running(float& progress);
+
+	/// <summary>
+	/// Ask the benchmark to stop at the next opportunity.
+	/// </summary>
+	void stop();
+
+protected:
+	/// <summary>
+	/// Clear previous results before a new run. Called on the calling thread by <see cref="start"/>.
+	/// </summary>
+	virtual void reset() = 0;
+
+	/// <summary>
+	/// Run the benchmark. Called on the worker thread. Set _error on failure.
+	/// </summary>
+	virtual void run() = 0;
+
+	/// <summary>
+	/// Wait for the worker thread and get its error, if any.
+	/// </summary>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if the run completed without error, else false.</returns>
+	bool finish(std::string& error);
+
+	/// <summary>
+	/// Stop the benchmark and wait for the worker thread to exit.
+	/// </summary>
+	void shutdown();
+
+	std::atomic<float> _progress = 0.f;
+	std::atomic<bool> _stop = false;
+	std::string _error;
+
+private:
+	std::thread _worker;
+	std::atomic<bool> _running = false;
+
+	benchmark_runner(const benchmark_runner&) = delete;
+	benchmark_runner& operator=(const benchmark_runner&) = delete;
+};
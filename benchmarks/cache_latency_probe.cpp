@@ -0,0 +1,276 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "cache_latency_probe.h"
+#include "aligned_buffer.h"
+#include "parallel.h"
+#include "pointer_chase.h"
+#include "../collectors/cpu_topology.h"
+
+// leccore
+#include <liblec/leccore/system.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	const unsigned long long smallest_size = 4 * 1024;
+	const unsigned long long largest_size = 128 * 1024 * 1024;
+
+	// default private cache sweep limit if the topology cannot be read
+	const unsigned long long default_private_limit = 2 * 1024 * 1024;
+
+	// consecutive points further apart than this are a transition between levels
+	const double jump_ratio = 1.25;
+
+	// cores slower than the fastest by more than this are flagged
+	const double slow_core_ratio = 1.15;
+
+	// enough loads for a stable figure at every size without dragging out the dram points
+	size_t loads_for(size_t lines) {
+		return std::min<size_t>(std::max<size_t>(lines * 4, 256 * 1024), 2 * 1024 * 1024);
+	}
+
+	std::vector<unsigned long long> sizes_up_to(unsigned long long limit) {
+		std::vector<unsigned long long> sizes;
+		for (unsigned long long size = smallest_size; size <= limit; size *= 2)
+			sizes.push_back(size);
+
+		return sizes;
+	}
+}
+
+cache_latency_probe::cache_latency_probe() {}
+
+cache_latency_probe::~cache_latency_probe() {
+	shutdown();
+}
+
+bool cache_latency_probe::result(probe_results& results, std::string& error) {
+	if (!finish(error))
+		return false;
+
+	results = _results;
+	return true;
+}
+
+void cache_latency_probe::reset() {
+	_results = {};
+}
+
+void cache_latency_probe::run() {
+	if (probe_cores())
+		probe_curve();
+}
+
+bool cache_latency_probe::probe_cores() {
+	// one logical processor per physical core, and the size of the largest private cache
+	std::vector<unsigned long> processors;
+	unsigned long long private_limit = default_private_limit;
+
+	cpu_topology::topology_info topology;
+	std::string error;
+
+	if (cpu_topology().read(topology, error)) {
+		unsigned long long largest_private = 0;
+
+		for (const auto& core : topology.cores) {
+			if (!core.logical_processors.empty())
+				processors.push_back(core.logical_processors.front());
+		}
+
+		for (const auto& cache : topology.caches) {
+			// a cache is private if no more than one core's siblings share it
+			for (const auto& core : topology.cores) {
+				if (!core.logical_processors.empty() &&
+					core.logical_processors.front() == cache.shared_by.front() &&
+					cache.shared_by.size() <= core.logical_processors.size())
+					largest_private = std::max(largest_private, cache.size);
+			}
+		}
+
+		if (largest_private > 0)
+			private_limit = std::min<unsigned long long>(largest_private * 2, 8 * 1024 * 1024);
+	}
+
+	if (processors.empty())
+		processors = parallel::processors();
+
+	const auto sizes = sizes_up_to(private_limit);
+	_results.cores.resize(processors.size());
+
+	parallel::run(processors, [&](unsigned long index) {
+		auto& core = _results.cores[index];
+		core.processor = processors[index];
+
+		aligned_buffer buffer(static_cast<size_t>(private_limit));
+		if (!buffer.valid())
+			return;
+
+		double log_sum = 0.0;
+
+		for (const auto& size : sizes) {
+			if (_stop)
+				return;
+
+			const size_t lines = static_cast<size_t>(size / pointer_chase::cache_line);
+			pointer_chase::build(buffer.get<char>(), lines, size + index);
+
+			point p;
+			p.size = size;
+			p.latency = pointer_chase::measure(buffer.get<char>(), loads_for(lines), lines);
+			core.points.push_back(p);
+
+			log_sum += std::log(std::max(p.latency, 0.001));
+		}
+
+		if (!core.points.empty())
+			core.latency = std::exp(log_sum / core.points.size());
+		});
+
+	if (_stop)
+		return false;
+
+	// flag cores noticeably slower than the fastest one
+	double fastest = 0.0;
+	for (const auto& core : _results.cores) {
+		if (core.latency > 0.0 && (fastest == 0.0 || core.latency < fastest))
+			fastest = core.latency;
+	}
+
+	for (auto& core : _results.cores)
+		core.slow = fastest > 0.0 && core.latency > slow_core_ratio * fastest;
+
+	_progress = 40.f;
+	return true;
+}
+
+bool cache_latency_probe::probe_curve() {
+	const auto sizes = sizes_up_to(largest_size);
+
+	// run the full sweep on the first processor alone so shared caches are not contended
+	const std::vector<unsigned long> first = { parallel::processors().front() };
+
+	parallel::run(first, [&](unsigned long) {
+		aligned_buffer buffer(static_cast<size_t>(largest_size));
+
+		if (!buffer.valid()) {
+			_error = "Insufficient memory for the cache latency probe";
+			return;
+		}
+
+		for (size_t i = 0; i < sizes.size(); i++) {
+			if (_stop)
+				return;
+
+			const size_t lines = static_cast<size_t>(sizes[i] / pointer_chase::cache_line);
+			pointer_chase::build(buffer.get<char>(), lines, sizes[i]);
+
+			point p;
+			p.size = sizes[i];
+			p.latency = pointer_chase::measure(buffer.get<char>(), loads_for(lines), std::min<size_t>(lines, 1024 * 1024));
+			_results.curve.push_back(p);
+
+			_progress = 40.f + 60.f * (i + 1) / sizes.size();
+		}
+		});
+
+	if (!_error.empty() || _stop)
+		return false;
+
+	_results.levels = detect_levels(_results.curve);
+	return true;
+}
+
+std::vector<cache_latency_probe::level> cache_latency_probe::detect_levels(const std::vector<point>& curve) {
+	std::vector<level> levels;
+	std::vector<double> plateau;
+	unsigned long long plateau_size = 0;
+
+	auto close_plateau = [&]() {
+		if (plateau.empty())
+			return;
+
+		// the median is robust against the first point of a plateau still settling
+		std::sort(plateau.begin(), plateau.end());
+
+		level l;
+		l.name = "L" + std::to_string(levels.size() + 1);
+		l.size = plateau_size;
+		l.latency = plateau[plateau.size() / 2];
+		levels.push_back(l);
+		plateau.clear();
+	};
+
+	for (size_t i = 0; i < curve.size(); i++) {
+		const bool jump = i > 0 && curve[i - 1].latency > 0.0 &&
+			curve[i].latency / curve[i - 1].latency > jump_ratio;
+
+		if (jump) {
+			// points within a transition belong to no level
+			close_plateau();
+			continue;
+		}
+
+		plateau.push_back(curve[i].latency);
+		plateau_size = curve[i].size;
+	}
+
+	const bool ends_in_transition = plateau.empty();
+	close_plateau();
+
+	if (ends_in_transition && !curve.empty()) {
+		// the largest working sets never settled, take the last point for memory
+		level l;
+		l.latency = curve.back().latency;
+		levels.push_back(l);
+	}
+
+	// the outermost level is main memory, which has no size limit
+	if (levels.size() > 1) {
+		levels.back().name = "DRAM";
+		levels.back().size = 0;
+	}
+
+	return levels;
+}
+
+std::string cache_latency_probe::summary(const probe_results& results) {
+	std::string text;
+
+	for (const auto& l : results.levels) {
+		if (!text.empty())
+			text += ", ";
+
+		text += l.name + " " + liblec::leccore::round_off::to_string(l.latency, l.latency < 10.0 ? 1 : 0) + "ns";
+	}
+
+	const auto slow_cores = std::count_if(results.cores.begin(), results.cores.end(),
+		[](const core_result& core) { return core.slow; });
+
+	if (slow_cores > 0)
+		text += ", " + std::to_string(slow_cores) + (slow_cores == 1 ? " slow core" : " slow cores");
+
+	return text;
+}
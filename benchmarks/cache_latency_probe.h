@@ -0,0 +1,113 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Cache hierarchy latency probe.
+/// </summary>
+/// <remarks>
+/// Sweeps pointer chase working sets from 4KB to 128MB to produce a latency-vs-size curve and
+/// detects the cache level boundaries from the jumps in that curve. The private cache range is
+/// also swept on every core at once (one thread per physical core) to find cores that are slower
+/// than the rest, e.g. the efficiency cores of a hybrid cpu. The probe runs on a worker thread,
+/// see benchmark_runner.
+/// </remarks>
+class cache_latency_probe : public benchmark_runner {
+public:
+	struct point {
+		/// <summary>The working set size, in bytes.</summary>
+		unsigned long long size = 0;
+
+		/// <summary>The load-to-use latency, in nanoseconds.</summary>
+		double latency = 0.0;
+	};
+
+	struct level {
+		/// <summary>The level name, e.g. "L2" or "DRAM".</summary>
+		std::string name;
+
+		/// <summary>The largest working set that still fit in the level, in bytes. Zero for DRAM.</summary>
+		unsigned long long size = 0;
+
+		/// <summary>The level's latency, in nanoseconds.</summary>
+		double latency = 0.0;
+	};
+
+	struct core_result {
+		/// <summary>The logical processor the core was probed on.</summary>
+		unsigned long processor = 0;
+
+		/// <summary>The core's latency curve over its private caches.</summary>
+		std::vector<point> points;
+
+		/// <summary>The geometric mean latency over the curve, in nanoseconds.</summary>
+		double latency = 0.0;
+
+		/// <summary>Whether the core is noticeably slower than the fastest core.</summary>
+		bool slow = false;
+	};
+
+	struct probe_results {
+		std::vector<point> curve;
+		std::vector<level> levels;
+		std::vector<core_result> cores;
+	};
+
+	cache_latency_probe();
+	~cache_latency_probe();
+
+	/// <summary>
+	/// Get the probe results.
+	/// </summary>
+	/// <param name="results">The results.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool result(probe_results& results, std::string& error);
+
+	/// <summary>
+	/// Detect cache levels from a latency-vs-size curve.
+	/// </summary>
+	/// <param name="curve">The curve, ordered by increasing size.</param>
+	/// <returns>The levels, from L1 outwards, ending with DRAM.</returns>
+	static std::vector<level> detect_levels(const std::vector<point>& curve);
+
+	/// <summary>
+	/// Get a one line summary of the levels, e.g. "L1 1.2ns, L2 4.1ns, L3 14ns, DRAM 88ns".
+	/// </summary>
+	static std::string summary(const probe_results& results);
+
+private:
+	void reset() override;
+	void run() override;
+	bool probe_cores();
+	bool probe_curve();
+
+	probe_results _results;
+};
@@ -0,0 +1,275 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "cpu_benchmark.h"
+#include "parallel.h"
+#include "work_stealing_pool.h"
+#include "../collectors/cpu_features.h"
+#include "../collectors/cpu_topology.h"
+
+#include <intrin.h>
+#include <immintrin.h>
+#include <liblec/leccore/system.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+	// iterations per task; a task takes a few milliseconds so that stealing can even out the load
+	const size_t iterations = 1024 * 1024;
+
+	// tasks per thread in each timed run
+	const size_t tasks_per_thread = 16;
+
+	// each run is timed this many times and the best run is kept
+	const int repetitions = 2;
+
+	// scaling efficiency below this percentage is reported as poor
+	const double poor_scaling_threshold = 70.0;
+
+	enum class kernel { integer, floating_point, simd_sse2, simd_avx };
+
+	// results are accumulated here so the compiler cannot discard the kernels
+	std::atomic<uint64_t> sink = 0;
+
+	// four independent xorshift64* chains, 7 operations each per iteration
+	const double integer_ops = 4.0 * 7.0;
+
+	uint64_t run_integer(size_t task) {
+		uint64_t a = task + 1, b = task + 2, c = task + 3, d = task + 4;
+
+		for (size_t i = 0; i < iterations; i++) {
+			a ^= a << 13; a ^= a >> 7; a ^= a << 17; a *= 0x2545f4914f6cdd1d;
+			b ^= b << 13; b ^= b >> 7; b ^= b << 17; b *= 0x2545f4914f6cdd1d;
+			c ^= c << 13; c ^= c >> 7; c ^= c << 17; c *= 0x2545f4914f6cdd1d;
+			d ^= d << 13; d ^= d >> 7; d ^= d << 17; d *= 0x2545f4914f6cdd1d;
+		}
+
+		return a ^ b ^ c ^ d;
+	}
+
+	// eight independent multiply-add chains that converge on 1.0, 2 operations each per iteration
+	const double floating_point_ops = 8.0 * 2.0;
+	const double m = 0.999999, k = 0.000001;
+
+	uint64_t run_floating_point(size_t task) {
+		double a = 1.0 + task, b = 2.0, c = 3.0, d = 4.0, e = 5.0, f = 6.0, g = 7.0, h = 8.0;
+
+		for (size_t i = 0; i < iterations; i++) {
+			a = a * m + k; b = b * m + k; c = c * m + k; d = d * m + k;
+			e = e * m + k; f = f * m + k; g = g * m + k; h = h * m + k;
+		}
+
+		return static_cast<uint64_t>(a + b + c + d + e + f + g + h);
+	}
+
+	// the same chains as the scalar kernel, eight registers wide
+	const double simd_sse2_ops = 8.0 * 2.0 * 2.0;
+	const double simd_avx_ops = 8.0 * 4.0 * 2.0;
+
+	uint64_t run_simd_sse2(size_t task) {
+		const __m128d vm = _mm_set1_pd(m), vk = _mm_set1_pd(k);
+		__m128d r[8];
+
+		for (int j = 0; j < 8; j++)
+			r[j] = _mm_set1_pd(1.0 + task + j);
+
+		for (size_t i = 0; i < iterations; i++)
+			for (int j = 0; j < 8; j++)
+				r[j] = _mm_add_pd(_mm_mul_pd(r[j], vm), vk);
+
+		__m128d sum = r[0];
+		for (int j = 1; j < 8; j++)
+			sum = _mm_add_pd(sum, r[j]);
+
+		return static_cast<uint64_t>(_mm_cvtsd_f64(sum));
+	}
+
+	uint64_t run_simd_avx(size_t task) {
+		const __m256d vm = _mm256_set1_pd(m), vk = _mm256_set1_pd(k);
+		__m256d r[8];
+
+		for (int j = 0; j < 8; j++)
+			r[j] = _mm256_set1_pd(1.0 + task + j);
+
+		for (size_t i = 0; i < iterations; i++)
+			for (int j = 0; j < 8; j++)
+				r[j] = _mm256_add_pd(_mm256_mul_pd(r[j], vm), vk);
+
+		__m256d sum = r[0];
+		for (int j = 1; j < 8; j++)
+			sum = _mm256_add_pd(sum, r[j]);
+
+		const double result = _mm256_cvtsd_f64(sum);
+
+		// avoid sse/avx transition penalties in whatever runs next
+		_mm256_zeroupper();
+		return static_cast<uint64_t>(result);
+	}
+
+	double ops_per_iteration(kernel k) {
+		switch (k) {
+		case kernel::integer: return integer_ops;
+		case kernel::floating_point: return floating_point_ops;
+		case kernel::simd_sse2: return simd_sse2_ops;
+		case kernel::simd_avx: return simd_avx_ops;
+		default: return 0.0;
+		}
+	}
+
+	uint64_t run_kernel(kernel k, size_t task) {
+		switch (k) {
+		case kernel::integer: return run_integer(task);
+		case kernel::floating_point: return run_floating_point(task);
+		case kernel::simd_sse2: return run_simd_sse2(task);
+		case kernel::simd_avx: return run_simd_avx(task);
+		default: return 0;
+		}
+	}
+}
+
+cpu_benchmark::cpu_benchmark() {}
+
+cpu_benchmark::~cpu_benchmark() {
+	shutdown();
+}
+
+bool cpu_benchmark::result(benchmark_results& results, std::string& error) {
+	if (!finish(error))
+		return false;
+
+	results = _results;
+	return true;
+}
+
+double cpu_benchmark::score(const benchmark_results& results, bool all_threads) {
+	const throughput* kernels[] = { &results.integer, &results.floating_point, &results.simd };
+	double log_sum = 0.0;
+
+	for (const auto& kernel : kernels) {
+		const double ops = all_threads ? kernel->all : kernel->single;
+
+		if (ops <= 0.0)
+			return 0.0;
+
+		log_sum += std::log(ops / 1.e9);
+	}
+
+	return 100.0 * std::exp(log_sum / 3.0);
+}
+
+double cpu_benchmark::efficiency(const benchmark_results& results) {
+	const double single = score(results, false);
+
+	if (single <= 0.0 || results.cores == 0)
+		return 0.0;
+
+	return 100.0 * score(results, true) / (single * results.cores);
+}
+
+double cpu_benchmark::thread_efficiency(const benchmark_results& results) {
+	const double single = score(results, false);
+
+	if (single <= 0.0 || results.threads == 0)
+		return 0.0;
+
+	return 100.0 * score(results, true) / (single * results.threads);
+}
+
+bool cpu_benchmark::poor_scaling(const benchmark_results& results) {
+	const double value = efficiency(results);
+	return value > 0.0 && value < poor_scaling_threshold;
+}
+
+std::string cpu_benchmark::summary(const benchmark_results& results) {
+	if (score(results, false) <= 0.0)
+		return "Not run";
+
+	return "Single " + liblec::leccore::round_off::to_string(score(results, false), 0) +
+		", all " + liblec::leccore::round_off::to_string(score(results, true), 0) +
+		" (" + std::to_string(results.cores) + (results.cores == 1 ? " core, " : " cores, ") +
+		std::to_string(results.threads) + " threads), " +
+		liblec::leccore::round_off::to_string(efficiency(results), 0) + "% scaling";
+}
+
+void cpu_benchmark::reset() {
+	_results = {};
+}
+
+void cpu_benchmark::run() {
+	// pick the widest simd kernel the cpu and os support
+	cpu_features::features_info features;
+	std::string error;
+	const bool avx = cpu_features().read(features, error) &&
+		features.features.test(static_cast<size_t>(cpu_features::feature::avx));
+
+	_results.simd_kernel = avx ? "AVX" : "SSE2";
+
+	const auto all = parallel::processors();
+	const std::vector<unsigned long> single = { all.front() };
+	_results.threads = static_cast<unsigned long>(all.size());
+
+	// smt siblings count once, they share their core's execution units
+	cpu_topology::topology_info topology;
+	_results.cores = cpu_topology().read(topology, error) && !topology.cores.empty() ?
+		static_cast<unsigned long>(std::min(topology.cores.size(), all.size())) : _results.threads;
+
+	const kernel kernels[] = { kernel::integer, kernel::floating_point, avx ? kernel::simd_avx : kernel::simd_sse2 };
+	throughput* results[] = { &_results.integer, &_results.floating_point, &_results.simd };
+
+	const float steps = static_cast<float>(3 * 2 * repetitions);
+	float step = 0.f;
+
+	for (int k = 0; k < 3; k++) {
+		for (const auto* processors : { &single, &all }) {
+			const size_t task_count = tasks_per_thread * processors->size();
+			double best = 0.0;
+
+			for (int repetition = 0; repetition < repetitions; repetition++) {
+				if (_stop)
+					return;
+
+				const double seconds = work_stealing_pool::run(*processors, task_count, [&](size_t task) {
+					sink += run_kernel(kernels[k], task);
+					});
+
+				if (seconds > 0.0 && (best == 0.0 || seconds < best))
+					best = seconds;
+
+				_progress = 100.f * (++step) / steps;
+			}
+
+			if (best > 0.0) {
+				const double ops = ops_per_iteration(kernels[k]) * iterations * task_count / best;
+
+				if (processors == &single)
+					results[k]->single = ops;
+				else
+					results[k]->all = ops;
+			}
+		}
+	}
+}
@@ -0,0 +1,134 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <string>
+
+/// <summary>
+/// CPU throughput benchmark.
+/// </summary>
+/// <remarks>
+/// Integer, scalar floating-point and SIMD kernels are each run on a single thread and then on
+/// every logical processor through a work_stealing_pool. Comparing the two gives the scaling
+/// efficiency, which drops well below 100% on hosts with parked or disabled cores or with a
+/// power plan that keeps the cores from boosting under load. Efficiency is measured against
+/// the physical cores, since SMT siblings share a core's execution units and add only a
+/// fraction of its throughput.
+/// The benchmark runs on a worker thread, see benchmark_runner.
+/// </remarks>
+class cpu_benchmark : public benchmark_runner {
+public:
+	struct throughput {
+		/// <summary>Operations per second on a single thread.</summary>
+		double single = 0.0;
+
+		/// <summary>Operations per second on all logical processors.</summary>
+		double all = 0.0;
+	};
+
+	struct benchmark_results {
+		/// <summary>Integer operations (shift, xor, multiply) per second.</summary>
+		throughput integer;
+
+		/// <summary>Scalar double precision floating-point operations per second.</summary>
+		throughput floating_point;
+
+		/// <summary>Vector double precision floating-point operations per second.</summary>
+		throughput simd;
+
+		/// <summary>The number of threads used for the all-thread run.</summary>
+		unsigned long threads = 0;
+
+		/// <summary>The number of physical cores those threads run on.</summary>
+		unsigned long cores = 0;
+
+		/// <summary>The instruction set the SIMD kernel used, e.g. "AVX".</summary>
+		std::string simd_kernel;
+	};
+
+	cpu_benchmark();
+	~cpu_benchmark();
+
+	/// <summary>
+	/// Get the benchmark results.
+	/// </summary>
+	/// <param name="results">The results.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool result(benchmark_results& results, std::string& error);
+
+	/// <summary>
+	/// Get the combined score.
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	/// <param name="all_threads">Whether to score the all-thread run rather than the single thread run.</param>
+	/// <returns>
+	/// The geometric mean of the three kernels' throughput in billions of operations per second,
+	/// times 100. Returns 0 if the benchmark has not run.
+	/// </returns>
+	static double score(const benchmark_results& results, bool all_threads);
+
+	/// <summary>
+	/// Get the scaling efficiency per physical core.
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	/// <returns>
+	/// The all-thread score as a percentage of the single thread score times the core count.
+	/// May exceed 100% on cores with SMT.
+	/// </returns>
+	static double efficiency(const benchmark_results& results);
+
+	/// <summary>
+	/// Get the scaling efficiency per thread.
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	/// <returns>
+	/// The all-thread score as a percentage of the single thread score times the thread count.
+	/// Well below 100% on cores with SMT, so only informative next to <see cref="efficiency"/>.
+	/// </returns>
+	static double thread_efficiency(const benchmark_results& results);
+
+	/// <summary>
+	/// Check whether the all-thread run scaled poorly, which points to parked or disabled cores
+	/// or to a restrictive power plan.
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	/// <returns>Returns true if the per core scaling efficiency is below 70%, else false.</returns>
+	static bool poor_scaling(const benchmark_results& results);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "Single 412, all 3,020 (8 cores, 16 threads), 92% scaling".
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	static std::string summary(const benchmark_results& results);
+
+private:
+	void reset() override;
+	void run() override;
+
+	benchmark_results _results;
+};
@@ -0,0 +1,226 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "memory_benchmark.h"
+#include "parallel.h"
+#include "pointer_chase.h"
+#include "aligned_buffer.h"
+#include "../collectors/cpu_features.h"
+
+#include <intrin.h>
+#include <immintrin.h>
+
+namespace {
+	// elements per array (64MB of doubles), large enough to defeat any cache
+	const size_t array_elements = 8 * 1024 * 1024;
+
+	// kernels are timed this many times and the best run is kept, as STREAM does
+	const int repetitions = 5;
+
+	// pointer chase buffer and number of dependent loads
+	const size_t chase_bytes = 128 * 1024 * 1024;
+	const size_t chase_loads = 4 * 1024 * 1024;
+
+	const double scalar = 3.0;
+
+	enum class kernel { copy, scale, add, triad };
+
+	// each thread works on a chunk that is a multiple of 8 doubles so that 32 byte loads stay aligned
+	void chunk(size_t elements, unsigned long threads, unsigned long index, size_t& begin, size_t& end) {
+		const size_t per_thread = ((elements / threads) / 8) * 8;
+		begin = per_thread * index;
+		end = index + 1 == threads ? elements : begin + per_thread;
+	}
+
+	void run_sse2(kernel k, double* a, double* b, double* c, size_t begin, size_t end) {
+		const __m128d q = _mm_set1_pd(scalar);
+
+		switch (k) {
+		case kernel::copy:
+			for (size_t i = begin; i < end; i += 2)
+				_mm_store_pd(a + i, _mm_load_pd(b + i));
+			break;
+		case kernel::scale:
+			for (size_t i = begin; i < end; i += 2)
+				_mm_store_pd(a + i, _mm_mul_pd(q, _mm_load_pd(b + i)));
+			break;
+		case kernel::add:
+			for (size_t i = begin; i < end; i += 2)
+				_mm_store_pd(a + i, _mm_add_pd(_mm_load_pd(b + i), _mm_load_pd(c + i)));
+			break;
+		case kernel::triad:
+			for (size_t i = begin; i < end; i += 2)
+				_mm_store_pd(a + i, _mm_add_pd(_mm_load_pd(b + i), _mm_mul_pd(q, _mm_load_pd(c + i))));
+			break;
+		}
+	}
+
+	void run_avx(kernel k, double* a, double* b, double* c, size_t begin, size_t end) {
+		const __m256d q = _mm256_set1_pd(scalar);
+
+		switch (k) {
+		case kernel::copy:
+			for (size_t i = begin; i < end; i += 4)
+				_mm256_store_pd(a + i, _mm256_load_pd(b + i));
+			break;
+		case kernel::scale:
+			for (size_t i = begin; i < end; i += 4)
+				_mm256_store_pd(a + i, _mm256_mul_pd(q, _mm256_load_pd(b + i)));
+			break;
+		case kernel::add:
+			for (size_t i = begin; i < end; i += 4)
+				_mm256_store_pd(a + i, _mm256_add_pd(_mm256_load_pd(b + i), _mm256_load_pd(c + i)));
+			break;
+		case kernel::triad:
+			for (size_t i = begin; i < end; i += 4)
+				_mm256_store_pd(a + i, _mm256_add_pd(_mm256_load_pd(b + i), _mm256_mul_pd(q, _mm256_load_pd(c + i))));
+			break;
+		}
+
+		// avoid sse/avx transition penalties in whatever runs next
+		_mm256_zeroupper();
+	}
+
+	// bytes moved per element, counted the way STREAM counts them
+	double bytes_per_element(kernel k) {
+		return (k == kernel::add || k == kernel::triad ? 3.0 : 2.0) * sizeof(double);
+	}
+}
+
+memory_benchmark::memory_benchmark() {}
+
+memory_benchmark::~memory_benchmark() {
+	shutdown();
+}
+
+bool memory_benchmark::result(benchmark_results& results, std::string& error) {
+	if (!finish(error))
+		return false;
+
+	results = _results;
+	return true;
+}
+
+void memory_benchmark::reset() {
+	_results = {};
+}
+
+void memory_benchmark::run() {
+	if (measure_bandwidth())
+		measure_latency();
+}
+
+bool memory_benchmark::measure_bandwidth() {
+	// pick the widest kernel the cpu and os support
+	cpu_features::features_info features;
+	std::string error;
+	const bool avx = cpu_features().read(features, error) &&
+		features.features.test(static_cast<size_t>(cpu_features::feature::avx));
+
+	_results.kernel = avx ? "AVX" : "SSE2";
+	_results.threads = static_cast<unsigned long>(parallel::processors().size());
+
+	aligned_buffer buffer_a(array_elements * sizeof(double));
+	aligned_buffer buffer_b(array_elements * sizeof(double));
+	aligned_buffer buffer_c(array_elements * sizeof(double));
+
+	if (!buffer_a.valid() || !buffer_b.valid() || !buffer_c.valid()) {
+		_error = "Insufficient memory for the bandwidth benchmark";
+		return false;
+	}
+
+	double* a = buffer_a.get<double>();
+	double* b = buffer_b.get<double>();
+	double* c = buffer_c.get<double>();
+	const unsigned long threads = _results.threads;
+
+	// first touch from the threads that will use each chunk, so pages land on their numa node
+	parallel::run(threads, [&](unsigned long index) {
+		size_t begin = 0, end = 0;
+		chunk(array_elements, threads, index, begin, end);
+
+		for (size_t i = begin; i < end; i++) {
+			a[i] = 1.0;
+			b[i] = 2.0;
+			c[i] = 0.0;
+		}
+		});
+
+	const kernel kernels[] = { kernel::copy, kernel::scale, kernel::add, kernel::triad };
+	double* results[] = { &_results.copy, &_results.scale, &_results.add, &_results.triad };
+
+	// bandwidth takes up the first 80% of the progress
+	const float steps = static_cast<float>(4 * repetitions);
+	float step = 0.f;
+
+	for (int k = 0; k < 4; k++) {
+		double best = 0.0;
+
+		for (int repetition = 0; repetition < repetitions; repetition++) {
+			if (_stop)
+				return false;
+
+			const double seconds = parallel::run(threads, [&](unsigned long index) {
+				size_t begin = 0, end = 0;
+				chunk(array_elements, threads, index, begin, end);
+
+				if (avx)
+					run_avx(kernels[k], a, b, c, begin, end);
+				else
+					run_sse2(kernels[k], a, b, c, begin, end);
+				});
+
+			if (seconds > 0.0 && (best == 0.0 || seconds < best))
+				best = seconds;
+
+			_progress = 80.f * (++step) / steps;
+		}
+
+		if (best > 0.0)
+			*results[k] = bytes_per_element(kernels[k]) * array_elements / best;
+	}
+
+	return true;
+}
+
+bool memory_benchmark::measure_latency() {
+	const size_t lines = chase_bytes / pointer_chase::cache_line;
+
+	aligned_buffer buffer(chase_bytes);
+
+	if (!buffer.valid()) {
+		_error = "Insufficient memory for the latency benchmark";
+		return false;
+	}
+
+	pointer_chase::build(buffer.get<char>(), lines, 0x5eed);
+	_progress = 85.f;
+
+	if (_stop)
+		return false;
+
+	// a partial pass first warms up the tlb and page tables
+	_results.latency = pointer_chase::measure(buffer.get<char>(), chase_loads, lines / 4);
+	return true;
+}
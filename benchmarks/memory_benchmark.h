@@ -0,0 +1,83 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <string>
+
+/// <summary>
+/// Memory bandwidth and latency benchmark.
+/// </summary>
+/// <remarks>
+/// Bandwidth is measured with the four STREAM kernels (copy, scale, add and triad) running on
+/// all logical processors, using AVX when available and SSE2 otherwise. Latency is measured
+/// with a single threaded pointer chase over a buffer much larger than the last level cache.
+/// The benchmark runs on a worker thread, see benchmark_runner.
+/// </remarks>
+class memory_benchmark : public benchmark_runner {
+public:
+	struct benchmark_results {
+		/// <summary>Copy (a = b) bandwidth, in bytes per second.</summary>
+		double copy = 0.0;
+
+		/// <summary>Scale (a = q * b) bandwidth, in bytes per second.</summary>
+		double scale = 0.0;
+
+		/// <summary>Add (a = b + c) bandwidth, in bytes per second.</summary>
+		double add = 0.0;
+
+		/// <summary>Triad (a = b + q * c) bandwidth, in bytes per second.</summary>
+		double triad = 0.0;
+
+		/// <summary>Random access memory latency, in nanoseconds.</summary>
+		double latency = 0.0;
+
+		/// <summary>The number of threads used for the bandwidth kernels.</summary>
+		unsigned long threads = 0;
+
+		/// <summary>The instruction set the bandwidth kernels used, e.g. "AVX".</summary>
+		std::string kernel;
+	};
+
+	memory_benchmark();
+	~memory_benchmark();
+
+	/// <summary>
+	/// Get the benchmark results.
+	/// </summary>
+	/// <param name="results">The results.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool result(benchmark_results& results, std::string& error);
+
+private:
+	void reset() override;
+	void run() override;
+	bool measure_bandwidth();
+	bool measure_latency();
+
+	benchmark_results _results;
+};
@@ -0,0 +1,124 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "parallel.h"
+
+#include <Windows.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+std::vector<unsigned long> parallel::processors() {
+	std::vector<unsigned long> list;
+	const WORD groups = GetActiveProcessorGroupCount();
+
+	for (WORD group = 0; group < groups; group++) {
+		const DWORD count = GetActiveProcessorCount(group);
+
+		for (DWORD i = 0; i < count; i++)
+			list.push_back(group * 64 + i);
+	}
+
+	if (list.empty())
+		list.push_back(0);
+
+	return list;
+}
+
+bool parallel::pin_current_thread(unsigned long processor) {
+	GROUP_AFFINITY affinity = {};
+	affinity.Group = static_cast<WORD>(processor / 64);
+	affinity.Mask = static_cast<KAFFINITY>(1) << (processor % 64);
+
+	return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+}
+
+double parallel::run(unsigned long thread_count, const std::function<void(unsigned long)>& fn) {
+	const auto processor_list = processors();
+
+	// one thread per processor, wrapping around if more threads than processors are asked for
+	std::vector<unsigned long> list;
+	list.reserve(thread_count);
+
+	for (unsigned long i = 0; i < thread_count; i++)
+		list.push_back(processor_list[i % processor_list.size()]);
+
+	return run(list, fn);
+}
+
+double parallel::run(const std::vector<unsigned long>& processor_list, const std::function<void(unsigned long)>& fn) {
+	const unsigned long thread_count = static_cast<unsigned long>(processor_list.size());
+
+	if (thread_count == 0)
+		return 0.0;
+
+	std::atomic<unsigned long> ready = 0;
+	std::atomic<bool> go = false;
+	std::atomic<bool> abort = false;
+	std::vector<std::chrono::steady_clock::time_point> finished(thread_count);
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+
+	try {
+		for (unsigned long i = 0; i < thread_count; i++) {
+			threads.emplace_back([&, i]() {
+				pin_current_thread(processor_list[i]);
+
+				// wait for all threads to be ready so they start together
+				ready++;
+				while (!go.load(std::memory_order_acquire))
+					std::this_thread::yield();
+
+				if (abort)
+					return;
+
+				fn(i);
+				finished[i] = std::chrono::steady_clock::now();
+				});
+		}
+	}
+	catch (const std::exception&) {
+		// release and join the threads that did start before passing the error on
+		abort = true;
+		go.store(true, std::memory_order_release);
+
+		for (auto& thread : threads)
+			thread.join();
+
+		throw;
+	}
+
+	while (ready.load() < thread_count)
+		std::this_thread::yield();
+
+	const auto start = std::chrono::steady_clock::now();
+	go.store(true, std::memory_order_release);
+
+	for (auto& thread : threads)
+		thread.join();
+
+	const auto end = *std::max_element(finished.begin(), finished.end());
+	return std::chrono::duration<double>(end - start).count();
+}
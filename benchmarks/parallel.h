@@ -0,0 +1,71 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// Helpers for running benchmark work on every logical processor.
+/// </summary>
+/// <remarks>
+/// Logical processors are numbered globally as (processor group * 64) + index within the group,
+/// the same numbering used by cpu_topology.
+/// </remarks>
+class parallel {
+public:
+	/// <summary>
+	/// Get the active logical processors across all processor groups.
+	/// </summary>
+	static std::vector<unsigned long> processors();
+
+	/// <summary>
+	/// Pin the calling thread to a logical processor.
+	/// </summary>
+	/// <param name="processor">The logical processor number.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool pin_current_thread(unsigned long processor);
+
+	/// <summary>
+	/// Run a function on a number of threads, each pinned to its own logical processor.
+	/// </summary>
+	/// <param name="thread_count">The number of threads.</param>
+	/// <param name="fn">The function to run, called with the thread's index.</param>
+	/// <returns>
+	/// The time, in seconds, from the moment all threads are released together until the last
+	/// one finishes. Thread creation is not included.
+	/// </returns>
+	/// <remarks>May throw std::system_error if threads cannot be created.</remarks>
+	static double run(unsigned long thread_count, const std::function<void(unsigned long)>& fn);
+
+	/// <summary>
+	/// Run a function on one thread per listed logical processor.
+	/// </summary>
+	/// <param name="processors">The logical processors to run on.</param>
+	/// <param name="fn">The function to run, called with the thread's index into the list.</param>
+	/// <returns>The time, in seconds, from release until the last thread finishes.</returns>
+	/// <remarks>May throw std::system_error if threads cannot be created.</remarks>
+	static double run(const std::vector<unsigned long>& processors, const std::function<void(unsigned long)>& fn);
+};
@@ -0,0 +1,72 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "pointer_chase.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <vector>
+
+void pointer_chase::build(char* base, size_t lines, unsigned long long seed) {
+	if (lines == 0)
+		return;
+
+	std::vector<size_t> order(lines);
+	for (size_t i = 0; i < lines; i++)
+		order[i] = i;
+
+	// sattolo's algorithm gives a single cycle through every line
+	std::mt19937_64 engine(seed);
+	for (size_t i = lines - 1; i > 0; i--) {
+		std::uniform_int_distribution<size_t> distribution(0, i - 1);
+		std::swap(order[i], order[distribution(engine)]);
+	}
+
+	for (size_t i = 0; i < lines; i++)
+		*reinterpret_cast<void**>(base + i * cache_line) = base + order[i] * cache_line;
+}
+
+double pointer_chase::measure(char* base, size_t loads, size_t warmup_loads) {
+	if (loads == 0)
+		return 0.0;
+
+	void* p = base;
+	for (size_t i = 0; i < warmup_loads; i++)
+		p = *static_cast<void**>(p);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < loads; i++)
+		p = *static_cast<void**>(p);
+
+	const auto end = std::chrono::steady_clock::now();
+
+	// keep the chase from being optimized away
+	static std::atomic<void*> sink;
+	sink.store(p, std::memory_order_relaxed);
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / loads;
+}
@@ -0,0 +1,58 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+/// <summary>
+/// Dependent load (pointer chasing) latency measurement.
+/// </summary>
+/// <remarks>
+/// Each cache line of the working set holds a pointer to the next line in a single random cycle,
+/// so every load depends on the previous one and the hardware prefetchers cannot predict the next
+/// address. The time per load is then the load-to-use latency of whichever level of the memory
+/// hierarchy the working set fits in.
+/// </remarks>
+class pointer_chase {
+public:
+	static const size_t cache_line = 64;
+
+	/// <summary>
+	/// Link the first lines of a buffer into a single random cycle.
+	/// </summary>
+	/// <param name="base">The buffer, aligned to a cache line.</param>
+	/// <param name="lines">The number of cache lines in the working set.</param>
+	/// <param name="seed">The seed for the random order.</param>
+	static void build(char* base, size_t lines, unsigned long long seed);
+
+	/// <summary>
+	/// Chase a cycle made by <see cref="build"/>.
+	/// </summary>
+	/// <param name="base">The buffer.</param>
+	/// <param name="loads">The number of dependent loads to time.</param>
+	/// <param name="warmup_loads">The number of loads to make before timing starts.</param>
+	/// <returns>The average latency per load, in nanoseconds.</returns>
+	static double measure(char* base, size_t loads, size_t warmup_loads);
+};
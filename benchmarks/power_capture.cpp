@@ -0,0 +1,320 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "power_capture.h"
+#include "../collectors/energy_meter.h"
+
+#include <Windows.h>
+#include <SetupAPI.h>
+#include <initguid.h>
+#include <devguid.h>
+#include <batclass.h>
+#include <liblec/leccore/system.h>
+#pragma comment(lib, "SetupAPI.lib")
+#pragma comment(lib, "Winmm.lib")
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+const double power_capture::unknown = -1.0e9;
+
+namespace {
+	const unsigned min_interval = 10;
+	const unsigned max_interval = 100;
+	const unsigned max_seconds = 120;
+
+	class battery_handle {
+	public:
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		ULONG tag = 0;
+
+		battery_handle() = default;
+		battery_handle(const battery_handle&) = delete;
+		battery_handle(battery_handle&& other) noexcept :
+			handle(other.handle), tag(other.tag) {
+			other.handle = INVALID_HANDLE_VALUE;
+		}
+
+		~battery_handle() {
+			if (handle != INVALID_HANDLE_VALUE)
+				CloseHandle(handle);
+		}
+	};
+
+	// open every battery and get its tag, which status queries need
+	void open_batteries(std::vector<battery_handle>& batteries) {
+		HDEVINFO devices = SetupDiGetClassDevsA(&GUID_DEVCLASS_BATTERY, nullptr, nullptr,
+			DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+
+		if (devices == INVALID_HANDLE_VALUE)
+			return;
+
+		SP_DEVICE_INTERFACE_DATA device_interface = {};
+		device_interface.cbSize = sizeof(device_interface);
+
+		for (DWORD index = 0; SetupDiEnumDeviceInterfaces(devices, nullptr, &GUID_DEVCLASS_BATTERY, index, &device_interface); index++) {
+			DWORD size = 0;
+			SetupDiGetDeviceInterfaceDetailA(devices, &device_interface, nullptr, 0, &size, nullptr);
+
+			if (size == 0)
+				continue;
+
+			std::vector<unsigned char> buffer(size);
+			auto detail = reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_A*>(buffer.data());
+			detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_A);
+
+			if (!SetupDiGetDeviceInterfaceDetailA(devices, &device_interface, detail, size, nullptr, nullptr))
+				continue;
+
+			batteries.emplace_back();
+			auto& battery = batteries.back();
+
+			battery.handle = CreateFileA(detail->DevicePath, GENERIC_READ | GENERIC_WRITE,
+				FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			ULONG wait = 0;
+			DWORD returned = 0;
+
+			if (battery.handle == INVALID_HANDLE_VALUE ||
+				!DeviceIoControl(battery.handle, IOCTL_BATTERY_QUERY_TAG, &wait, sizeof(wait),
+					&battery.tag, sizeof(battery.tag), &returned, nullptr) ||
+				battery.tag == 0)
+				batteries.pop_back();
+		}
+
+		SetupDiDestroyDeviceInfoList(devices);
+	}
+
+	double thread_cpu_seconds() {
+		FILETIME creation = {}, exit = {}, kernel = {}, user = {};
+
+		if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+			return 0.0;
+
+		auto to_seconds = [](const FILETIME& time) {
+			return static_cast<double>((static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1.0e7;
+		};
+
+		return to_seconds(kernel) + to_seconds(user);
+	}
+
+	std::string watts_text(double milliwatts) {
+		return liblec::leccore::round_off::to_string(milliwatts / 1000.0, 1) + "W";
+	}
+}
+
+power_capture::power_capture() {}
+
+power_capture::~power_capture() {
+	shutdown();
+}
+
+void power_capture::configure(unsigned interval, unsigned seconds) {
+	if (running())
+		return;
+
+	_interval = std::min(std::max(interval, min_interval), max_interval);
+	_seconds = std::min(std::max(seconds, 1U), max_seconds);
+}
+
+bool power_capture::result(capture_results& results, std::string& error) {
+	if (!finish(error))
+		return false;
+
+	results = _results;
+	return true;
+}
+
+std::string power_capture::to_csv(const capture_results& results) {
+	std::string text;
+	text += "# interval " + std::to_string(results.interval) + "ms, achieved " +
+		liblec::leccore::round_off::to_string(results.achieved_interval, 2) + "ms; sampler " +
+		overhead(results) + "\n";
+	text += "time_s,charge_rate_mw,voltage_mv,package_w\n";
+
+	auto field = [](double value, int precision) {
+		return value == unknown ? std::string() : liblec::leccore::round_off::to_string(value, precision);
+	};
+
+	for (const auto& sample : results.samples)
+		text += liblec::leccore::round_off::to_string(sample.time, 3) + "," +
+		field(sample.charge_rate, 0) + "," +
+		field(sample.voltage, 0) + "," +
+		field(sample.package_power, 2) + "\n";
+
+	return text;
+}
+
+std::string power_capture::summary(const capture_results& results) {
+	if (results.samples.empty())
+		return "Not run";
+
+	double peak_package = unknown, peak_discharge = unknown;
+
+	for (const auto& sample : results.samples) {
+		if (sample.package_power != unknown)
+			peak_package = std::max(peak_package, sample.package_power * 1000.0);
+
+		if (sample.charge_rate != unknown)
+			peak_discharge = std::max(peak_discharge, -sample.charge_rate);
+	}
+
+	std::string text = std::to_string(results.samples.size()) + " samples at " +
+		std::to_string(results.interval) + "ms";
+
+	if (peak_package != unknown)
+		text += ", peak " + watts_text(peak_package) + " package";
+
+	if (peak_discharge > 0.0)
+		text += ", " + watts_text(peak_discharge) + " discharge";
+
+	return text;
+}
+
+std::string power_capture::overhead(const capture_results& results) {
+	return liblec::leccore::round_off::to_string(results.sample_cost, 0) + "us per sample, " +
+		liblec::leccore::round_off::to_string(results.sampler_cpu, 2) + "% of one CPU";
+}
+
+std::vector<double> power_capture::plot_values(const capture_results& results) {
+	bool package = false;
+	for (const auto& sample : results.samples)
+		if (sample.package_power != unknown) {
+			package = true;
+			break;
+		}
+
+	std::vector<double> values;
+	values.reserve(results.samples.size());
+
+	for (const auto& sample : results.samples) {
+		if (package) {
+			if (sample.package_power != unknown)
+				values.push_back(sample.package_power);
+		}
+		else
+			if (sample.charge_rate != unknown)
+				values.push_back(std::max(-sample.charge_rate, 0.0) / 1000.0);
+	}
+
+	return values;
+}
+
+void power_capture::reset() {
+	_results = {};
+}
+
+void power_capture::run() {
+	std::vector<battery_handle> batteries;
+	open_batteries(batteries);
+
+	// a meter of our own, the one the form refreshes is not shared across threads
+	energy_meter meter;
+	energy_meter::power_info power;
+	std::string error;
+	const bool metered = meter.read(power, error);	// primes the counters
+
+	if (batteries.empty() && !metered) {
+		_error = "There are no batteries or energy meters to sample";
+		return;
+	}
+
+	const size_t count = static_cast<size_t>(_seconds) * 1000 / _interval;
+	_results.interval = _interval;
+	_results.samples.reserve(count);
+
+	// sleep granularity is 15.6ms by default, too coarse for the shorter intervals
+	timeBeginPeriod(1);
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+
+	const double cpu_start = thread_cpu_seconds();
+	const auto start = std::chrono::steady_clock::now();
+	auto next = start;
+	double reading_seconds = 0.0;
+
+	for (size_t i = 0; i < count && !_stop; i++) {
+		next += std::chrono::milliseconds(_interval);
+		std::this_thread::sleep_until(next);
+
+		const auto before = std::chrono::steady_clock::now();
+
+		sample value;
+		value.time = std::chrono::duration<double>(before - start).count();
+
+		double rate = 0.0;
+		bool rate_known = false;
+
+		for (const auto& battery : batteries) {
+			BATTERY_WAIT_STATUS wait = {};
+			wait.BatteryTag = battery.tag;
+			BATTERY_STATUS status = {};
+			DWORD returned = 0;
+
+			if (!DeviceIoControl(battery.handle, IOCTL_BATTERY_QUERY_STATUS, &wait, sizeof(wait),
+				&status, sizeof(status), &returned, nullptr))
+				continue;
+
+			if (status.Rate != static_cast<LONG>(BATTERY_UNKNOWN_RATE)) {
+				rate += status.Rate;
+				rate_known = true;
+			}
+
+			if (value.voltage == unknown && status.Voltage != BATTERY_UNKNOWN_VOLTAGE)
+				value.voltage = static_cast<double>(status.Voltage);
+		}
+
+		if (rate_known)
+			value.charge_rate = rate;
+
+		if (metered && meter.read(power, error)) {
+			const auto package = power.find("Package");
+			if (package)
+				value.package_power = package->watts;
+		}
+
+		reading_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+		_results.samples.push_back(value);
+		_progress = 100.f * static_cast<float>(i + 1) / static_cast<float>(count);
+
+		// fell behind, e.g. a read blocked; skip ahead rather than bunch samples up
+		const auto now = std::chrono::steady_clock::now();
+		if (now > next + std::chrono::milliseconds(_interval))
+			next = now;
+	}
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const double cpu = thread_cpu_seconds() - cpu_start;
+
+	timeEndPeriod(1);
+
+	if (!_results.samples.empty()) {
+		const double samples = static_cast<double>(_results.samples.size());
+		_results.achieved_interval = 1000.0 * _results.samples.back().time / samples;
+		_results.sample_cost = 1.0e6 * reading_seconds / samples;
+	}
+
+	if (elapsed > 0.0)
+		_results.sampler_cpu = 100.0 * cpu / elapsed;
+}
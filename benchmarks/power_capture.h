@@ -0,0 +1,128 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// High frequency power capture, for catching spikes the regular refresh misses.
+/// </summary>
+/// <remarks>
+/// Samples the total battery charge rate and voltage straight from the battery driver, and the
+/// CPU package power from the hardware energy counters, at a fixed interval for a fixed time.
+/// The sample buffer is allocated for the whole capture before sampling starts. The cost of
+/// the sampler is measured alongside so it can be weighed against the readings: the time spent
+/// reading per sample and the CPU time of the sampling thread. The capture runs on a worker
+/// thread, see benchmark_runner.
+/// </remarks>
+class power_capture : public benchmark_runner {
+public:
+	/// <summary>Value of a reading that is not available.</summary>
+	static const double unknown;
+
+	struct sample {
+		/// <summary>The time since the capture started, in seconds.</summary>
+		double time = 0.0;
+
+		/// <summary>The total charge rate of the batteries, in mW. Negative when discharging.</summary>
+		double charge_rate = unknown;
+
+		/// <summary>The battery voltage, in mV.</summary>
+		double voltage = unknown;
+
+		/// <summary>The CPU package power, in watts.</summary>
+		double package_power = unknown;
+	};
+
+	struct capture_results {
+		std::vector<sample> samples;
+
+		/// <summary>The requested interval, in milliseconds.</summary>
+		unsigned interval = 0;
+
+		/// <summary>The average interval achieved, in milliseconds.</summary>
+		double achieved_interval = 0.0;
+
+		/// <summary>The time spent taking each sample, on average, in microseconds.</summary>
+		double sample_cost = 0.0;
+
+		/// <summary>The CPU time of the sampling thread, as a percentage of one logical processor.</summary>
+		double sampler_cpu = 0.0;
+	};
+
+	power_capture();
+	~power_capture();
+
+	/// <summary>
+	/// Set the interval and length of the next capture. Call before <see cref="start"/>.
+	/// </summary>
+	/// <param name="interval">The interval, in milliseconds, between 10 and 100.</param>
+	/// <param name="seconds">The length of the capture, in seconds, up to 120.</param>
+	void configure(unsigned interval, unsigned seconds);
+
+	/// <summary>
+	/// Get the capture.
+	/// </summary>
+	/// <param name="results">The capture.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool result(capture_results& results, std::string& error);
+
+	/// <summary>
+	/// Format a capture as CSV, one sample per line, with the sampler overhead in a header comment.
+	/// </summary>
+	/// <param name="results">The capture.</param>
+	static std::string to_csv(const capture_results& results);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "1500 samples at 20ms, peak 28.1W package, 31.2W discharge".
+	/// </summary>
+	/// <param name="results">The capture.</param>
+	static std::string summary(const capture_results& results);
+
+	/// <summary>
+	/// Describe the sampler overhead, e.g. "45us per sample, 0.3% of one CPU".
+	/// </summary>
+	/// <param name="results">The capture.</param>
+	static std::string overhead(const capture_results& results);
+
+	/// <summary>
+	/// Pick the series worth plotting: package power if there is any, else the battery discharge rate.
+	/// </summary>
+	/// <param name="results">The capture.</param>
+	/// <returns>The values, in watts, with unknown readings left out.</returns>
+	static std::vector<double> plot_values(const capture_results& results);
+
+private:
+	void reset() override;
+	void run() override;
+
+	unsigned _interval = 20;
+	unsigned _seconds = 30;
+	capture_results _results;
+};
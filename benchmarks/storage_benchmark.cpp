@@ -0,0 +1,459 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "storage_benchmark.h"
+#include "aligned_buffer.h"
+
+#include <Windows.h>
+#include <liblec/leccore/system.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace {
+	// large enough to get past any drive's write cache in the sequential passes
+	const unsigned long long file_size = 1024ULL * 1024 * 1024;
+
+	// unbuffered i/o needs sector aligned buffers, offsets and sizes; 4KB covers 512e and 4Kn drives
+	const size_t sector_alignment = 4096;
+
+	const size_t sequential_block = 1024 * 1024;
+	const size_t sequential_depth = 8;
+	const size_t random_block = 4096;
+	const size_t random_depth = 32;
+
+	// time limits keep slow drives from making the benchmark take minutes
+	const double sequential_seconds = 6.0;
+	const double random_seconds = 3.0;
+	const double latency_seconds = 2.0;
+
+	// the untimed prefill only stops this early on a drive too slow to benchmark anyway
+	const double prefill_seconds = 300.0;
+
+	// give up on a request the drive has not completed in this long
+	const DWORD completion_timeout_ms = 30000;
+
+	class file_handle {
+	public:
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		~file_handle() {
+			if (handle != INVALID_HANDLE_VALUE && handle != nullptr)
+				CloseHandle(handle);
+		}
+	};
+
+	struct request {
+		OVERLAPPED overlapped = {};
+		char* buffer = nullptr;
+		std::chrono::steady_clock::time_point submitted;
+	};
+
+	struct pass {
+		size_t block = 0;
+		size_t depth = 0;
+		bool write = false;
+		bool random = false;
+		unsigned long long size = 0;	// the region of the file to use
+		double seconds = 0.0;			// time limit
+		bool record_latency = false;
+		float progress_from = 0.f;
+		float progress_to = 0.f;
+	};
+
+	struct pass_result {
+		unsigned long long bytes = 0;
+		double seconds = 0.0;
+		std::vector<double> latencies;	// microseconds
+
+		double throughput() const {
+			return seconds > 0.0 ? bytes / seconds : 0.0;
+		}
+	};
+
+	// keeps p.depth requests in flight until the region has been covered once or time runs out
+	bool run_pass(HANDLE file, HANDLE port, char* buffers, const pass& p, pass_result& result,
+		std::atomic<bool>& stop, std::atomic<float>& progress, std::string& error) {
+		result = {};
+
+		const unsigned long long blocks = p.size / p.block;
+		if (blocks == 0) {
+			error = "Not enough data to benchmark";
+			return false;
+		}
+
+		std::vector<request> requests(p.depth);
+		for (size_t i = 0; i < p.depth; i++)
+			requests[i].buffer = buffers + i * p.block;
+
+		uint64_t random_state = 0x9e3779b97f4a7c15ULL;
+		unsigned long long next_block = 0;
+		unsigned long long submitted = 0;
+		size_t in_flight = 0;
+		bool failed = false;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		auto elapsed = [&]() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		};
+
+		auto more = [&]() {
+			return !failed && !stop && submitted < blocks && elapsed() < p.seconds;
+		};
+
+		auto submit = [&](request& r) {
+			unsigned long long block = next_block++;
+
+			if (p.random) {
+				// xorshift64, uniformly spread over the region
+				random_state ^= random_state << 13;
+				random_state ^= random_state >> 7;
+				random_state ^= random_state << 17;
+				block = random_state % blocks;
+			}
+
+			const unsigned long long offset = block * p.block;
+			r.overlapped = {};
+			r.overlapped.Offset = static_cast<DWORD>(offset & 0xffffffff);
+			r.overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+			r.submitted = std::chrono::steady_clock::now();
+
+			const BOOL ok = p.write ?
+				WriteFile(file, r.buffer, static_cast<DWORD>(p.block), nullptr, &r.overlapped) :
+				ReadFile(file, r.buffer, static_cast<DWORD>(p.block), nullptr, &r.overlapped);
+
+			// requests that complete immediately still post a completion packet
+			const DWORD code = ok ? ERROR_SUCCESS : GetLastError();
+
+			if (code != ERROR_SUCCESS && code != ERROR_IO_PENDING) {
+				error = std::string(p.write ? "Writing" : "Reading") + " the benchmark file failed (error " +
+					std::to_string(code) + ")";
+				failed = true;
+				return;
+			}
+
+			in_flight++;
+			submitted++;
+		};
+
+		for (auto& r : requests) {
+			if (!more())
+				break;
+
+			submit(r);
+		}
+
+		while (in_flight > 0) {
+			DWORD bytes = 0;
+			ULONG_PTR key = 0;
+			LPOVERLAPPED overlapped = nullptr;
+
+			const BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, completion_timeout_ms);
+			const DWORD code = ok ? ERROR_SUCCESS : GetLastError();
+
+			if (overlapped == nullptr) {
+				// nothing completed in time, cancel the rest and collect their completions
+				if (!failed)
+					error = "The drive stopped responding during the benchmark";
+
+				failed = true;
+				CancelIoEx(file, nullptr);
+				continue;
+			}
+
+			in_flight--;
+			auto& r = *CONTAINING_RECORD(overlapped, request, overlapped);
+
+			if (!ok && !failed) {
+				error = std::string(p.write ? "Writing" : "Reading") + " the benchmark file failed (error " +
+					std::to_string(code) + ")";
+				failed = true;
+			}
+
+			result.bytes += bytes;
+
+			if (p.record_latency)
+				result.latencies.push_back(std::chrono::duration<double, std::micro>(
+					std::chrono::steady_clock::now() - r.submitted).count());
+
+			const float fraction = std::max(static_cast<float>(submitted) / blocks,
+				static_cast<float>(elapsed() / p.seconds));
+			progress = p.progress_from + (p.progress_to - p.progress_from) * std::min(fraction, 1.f);
+
+			if (more())
+				submit(r);
+		}
+
+		result.seconds = elapsed();
+		return !failed;
+	}
+
+	// mark the whole file as written so writes need not extend the valid data length, which
+	// ntfs does synchronously; needs the manage volume privilege, held by administrators
+	bool set_valid_data(HANDLE file, unsigned long long size) {
+		HANDLE token = nullptr;
+		if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES, &token))
+			return false;
+
+		TOKEN_PRIVILEGES privileges = {};
+		privileges.PrivilegeCount = 1;
+		privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+		const bool enabled = LookupPrivilegeValueA(nullptr, SE_MANAGE_VOLUME_NAME, &privileges.Privileges[0].Luid) &&
+			AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+			GetLastError() != ERROR_NOT_ALL_ASSIGNED;
+		CloseHandle(token);
+
+		return enabled && SetFileValidData(file, static_cast<LONGLONG>(size));
+	}
+
+	storage_benchmark::latency_percentiles percentiles(std::vector<double> latencies) {
+		storage_benchmark::latency_percentiles result;
+
+		if (latencies.empty())
+			return result;
+
+		std::sort(latencies.begin(), latencies.end());
+
+		auto at = [&](double fraction) {
+			const size_t index = static_cast<size_t>(fraction * latencies.size());
+			return latencies[std::min(index, latencies.size() - 1)];
+		};
+
+		result.p50 = at(0.5);
+		result.p99 = at(0.99);
+		result.p999 = at(0.999);
+		return result;
+	}
+}
+
+storage_benchmark::storage_benchmark() {}
+
+storage_benchmark::~storage_benchmark() {
+	shutdown();
+}
+
+void storage_benchmark::directory(const std::string& directory) {
+	if (!running())
+		_directory = directory;
+}
+
+bool storage_benchmark::result(benchmark_results& results, std::string& error) {
+	if (!finish(error))
+		return false;
+
+	results = _results;
+	return true;
+}
+
+std::string storage_benchmark::choose_directory(const std::vector<std::string>& volumes) {
+	if (volumes.empty())
+		return std::string();
+
+	char temp_path[MAX_PATH + 1] = {};
+	char temp_volume[MAX_PATH + 1] = {};
+
+	if (GetTempPathA(MAX_PATH, temp_path) &&
+		GetVolumePathNameA(temp_path, temp_volume, MAX_PATH)) {
+		for (const auto& volume : volumes) {
+			if (_stricmp(volume.c_str(), temp_volume) == 0)
+				return temp_path;
+		}
+	}
+
+	return volumes.front();
+}
+
+std::string storage_benchmark::summary(const benchmark_results& results) {
+	if (results.sequential_read <= 0.0)
+		return "Not run";
+
+	return liblec::leccore::format_size(static_cast<unsigned long long>(results.sequential_read)) + "/s read, " +
+		liblec::leccore::format_size(static_cast<unsigned long long>(results.sequential_write)) + "/s write, 4K " +
+		liblec::leccore::format_size(static_cast<unsigned long long>(results.random_read)) + " / " +
+		liblec::leccore::format_size(static_cast<unsigned long long>(results.random_write)) + "/s";
+}
+
+std::string storage_benchmark::to_string(const latency_percentiles& latency) {
+	return "p50 " + liblec::leccore::round_off::to_string(latency.p50, 0) + "us, p99 " +
+		liblec::leccore::round_off::to_string(latency.p99, 0) + "us, p99.9 " +
+		liblec::leccore::round_off::to_string(latency.p999, 0) + "us";
+}
+
+void storage_benchmark::reset() {
+	_results = {};
+}
+
+void storage_benchmark::run() {
+	if (_directory.empty()) {
+		_error = "No directory to run the benchmark in";
+		return;
+	}
+
+	std::string directory = _directory;
+	if (directory.back() != '\\')
+		directory += '\\';
+
+	_results.path = directory + "pc_info_benchmark.tmp";
+
+	ULARGE_INTEGER free_bytes = {};
+	if (GetDiskFreeSpaceExA(directory.c_str(), &free_bytes, nullptr, nullptr) &&
+		free_bytes.QuadPart < 2 * file_size) {
+		_error = "Not enough free space on the drive, " +
+			liblec::leccore::format_size(2 * file_size) + " needed";
+		return;
+	}
+
+	// unbuffered and write-through so the cache is bypassed, deleted however the handle is closed
+	file_handle file;
+	file.handle = CreateFileA(_results.path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH |
+		FILE_FLAG_OVERLAPPED | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+
+	if (file.handle == INVALID_HANDLE_VALUE) {
+		_error = "Creating the benchmark file failed (error " + std::to_string(GetLastError()) + ")";
+		return;
+	}
+
+	// allocate the whole file up front so the writes do not extend it
+	LARGE_INTEGER size = {};
+	size.QuadPart = static_cast<LONGLONG>(file_size);
+
+	if (!SetFilePointerEx(file.handle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(file.handle)) {
+		_error = "Allocating the benchmark file failed (error " + std::to_string(GetLastError()) + ")";
+		return;
+	}
+
+	file_handle port;
+	port.handle = CreateIoCompletionPort(file.handle, nullptr, 0, 1);
+
+	if (port.handle == nullptr) {
+		_error = "Creating the I/O completion port failed (error " + std::to_string(GetLastError()) + ")";
+		return;
+	}
+
+	aligned_buffer buffer(std::max(sequential_block * sequential_depth, random_block * random_depth), sector_alignment);
+
+	if (!buffer.valid()) {
+		_error = "Insufficient memory for the storage benchmark";
+		return;
+	}
+
+	// incompressible data so drives that compress or deduplicate do not look faster than they are
+	uint64_t state = 0x2545f4914f6cdd1dULL;
+	auto words = buffer.get<uint64_t>();
+	for (size_t i = 0; i < sequential_block * sequential_depth / sizeof(uint64_t); i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		words[i] = state;
+	}
+
+	pass_result result;
+
+	pass p;
+	p.block = sequential_block;
+	p.depth = sequential_depth;
+	p.write = true;
+	p.size = file_size;
+
+	// writes past the valid data length are run one at a time however many are in flight, so
+	// without the privilege the file is filled once, untimed, before anything is measured
+	if (!set_valid_data(file.handle, file_size)) {
+		p.seconds = prefill_seconds;
+		p.progress_from = 0.f;
+		p.progress_to = 15.f;
+
+		if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+			return;
+	}
+
+	// sequential write first, it also fills the file for the passes that follow
+	p.seconds = sequential_seconds;
+	p.progress_from = 15.f;
+	p.progress_to = 30.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.sequential_write = result.throughput();
+
+	// only the part that was written holds real data, reading the rest would not touch the drive
+	_results.file_size = (result.bytes / sequential_block) * sequential_block;
+
+	p.write = false;
+	p.size = _results.file_size;
+	p.progress_from = 30.f;
+	p.progress_to = 55.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.sequential_read = result.throughput();
+
+	// random 4KB reads and writes with a deep queue
+	p.block = random_block;
+	p.depth = random_depth;
+	p.random = true;
+	p.seconds = random_seconds;
+	p.progress_from = 55.f;
+	p.progress_to = 70.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.random_read = result.throughput();
+
+	p.write = true;
+	p.progress_from = 70.f;
+	p.progress_to = 80.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.random_write = result.throughput();
+
+	// latency with one request at a time, so queueing does not add to it
+	p.depth = 1;
+	p.write = false;
+	p.seconds = latency_seconds;
+	p.record_latency = true;
+	p.progress_from = 80.f;
+	p.progress_to = 90.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.read_latency = percentiles(result.latencies);
+
+	p.write = true;
+	p.progress_from = 90.f;
+	p.progress_to = 100.f;
+
+	if (!run_pass(file.handle, port.handle, buffer.get<char>(), p, result, _stop, _progress, _error))
+		return;
+
+	_results.write_latency = percentiles(result.latencies);
+}
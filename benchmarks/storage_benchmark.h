@@ -0,0 +1,129 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Storage throughput and latency benchmark.
+/// </summary>
+/// <remarks>
+/// Runs against a temporary file in a directory on the drive being measured. The file is
+/// opened for unbuffered, write-through, overlapped I/O so that the file system cache is
+/// bypassed, and requests are kept in flight through an I/O completion port. The whole file is
+/// made valid before the timed passes, with SetFileValidData when the manage volume privilege
+/// is available and by an untimed fill otherwise, since NTFS serializes writes that extend the
+/// valid data. The file is deleted when the benchmark ends, even if the application exits early.
+/// The benchmark runs on a worker thread, see benchmark_runner.
+/// </remarks>
+class storage_benchmark : public benchmark_runner {
+public:
+	struct latency_percentiles {
+		/// <summary>The median latency, in microseconds.</summary>
+		double p50 = 0.0;
+
+		/// <summary>The 99th percentile latency, in microseconds.</summary>
+		double p99 = 0.0;
+
+		/// <summary>The 99.9th percentile latency, in microseconds.</summary>
+		double p999 = 0.0;
+	};
+
+	struct benchmark_results {
+		/// <summary>Sequential read throughput (1MB blocks, 8 in flight), in bytes per second.</summary>
+		double sequential_read = 0.0;
+
+		/// <summary>Sequential write throughput (1MB blocks, 8 in flight), in bytes per second.</summary>
+		double sequential_write = 0.0;
+
+		/// <summary>Random read throughput (4KB blocks, 32 in flight), in bytes per second.</summary>
+		double random_read = 0.0;
+
+		/// <summary>Random write throughput (4KB blocks, 32 in flight), in bytes per second.</summary>
+		double random_write = 0.0;
+
+		/// <summary>Random 4KB read latency with one request in flight.</summary>
+		latency_percentiles read_latency;
+
+		/// <summary>Random 4KB write latency with one request in flight.</summary>
+		latency_percentiles write_latency;
+
+		/// <summary>The temporary file the benchmark ran against.</summary>
+		std::string path;
+
+		/// <summary>The number of bytes of the file that were written and then measured.</summary>
+		unsigned long long file_size = 0;
+	};
+
+	storage_benchmark();
+	~storage_benchmark();
+
+	/// <summary>
+	/// Set the directory to run the next benchmark in. Call before <see cref="start"/>.
+	/// </summary>
+	/// <param name="directory">The directory, on the drive to be measured.</param>
+	void directory(const std::string& directory);
+
+	/// <summary>
+	/// Get the benchmark results.
+	/// </summary>
+	/// <param name="results">The results.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool result(benchmark_results& results, std::string& error);
+
+	/// <summary>
+	/// Choose the directory to benchmark a disk in.
+	/// </summary>
+	/// <param name="volumes">The root paths of the disk's volumes, e.g. "C:\".</param>
+	/// <returns>
+	/// The user's temporary folder if it is on one of the volumes, since writing to the root of
+	/// the system volume needs administrator rights, else the root of the first volume. Returns
+	/// an empty string if the disk has no volumes.
+	/// </returns>
+	static std::string choose_directory(const std::vector<std::string>& volumes);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "3.2GB/s read, 2.8GB/s write, 4K 410 / 350 MB/s".
+	/// </summary>
+	/// <param name="results">The benchmark results.</param>
+	static std::string summary(const benchmark_results& results);
+
+	/// <summary>
+	/// Format latency percentiles, e.g. "p50 85us, p99 140us, p99.9 900us".
+	/// </summary>
+	/// <param name="latency">The latency percentiles.</param>
+	static std::string to_string(const latency_percentiles& latency);
+
+private:
+	void reset() override;
+	void run() override;
+
+	std::string _directory;
+	benchmark_results _results;
+};
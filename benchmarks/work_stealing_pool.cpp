@@ -0,0 +1,100 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "work_stealing_pool.h"
+#include "parallel.h"
+
+#include <mutex>
+
+namespace {
+	// the share of tasks a worker has yet to run, on its own cache line to avoid false sharing
+	struct alignas(64) task_range {
+		std::mutex lock;
+		size_t begin = 0;
+		size_t end = 0;
+	};
+
+	bool pop(task_range& range, size_t& task) {
+		std::lock_guard<std::mutex> lock(range.lock);
+
+		if (range.begin == range.end)
+			return false;
+
+		task = range.begin++;
+		return true;
+	}
+
+	bool steal(std::vector<task_range>& ranges, size_t thief, size_t& task) {
+		const size_t workers = ranges.size();
+
+		for (size_t offset = 1; offset < workers; offset++) {
+			auto& victim = ranges[(thief + offset) % workers];
+			size_t begin = 0, end = 0;
+
+			{
+				std::lock_guard<std::mutex> lock(victim.lock);
+
+				const size_t remaining = victim.end - victim.begin;
+				if (remaining == 0)
+					continue;
+
+				// take the back half, rounding up so the last task can be stolen too
+				end = victim.end;
+				begin = end - (remaining + 1) / 2;
+				victim.end = begin;
+			}
+
+			// the thief's own range is empty so nobody else can be touching it
+			std::lock_guard<std::mutex> lock(ranges[thief].lock);
+			task = begin;
+			ranges[thief].begin = begin + 1;
+			ranges[thief].end = end;
+			return true;
+		}
+
+		return false;
+	}
+}
+
+double work_stealing_pool::run(const std::vector<unsigned long>& processors, size_t task_count,
+	const std::function<void(size_t)>& task) {
+	const size_t workers = processors.size();
+
+	if (workers == 0 || task_count == 0)
+		return 0.0;
+
+	std::vector<task_range> ranges(workers);
+
+	for (size_t i = 0; i < workers; i++) {
+		ranges[i].begin = task_count * i / workers;
+		ranges[i].end = task_count * (i + 1) / workers;
+	}
+
+	return parallel::run(processors, [&](unsigned long index) {
+		size_t next = 0;
+
+		while (pop(ranges[index], next) || steal(ranges, index, next))
+			task(next);
+		});
+}
@@ -0,0 +1,50 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// Work stealing task pool for benchmark work that may not divide evenly across processors.
+/// </summary>
+/// <remarks>
+/// Tasks are identified by index. Each worker starts with a contiguous share of the indices and
+/// takes them from the front of its share; a worker that runs out steals the back half of
+/// another worker's remaining share, so a slow or busy processor does not hold up the others.
+/// </remarks>
+class work_stealing_pool {
+public:
+	/// <summary>
+	/// Run a number of tasks on one worker thread per listed logical processor.
+	/// </summary>
+	/// <param name="processors">The logical processors to run on, see parallel.</param>
+	/// <param name="task_count">The number of tasks.</param>
+	/// <param name="task">The task function, called with the task's index.</param>
+	/// <returns>The time, in seconds, from release until the last task finishes.</returns>
+	/// <remarks>May throw std::system_error if threads cannot be created.</remarks>
+	static double run(const std::vector<unsigned long>& processors, size_t task_count,
+		const std::function<void(size_t)>& task);
+};
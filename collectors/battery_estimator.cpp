@@ -0,0 +1,157 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "battery_estimator.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+	// time constant of the smoothing, in seconds
+	const double smoothing_time = 90.0;
+
+	// samples needed after a reset before estimating
+	const int minimum_samples = 5;
+
+	// rates below this, in mW, are treated as idle
+	const double idle_rate = 50.0;
+
+	// capacity changes further apart than this, in seconds, are stale
+	const long long anchor_timeout = 10 * 60;
+}
+
+void battery_estimator::add(long long time, double capacity, double full_capacity, double charge_rate) {
+	if (capacity < 0.0)
+		return;
+
+	const double elapsed = _samples > 0 ? static_cast<double>(time - _time) : 0.0;
+
+	if (_samples > 0 && elapsed <= 0.0)
+		return;
+
+	// the rate implied by the change in capacity since it last changed; capacity is reported
+	// in coarse steps so it is only used when it moves
+	double derived_rate = 0.0;
+	bool derived = false;
+
+	if (_anchor_capacity < 0.0 || time - _anchor_time > anchor_timeout) {
+		_anchor_time = time;
+		_anchor_capacity = capacity;
+	}
+	else
+		if (capacity != _anchor_capacity) {
+			derived_rate = (capacity - _anchor_capacity) * 3600.0 / static_cast<double>(time - _anchor_time);
+			derived = true;
+			_anchor_time = time;
+			_anchor_capacity = capacity;
+		}
+
+	double rate = charge_rate;
+
+	if (derived)
+		rate = std::fabs(charge_rate) >= idle_rate ? (charge_rate + derived_rate) / 2.0 : derived_rate;
+
+	// start afresh when switching between charging and discharging
+	if (_samples > 0 && std::fabs(rate) >= idle_rate && std::fabs(_rate) >= idle_rate &&
+		(rate > 0.0) != (_rate > 0.0))
+		_samples = 0;
+
+	if (_samples == 0) {
+		_rate = rate;
+		_variance = 0.0;
+	}
+	else {
+		// weight by the time between samples so irregular refreshes smooth alike
+		const double alpha = 1.0 - std::exp(-elapsed / smoothing_time);
+		const double difference = rate - _rate;
+		_alpha = alpha;
+		_rate += alpha * difference;
+		_variance = (1.0 - alpha) * (_variance + alpha * difference * difference);
+	}
+
+	_samples++;
+	_time = time;
+	_capacity = capacity;
+	_full_capacity = full_capacity;
+}
+
+void battery_estimator::reset() {
+	*this = battery_estimator();
+}
+
+battery_estimator::estimate battery_estimator::get() const {
+	estimate value;
+
+	if (_samples < minimum_samples || std::fabs(_rate) < idle_rate)
+		return value;
+
+	value.charging = _rate > 0.0;
+
+	double energy = 0.0;
+
+	if (value.charging) {
+		if (_full_capacity <= 0.0 || _capacity >= _full_capacity)
+			return value;
+
+		energy = _full_capacity - _capacity;
+	}
+	else
+		energy = _capacity;
+
+	// two standard errors of the smoothed rate either side, never letting the rate cross zero
+	const double rate = std::fabs(_rate);
+	const double spread = 2.0 * std::sqrt(_variance * _alpha / (2.0 - _alpha));
+	const double fast_rate = rate + spread;
+	const double slow_rate = std::max(rate - spread, idle_rate);
+
+	value.seconds = energy * 3600.0 / rate;
+	value.low_seconds = energy * 3600.0 / fast_rate;
+	value.high_seconds = energy * 3600.0 / slow_rate;
+	value.valid = true;
+	return value;
+}
+
+std::string battery_estimator::to_string(const estimate& value) {
+	if (!value.valid)
+		return std::string();
+
+	std::string text = duration(value.seconds) + (value.charging ? " to full" : " to empty");
+
+	const std::string low = duration(value.low_seconds);
+	const std::string high = duration(value.high_seconds);
+
+	if (low != high)
+		text += " (" + low + " - " + high + ")";
+
+	return text;
+}
+
+std::string battery_estimator::duration(double seconds) {
+	// cap at 99 hours, anything longer is not meaningful
+	const long long minutes = static_cast<long long>(std::min(seconds, 99.0 * 3600.0) / 60.0 + 0.5);
+
+	if (minutes < 60)
+		return std::to_string(minutes) + "m";
+
+	return std::to_string(minutes / 60) + "h " + std::to_string(minutes % 60) + "m";
+}
@@ -0,0 +1,104 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// Smoothed time-to-empty and time-to-full estimator.
+/// </summary>
+/// <remarks>
+/// The rate reported by the battery is fused with the rate implied by the change in remaining
+/// capacity, and the result is smoothed with an exponentially weighted moving average whose
+/// weight depends on the time between samples. The smoothed variance gives the confidence
+/// range. The smoothing starts afresh whenever the battery switches between charging and
+/// discharging.
+/// </remarks>
+class battery_estimator {
+public:
+	struct estimate {
+		/// <summary>Whether there is enough data for an estimate.</summary>
+		bool valid = false;
+
+		/// <summary>Whether the time is to full rather than to empty.</summary>
+		bool charging = false;
+
+		/// <summary>The estimated time, in seconds.</summary>
+		double seconds = 0.0;
+
+		/// <summary>The shortest time within the confidence range, in seconds.</summary>
+		double low_seconds = 0.0;
+
+		/// <summary>The longest time within the confidence range, in seconds.</summary>
+		double high_seconds = 0.0;
+	};
+
+	/// <summary>
+	/// Add a sample.
+	/// </summary>
+	/// <param name="time">The time of the sample, in seconds.</param>
+	/// <param name="capacity">The remaining capacity, in mWh, or -1 if unknown.</param>
+	/// <param name="full_capacity">The fully charged capacity, in mWh, or -1 if unknown.</param>
+	/// <param name="charge_rate">The charge rate, in mW, negative when discharging.</param>
+	void add(long long time, double capacity, double full_capacity, double charge_rate);
+
+	/// <summary>
+	/// Start afresh, e.g. when batteries are added or removed.
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	/// Get the current estimate.
+	/// </summary>
+	estimate get() const;
+
+	/// <summary>
+	/// Make a readable string, e.g. "2h 15m to empty (1h 50m - 2h 40m)".
+	/// </summary>
+	/// <param name="value">The estimate.</param>
+	/// <returns>The string, or an empty string if the estimate is not valid.</returns>
+	static std::string to_string(const estimate& value);
+
+	/// <summary>
+	/// Make a short readable duration, e.g. "2h 15m".
+	/// </summary>
+	/// <param name="seconds">The duration, in seconds.</param>
+	static std::string duration(double seconds);
+
+private:
+	// smoothed rate, in mW, its variance and the last smoothing weight
+	double _rate = 0.0;
+	double _variance = 0.0;
+	double _alpha = 1.0;
+	int _samples = 0;
+
+	long long _time = 0;
+	double _capacity = -1.0;
+	double _full_capacity = -1.0;
+
+	// the last change in capacity, to derive the rate from
+	long long _anchor_time = 0;
+	double _anchor_capacity = -1.0;
+};
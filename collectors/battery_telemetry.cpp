@@ -0,0 +1,115 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "battery_telemetry.h"
+
+// 3 second samples: 6 minutes, 1 hour, 10 hours and 100 hours
+const size_t battery_telemetry::ring_size = 120;
+const size_t battery_telemetry::downsample_factor = 10;
+const size_t battery_telemetry::ring_count = 4;
+
+battery_telemetry::battery_telemetry() :
+	_rings(ring_count) {
+	for (auto& ring : _rings)
+		ring.samples.resize(ring_size);
+}
+
+void battery_telemetry::add(const sample& value) {
+	push(0, value);
+}
+
+void battery_telemetry::push(size_t ring_number, const sample& value) {
+	auto& ring = _rings[ring_number];
+
+	ring.samples[ring.next] = value;
+	ring.next = (ring.next + 1) % ring_size;
+
+	if (ring.count < ring_size)
+		ring.count++;
+
+	if (ring_number + 1 == ring_count)
+		return;
+
+	// average every few samples into the next ring, timed at the last of them
+	ring.pending.time = value.time;
+	ring.pending.level += value.level;
+	ring.pending.charge_rate += value.charge_rate;
+	ring.pending.voltage += value.voltage;
+	ring.pending.capacity += value.capacity;
+
+	if (++ring.pending_count < downsample_factor)
+		return;
+
+	sample average = ring.pending;
+	average.level /= downsample_factor;
+	average.charge_rate /= downsample_factor;
+	average.voltage /= downsample_factor;
+	average.capacity /= downsample_factor;
+
+	ring.pending = {};
+	ring.pending_count = 0;
+
+	push(ring_number + 1, average);
+}
+
+std::vector<battery_telemetry::sample> battery_telemetry::series() const {
+	std::vector<sample> series;
+	long long covered_from = 0;	// the oldest time already covered by a finer ring
+
+	// finest ring first, then the older parts of the coarser ones in front of it
+	for (const auto& ring : _rings) {
+		std::vector<sample> older;
+
+		for (size_t i = 0; i < ring.count; i++) {
+			const auto& value = ring.samples[(ring.next + ring_size - ring.count + i) % ring_size];
+
+			if (series.empty() || value.time < covered_from)
+				older.push_back(value);
+		}
+
+		if (!older.empty()) {
+			covered_from = older.front().time;
+			series.insert(series.begin(), older.begin(), older.end());
+		}
+	}
+
+	return series;
+}
+
+std::vector<double> battery_telemetry::values(const std::vector<sample>& series, field which) {
+	std::vector<double> values;
+	values.reserve(series.size());
+
+	for (const auto& value : series) {
+		switch (which) {
+		case field::level: values.push_back(value.level); break;
+		case field::charge_rate: values.push_back(value.charge_rate); break;
+		case field::voltage: values.push_back(value.voltage); break;
+		case field::capacity:
+		default: values.push_back(value.capacity); break;
+		}
+	}
+
+	return values;
+}
@@ -0,0 +1,110 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// Bounded time series of a battery's telemetry.
+/// </summary>
+/// <remarks>
+/// Samples go into a fixed-size ring. Every few samples leaving a ring are averaged into one
+/// sample of the next, coarser ring, so recent data is kept at full resolution and older data
+/// at progressively lower resolution. Memory is fixed at construction, whatever the uptime.
+/// With the default refresh interval the rings cover about 6 minutes, 1 hour, 10 hours and
+/// 100 hours.
+/// </remarks>
+class battery_telemetry {
+public:
+	struct sample {
+		/// <summary>The time of the sample, in seconds since the epoch.</summary>
+		long long time = 0;
+
+		/// <summary>The charge level, as a percentage.</summary>
+		double level = 0.0;
+
+		/// <summary>The charge rate, in mW. Negative when discharging.</summary>
+		double charge_rate = 0.0;
+
+		/// <summary>The voltage, in mV.</summary>
+		double voltage = 0.0;
+
+		/// <summary>The remaining capacity, in mWh.</summary>
+		double capacity = 0.0;
+	};
+
+	enum class field {
+		level,
+		charge_rate,
+		voltage,
+		capacity,
+	};
+
+	/// <summary>The number of samples in each ring.</summary>
+	static const size_t ring_size;
+
+	/// <summary>The number of samples averaged into one sample of the next ring.</summary>
+	static const size_t downsample_factor;
+
+	/// <summary>The number of rings.</summary>
+	static const size_t ring_count;
+
+	battery_telemetry();
+
+	/// <summary>
+	/// Add a sample.
+	/// </summary>
+	/// <param name="value">The sample.</param>
+	void add(const sample& value);
+
+	/// <summary>
+	/// Get the whole history, oldest first; the older part at lower resolution.
+	/// </summary>
+	std::vector<sample> series() const;
+
+	/// <summary>
+	/// Pick one field out of a series.
+	/// </summary>
+	/// <param name="series">The series.</param>
+	/// <param name="which">The field.</param>
+	/// <returns>The values, in the same order.</returns>
+	static std::vector<double> values(const std::vector<sample>& series, field which);
+
+private:
+	struct ring {
+		std::vector<sample> samples;
+		size_t next = 0;
+		size_t count = 0;
+
+		// running sum of the samples not yet passed on to the next ring
+		sample pending;
+		size_t pending_count = 0;
+	};
+
+	std::vector<ring> _rings;
+
+	void push(size_t ring_number, const sample& value);
+};
@@ -0,0 +1,180 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "battery_wear.h"
+
+#include <liblec/leccore/system.h>
+
+#include <cmath>
+#include <sstream>
+
+const double battery_wear::replacement_threshold = 80.0;
+
+namespace {
+	// the daily series covers three years, about the life of a laptop battery
+	const size_t max_samples = 3 * 365;
+	const long long seconds_per_day = 86400;
+	const double seconds_per_year = 365.25 * seconds_per_day;
+
+	// history needed before projecting
+	const long long minimum_span = 14 * seconds_per_day;
+	const size_t minimum_samples = 7;
+
+	// projections further out than this are not meaningful
+	const double maximum_years = 20.0;
+
+	double health(const battery_wear::wear_sample& sample) {
+		return 100.0 * static_cast<double>(sample.fully_charged_capacity) /
+			static_cast<double>(sample.designed_capacity);
+	}
+}
+
+void battery_wear::append(std::vector<wear_sample>& series, long long designed_capacity,
+	long long fully_charged_capacity, long long time) {
+	if (designed_capacity <= 0 || fully_charged_capacity <= 0)
+		return;
+
+	wear_sample sample;
+	sample.time = time;
+	sample.designed_capacity = designed_capacity;
+	sample.fully_charged_capacity = fully_charged_capacity;
+
+	if (!series.empty() && series.back().time / seconds_per_day == time / seconds_per_day)
+		series.back() = sample;
+	else
+		series.push_back(sample);
+
+	if (series.size() > max_samples)
+		series.erase(series.begin(), series.begin() + (series.size() - max_samples));
+}
+
+std::string battery_wear::serialize(const std::vector<wear_sample>& series) {
+	std::string text;
+
+	for (const auto& sample : series) {
+		if (!text.empty())
+			text += ";";
+
+		text += std::to_string(sample.time) + "," +
+			std::to_string(sample.designed_capacity) + "," +
+			std::to_string(sample.fully_charged_capacity);
+	}
+
+	return text;
+}
+
+std::vector<battery_wear::wear_sample> battery_wear::deserialize(const std::string& text) {
+	std::vector<wear_sample> series;
+	std::stringstream samples(text);
+	std::string item;
+
+	while (std::getline(samples, item, ';')) {
+		std::stringstream fields(item);
+		wear_sample sample;
+		char comma = 0;
+
+		if (fields >> sample.time >> comma >> sample.designed_capacity >> comma >> sample.fully_charged_capacity &&
+			sample.designed_capacity > 0 && sample.fully_charged_capacity > 0)
+			series.push_back(sample);
+	}
+
+	return series;
+}
+
+battery_wear::projection battery_wear::project(const std::vector<wear_sample>& series, long long time) {
+	projection value;
+
+	if (series.size() < minimum_samples || series.back().time - series.front().time < minimum_span)
+		return value;
+
+	// least squares fit of health against time, in years from the first sample
+	const long long origin = series.front().time;
+	double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+
+	for (const auto& sample : series) {
+		const double x = static_cast<double>(sample.time - origin) / seconds_per_year;
+		const double y = health(sample);
+		sum_x += x;
+		sum_y += y;
+		sum_xx += x * x;
+		sum_xy += x * y;
+	}
+
+	const double n = static_cast<double>(series.size());
+	const double denominator = n * sum_xx - sum_x * sum_x;
+
+	if (denominator <= 0.0)
+		return value;
+
+	const double slope = (n * sum_xy - sum_x * sum_y) / denominator;
+	const double intercept = (sum_y - slope * sum_x) / n;
+	const double now = static_cast<double>(time - origin) / seconds_per_year;
+
+	value.valid = true;
+	value.change_per_year = slope;
+	value.health = intercept + slope * now;
+
+	if (value.health <= replacement_threshold)
+		value.replacement_time = time;
+	else
+		if (slope < 0.0) {
+			const double years = (replacement_threshold - value.health) / slope;
+
+			if (years <= maximum_years)
+				value.replacement_time = time + static_cast<long long>(years * seconds_per_year);
+		}
+
+	return value;
+}
+
+std::string battery_wear::to_string(const projection& value, long long time) {
+	if (!value.valid)
+		return "No projection yet, needs two weeks of history";
+
+	const std::string rate = (value.change_per_year > 0.0 ? "+" : "") +
+		liblec::leccore::round_off::to_string(value.change_per_year, 1) + "% a year";
+
+	const std::string threshold = liblec::leccore::round_off::to_string(replacement_threshold, 0) + "%";
+
+	if (value.replacement_time == 0)
+		return "Not wearing, " + rate;
+
+	if (value.replacement_time <= time)
+		return "Below " + threshold + ", due for replacement";
+
+	const long long days = (value.replacement_time - time) / seconds_per_day;
+	const long long months = static_cast<long long>(days / 30.44 + 0.5);
+
+	std::string when;
+
+	if (days < 60)
+		when = std::to_string(days) + (days == 1 ? " day" : " days");
+	else
+		if (months < 24)
+			when = std::to_string(months) + " months";
+		else
+			when = liblec::leccore::round_off::to_string(months / 12.0, 1) + " years";
+
+	return threshold + " in about " + when + ", " + rate;
+}
@@ -0,0 +1,108 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Battery wear history and replacement projection.
+/// </summary>
+/// <remarks>
+/// A compact daily series of the designed and fully charged capacities is kept per battery.
+/// The fully charged capacity moves around from one calibration to the next, so the
+/// projection fits a least squares line through the whole series rather than comparing the
+/// first and last samples.
+/// </remarks>
+class battery_wear {
+public:
+	/// <summary>The health, as a percentage of the designed capacity, at which a battery is due for replacement.</summary>
+	static const double replacement_threshold;
+
+	struct wear_sample {
+		/// <summary>The time of the sample, in seconds since 1970.</summary>
+		long long time = 0;
+
+		/// <summary>The designed capacity, in mWh.</summary>
+		long long designed_capacity = 0;
+
+		/// <summary>The fully charged capacity, in mWh.</summary>
+		long long fully_charged_capacity = 0;
+	};
+
+	struct projection {
+		/// <summary>Whether there is enough history for a projection.</summary>
+		bool valid = false;
+
+		/// <summary>The health according to the fitted line, as a percentage.</summary>
+		double health = 0.0;
+
+		/// <summary>The change in health per year, in percentage points. Negative when wearing.</summary>
+		double change_per_year = 0.0;
+
+		/// <summary>
+		/// When the health reaches the replacement threshold, in seconds since 1970. Zero if the
+		/// battery is not wearing; the current time if the threshold has already been reached.
+		/// </summary>
+		long long replacement_time = 0;
+	};
+
+	/// <summary>
+	/// Add a reading to a battery's daily series. A reading on the same day as the last sample
+	/// replaces it, and the oldest samples are dropped beyond three years.
+	/// </summary>
+	/// <param name="series">The series.</param>
+	/// <param name="designed_capacity">The designed capacity, in mWh.</param>
+	/// <param name="fully_charged_capacity">The fully charged capacity, in mWh.</param>
+	/// <param name="time">The time of the reading, in seconds since 1970.</param>
+	/// <remarks>Readings with an unknown or zero capacity are ignored.</remarks>
+	static void append(std::vector<wear_sample>& series, long long designed_capacity,
+		long long fully_charged_capacity, long long time);
+
+	/// <summary>
+	/// Serialize a series to a compact string for the settings, e.g. "1700000000,57000,51300;...".
+	/// </summary>
+	static std::string serialize(const std::vector<wear_sample>& series);
+
+	/// <summary>
+	/// Deserialize a series from <see cref="serialize"/>. Malformed samples are skipped.
+	/// </summary>
+	static std::vector<wear_sample> deserialize(const std::string& text);
+
+	/// <summary>
+	/// Project when the battery reaches the <see cref="replacement_threshold"/>.
+	/// </summary>
+	/// <param name="series">The series.</param>
+	/// <param name="time">The current time, in seconds since 1970.</param>
+	/// <remarks>At least two weeks of history are needed.</remarks>
+	static projection project(const std::vector<wear_sample>& series, long long time);
+
+	/// <summary>
+	/// Describe a projection, e.g. "80% in about 14 months, -4.2% a year".
+	/// </summary>
+	/// <param name="value">The projection.</param>
+	/// <param name="time">The current time, in seconds since 1970.</param>
+	static std::string to_string(const projection& value, long long time);
+};
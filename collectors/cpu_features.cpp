@@ -0,0 +1,271 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "cpu_features.h"
+
+#include <intrin.h>
+#include <immintrin.h>
+#include <cstdio>
+
+static_assert(static_cast<size_t>(cpu_features::feature::count) <= 64,
+	"feature set no longer fits the 64 bit serialized form");
+
+namespace {
+	inline bool bit(unsigned int value, int n) {
+		return (value >> n) & 1;
+	}
+
+	const char* feature_names[] = {
+		"SSE", "SSE2", "SSE3", "SSSE3", "SSE4.1", "SSE4.2",
+		"POPCNT", "LZCNT", "MOVBE", "CX16", "LAHF/SAHF",
+		"AES", "PCLMULQDQ", "SHA", "RDRAND", "RDSEED", "ADX",
+		"BMI1", "BMI2", "XSAVE", "OSXSAVE",
+		"AVX", "F16C", "FMA", "AVX2", "AVX-VNNI",
+		"AVX-512F", "AVX-512DQ", "AVX-512CD", "AVX-512BW", "AVX-512VL",
+		"AVX-512IFMA", "AVX-512VBMI", "AVX-512VBMI2", "AVX-512VNNI",
+		"AVX-512BITALG", "AVX-512VPOPCNTDQ", "AVX-512BF16", "AVX-512FP16",
+		"GFNI", "VAES", "VPCLMULQDQ"
+	};
+
+	static_assert(sizeof(feature_names) / sizeof(feature_names[0]) == static_cast<size_t>(cpu_features::feature::count),
+		"feature names out of step with the feature enumeration");
+}
+
+cpu_features::cpu_features() {}
+cpu_features::~cpu_features() {}
+
+bool cpu_features::read(features_info& info, std::string& error) {
+	info = {};
+
+	cpuid_registers registers;
+	if (!read_registers(registers, error))
+		return false;
+
+	info.features = decode(registers);
+	info.level = level(info.features);
+	return true;
+}
+
+bool cpu_features::read_registers(cpuid_registers& registers, std::string& error) {
+	registers = {};
+	int regs[4] = { 0 };
+
+	__cpuid(regs, 0);
+	registers.max_leaf = static_cast<unsigned int>(regs[0]);
+
+	if (registers.max_leaf < 1) {
+		error = "CPUID feature information is not available";
+		return false;
+	}
+
+	__cpuid(regs, 1);
+	registers.leaf_1_ecx = static_cast<unsigned int>(regs[2]);
+	registers.leaf_1_edx = static_cast<unsigned int>(regs[3]);
+
+	if (registers.max_leaf >= 7) {
+		__cpuidex(regs, 7, 0);
+		const unsigned int max_subleaf = static_cast<unsigned int>(regs[0]);
+		registers.leaf_7_ebx = static_cast<unsigned int>(regs[1]);
+		registers.leaf_7_ecx = static_cast<unsigned int>(regs[2]);
+		registers.leaf_7_edx = static_cast<unsigned int>(regs[3]);
+
+		if (max_subleaf >= 1) {
+			__cpuidex(regs, 7, 1);
+			registers.leaf_7_1_eax = static_cast<unsigned int>(regs[0]);
+		}
+	}
+
+	__cpuid(regs, 0x80000000);
+	registers.max_extended_leaf = static_cast<unsigned int>(regs[0]);
+
+	if (registers.max_extended_leaf >= 0x80000001) {
+		__cpuid(regs, 0x80000001);
+		registers.extended_1_ecx = static_cast<unsigned int>(regs[2]);
+		registers.extended_1_edx = static_cast<unsigned int>(regs[3]);
+	}
+
+	// xgetbv faults unless the os has enabled it
+	if (bit(registers.leaf_1_ecx, 27))
+		registers.xcr0 = _xgetbv(0);
+
+	return true;
+}
+
+cpu_features::feature_set cpu_features::decode(const cpuid_registers& r) {
+	feature_set features;
+	auto set = [&](feature f, bool value) { features.set(static_cast<size_t>(f), value); };
+
+	// leaf 1
+	set(feature::sse, bit(r.leaf_1_edx, 25));
+	set(feature::sse2, bit(r.leaf_1_edx, 26));
+	set(feature::sse3, bit(r.leaf_1_ecx, 0));
+	set(feature::pclmulqdq, bit(r.leaf_1_ecx, 1));
+	set(feature::ssse3, bit(r.leaf_1_ecx, 9));
+	set(feature::cx16, bit(r.leaf_1_ecx, 13));
+	set(feature::sse4_1, bit(r.leaf_1_ecx, 19));
+	set(feature::sse4_2, bit(r.leaf_1_ecx, 20));
+	set(feature::movbe, bit(r.leaf_1_ecx, 22));
+	set(feature::popcnt, bit(r.leaf_1_ecx, 23));
+	set(feature::aes, bit(r.leaf_1_ecx, 25));
+	set(feature::xsave, bit(r.leaf_1_ecx, 26));
+	set(feature::osxsave, bit(r.leaf_1_ecx, 27));
+	set(feature::rdrand, bit(r.leaf_1_ecx, 30));
+
+	// extended leaf 1
+	set(feature::lahf_sahf, bit(r.extended_1_ecx, 0));
+	set(feature::lzcnt, bit(r.extended_1_ecx, 5));
+
+	// leaf 7
+	set(feature::bmi1, bit(r.leaf_7_ebx, 3));
+	set(feature::bmi2, bit(r.leaf_7_ebx, 8));
+	set(feature::rdseed, bit(r.leaf_7_ebx, 18));
+	set(feature::adx, bit(r.leaf_7_ebx, 19));
+	set(feature::sha, bit(r.leaf_7_ebx, 29));
+	set(feature::gfni, bit(r.leaf_7_ecx, 8));
+
+	// avx state (xmm and ymm) must be enabled by the os
+	const bool os_avx = bit(r.leaf_1_ecx, 27) && (r.xcr0 & 0x6) == 0x6;
+
+	if (os_avx) {
+		set(feature::avx, bit(r.leaf_1_ecx, 28));
+		set(feature::fma, bit(r.leaf_1_ecx, 12));
+		set(feature::f16c, bit(r.leaf_1_ecx, 29));
+		set(feature::avx2, bit(r.leaf_7_ebx, 5));
+		set(feature::vaes, bit(r.leaf_7_ecx, 9));
+		set(feature::vpclmulqdq, bit(r.leaf_7_ecx, 10));
+		set(feature::avx_vnni, bit(r.leaf_7_1_eax, 4));
+	}
+
+	// avx-512 additionally needs the opmask and zmm state
+	const bool os_avx512 = os_avx && (r.xcr0 & 0xE0) == 0xE0;
+
+	if (os_avx512) {
+		set(feature::avx512f, bit(r.leaf_7_ebx, 16));
+		set(feature::avx512dq, bit(r.leaf_7_ebx, 17));
+		set(feature::avx512ifma, bit(r.leaf_7_ebx, 21));
+		set(feature::avx512cd, bit(r.leaf_7_ebx, 28));
+		set(feature::avx512bw, bit(r.leaf_7_ebx, 30));
+		set(feature::avx512vl, bit(r.leaf_7_ebx, 31));
+		set(feature::avx512vbmi, bit(r.leaf_7_ecx, 1));
+		set(feature::avx512vbmi2, bit(r.leaf_7_ecx, 6));
+		set(feature::avx512vnni, bit(r.leaf_7_ecx, 11));
+		set(feature::avx512bitalg, bit(r.leaf_7_ecx, 12));
+		set(feature::avx512vpopcntdq, bit(r.leaf_7_ecx, 14));
+		set(feature::avx512fp16, bit(r.leaf_7_edx, 23));
+		set(feature::avx512bf16, bit(r.leaf_7_1_eax, 5));
+	}
+
+	return features;
+}
+
+int cpu_features::level(const feature_set& features) {
+	auto has = [&](std::initializer_list<feature> list) {
+		for (const auto& f : list) {
+			if (!features.test(static_cast<size_t>(f)))
+				return false;
+		}
+		return true;
+	};
+
+	if (!has({ feature::sse, feature::sse2 }))
+		return 0;
+
+	if (!has({ feature::cx16, feature::lahf_sahf, feature::popcnt,
+		feature::sse3, feature::ssse3, feature::sse4_1, feature::sse4_2 }))
+		return 1;
+
+	if (!has({ feature::avx, feature::avx2, feature::bmi1, feature::bmi2,
+		feature::f16c, feature::fma, feature::lzcnt, feature::movbe, feature::osxsave }))
+		return 2;
+
+	if (!has({ feature::avx512f, feature::avx512bw, feature::avx512cd,
+		feature::avx512dq, feature::avx512vl }))
+		return 3;
+
+	return 4;
+}
+
+std::string cpu_features::to_string(feature f) {
+	const auto index = static_cast<size_t>(f);
+	return index < static_cast<size_t>(feature::count) ? feature_names[index] : std::string();
+}
+
+std::string cpu_features::to_string(const feature_set& features) {
+	std::string text;
+
+	for (size_t i = 0; i < features.size(); i++) {
+		if (!features.test(i))
+			continue;
+
+		if (!text.empty())
+			text += ", ";
+
+		text += feature_names[i];
+	}
+
+	return text;
+}
+
+std::string cpu_features::summary(const features_info& info) {
+	std::string text = info.level > 0 ? "x86-64-v" + std::to_string(info.level) : "Pre x86-64";
+
+	// the widest extensions are the ones binaries get selected on
+	const feature highlights[] = {
+		feature::sse4_2, feature::avx, feature::avx2, feature::fma,
+		feature::avx512f, feature::avx512bw, feature::avx512vnni, feature::avx_vnni,
+		feature::aes, feature::sha
+	};
+
+	for (const auto& f : highlights) {
+		if (info.features.test(static_cast<size_t>(f)))
+			text += ", " + to_string(f);
+	}
+
+	return text;
+}
+
+std::string cpu_features::to_hex(const feature_set& features) {
+	char buffer[32] = { 0 };
+	snprintf(buffer, sizeof(buffer), "%016llx", features.to_ullong());
+	return buffer;
+}
+
+bool cpu_features::from_hex(const std::string& hex, feature_set& features) {
+	if (hex.empty() || hex.size() > 16)
+		return false;
+
+	try {
+		size_t idx = 0;
+		const unsigned long long value = std::stoull(hex, &idx, 16);
+
+		if (idx != hex.size())
+			return false;
+
+		features = feature_set(value);
+		return true;
+	}
+	catch (const std::exception&) {
+		return false;
+	}
+}
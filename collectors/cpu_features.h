@@ -0,0 +1,134 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitset>
+#include <string>
+
+/// <summary>
+/// CPUID based instruction-set feature detection.
+/// </summary>
+/// <remarks>
+/// Features are kept in a compact bitset so they can be stored and compared cheaply, and
+/// serialized with <see cref="to_hex"/>. Decoding is separate from reading so known CPUID
+/// register dumps can be decoded without the hardware that produced them.
+/// </remarks>
+class cpu_features {
+public:
+	/// <summary>
+	/// Detected features. The order is part of the serialized format, append new features at
+	/// the end, just before count.
+	/// </summary>
+	enum class feature : unsigned {
+		sse, sse2, sse3, ssse3, sse4_1, sse4_2,
+		popcnt, lzcnt, movbe, cx16, lahf_sahf,
+		aes, pclmulqdq, sha, rdrand, rdseed, adx,
+		bmi1, bmi2, xsave, osxsave,
+		avx, f16c, fma, avx2, avx_vnni,
+		avx512f, avx512dq, avx512cd, avx512bw, avx512vl,
+		avx512ifma, avx512vbmi, avx512vbmi2, avx512vnni,
+		avx512bitalg, avx512vpopcntdq, avx512bf16, avx512fp16,
+		gfni, vaes, vpclmulqdq,
+		count
+	};
+
+	using feature_set = std::bitset<static_cast<size_t>(feature::count)>;
+
+	/// <summary>
+	/// The raw CPUID (and XCR0) register values the features are decoded from.
+	/// </summary>
+	struct cpuid_registers {
+		unsigned int max_leaf = 0;
+		unsigned int max_extended_leaf = 0;
+		unsigned int leaf_1_ecx = 0;
+		unsigned int leaf_1_edx = 0;
+		unsigned int leaf_7_ebx = 0;
+		unsigned int leaf_7_ecx = 0;
+		unsigned int leaf_7_edx = 0;
+		unsigned int leaf_7_1_eax = 0;
+		unsigned int extended_1_ecx = 0;
+		unsigned int extended_1_edx = 0;
+		unsigned long long xcr0 = 0;
+	};
+
+	struct features_info {
+		feature_set features;
+
+		/// <summary>The x86-64 microarchitecture level (1 to 4), or 0 if below baseline.</summary>
+		int level = 0;
+	};
+
+	cpu_features();
+	~cpu_features();
+
+	/// <summary>
+	/// Read the features of the cpu the calling thread is running on.
+	/// </summary>
+	/// <param name="info">The features information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(features_info& info, std::string& error);
+
+	/// <summary>
+	/// Read the raw CPUID registers.
+	/// </summary>
+	static bool read_registers(cpuid_registers& registers, std::string& error);
+
+	/// <summary>
+	/// Decode features from raw CPUID registers, taking operating system support for the
+	/// extended register state into account.
+	/// </summary>
+	static feature_set decode(const cpuid_registers& registers);
+
+	/// <summary>
+	/// Get the x86-64 microarchitecture level a feature set satisfies.
+	/// </summary>
+	static int level(const feature_set& features);
+
+	/// <summary>
+	/// Get the display name of a feature, e.g. "AVX-512F".
+	/// </summary>
+	static std::string to_string(feature f);
+
+	/// <summary>
+	/// Get a comma separated list of the features in a set.
+	/// </summary>
+	static std::string to_string(const feature_set& features);
+
+	/// <summary>
+	/// Get a short summary of the most significant SIMD extensions in a set.
+	/// </summary>
+	static std::string summary(const features_info& info);
+
+	/// <summary>
+	/// Serialize a feature set to a hexadecimal string.
+	/// </summary>
+	static std::string to_hex(const feature_set& features);
+
+	/// <summary>
+	/// Deserialize a feature set from a hexadecimal string made by <see cref="to_hex"/>.
+	/// </summary>
+	static bool from_hex(const std::string& hex, feature_set& features);
+};
@@ -0,0 +1,239 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "cpu_frequency.h"
+
+#include <Windows.h>
+#include <powerbase.h>
+#include <Pdh.h>
+#pragma comment(lib, "PowrProf.lib")
+#pragma comment(lib, "Pdh.lib")
+
+#include <map>
+
+// documented but not declared in the sdk headers
+typedef struct _PROCESSOR_POWER_INFORMATION {
+	ULONG Number;
+	ULONG MaxMhz;
+	ULONG CurrentMhz;
+	ULONG MhzLimit;
+	ULONG MaxIdleState;
+	ULONG CurrentIdleState;
+} PROCESSOR_POWER_INFORMATION, * PPROCESSOR_POWER_INFORMATION;
+
+#ifndef STATUS_BUFFER_TOO_SMALL
+#define STATUS_BUFFER_TOO_SMALL ((LONG)0xC0000023L)
+#endif
+
+const double cpu_frequency::throttle_threshold = 0.8;
+
+struct cpu_frequency::performance_query {
+	PDH_HQUERY query = nullptr;
+	PDH_HCOUNTER performance = nullptr;
+	bool primed = false;
+	std::vector<unsigned char> buffer;
+
+	performance_query() {
+		if (PdhOpenQueryA(nullptr, 0, &query) != ERROR_SUCCESS) {
+			query = nullptr;
+			return;
+		}
+
+		// one instance per logical processor, named "group,number"; english so it is found on localized systems too
+		if (PdhAddEnglishCounterA(query, "\\Processor Information(*)\\% Processor Performance", 0, &performance) != ERROR_SUCCESS) {
+			PdhCloseQuery(query);
+			query = nullptr;
+		}
+	}
+
+	~performance_query() {
+		if (query)
+			PdhCloseQuery(query);
+	}
+
+	// the performance of each logical processor as a percentage of nominal, by processor number
+	bool read(std::map<unsigned long, double>& values) {
+		values.clear();
+
+		if (!query || PdhCollectQueryData(query) != ERROR_SUCCESS)
+			return false;
+
+		// the counter is a rate, the first collection only primes it
+		if (!primed) {
+			primed = true;
+			return false;
+		}
+
+		DWORD size = static_cast<DWORD>(buffer.size());
+		DWORD count = 0;
+		PDH_STATUS status = PdhGetFormattedCounterArrayA(performance, PDH_FMT_DOUBLE, &size, &count,
+			reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data()));
+
+		if (status == PDH_MORE_DATA) {
+			buffer.resize(size);
+			status = PdhGetFormattedCounterArrayA(performance, PDH_FMT_DOUBLE, &size, &count,
+				reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data()));
+		}
+
+		if (status != ERROR_SUCCESS)
+			return false;
+
+		const auto items = reinterpret_cast<const PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data());
+
+		for (DWORD i = 0; i < count; i++) {
+			// skip the "_Total" and "0,_Total" instances
+			const std::string name = items[i].szName ? items[i].szName : "";
+			const auto comma = name.find(',');
+
+			if (comma == std::string::npos || name.find('_') != std::string::npos)
+				continue;
+
+			// processor numbers run on across groups
+			WORD group = 0;
+			unsigned long number = 0;
+
+			try {
+				group = static_cast<WORD>(std::stoul(name.substr(0, comma)));
+				number = std::stoul(name.substr(comma + 1));
+			}
+			catch (const std::exception&) {
+				continue;
+			}
+
+			for (WORD g = 0; g < group; g++)
+				number += GetActiveProcessorCount(g);
+
+			values[number] = items[i].FmtValue.doubleValue;
+		}
+
+		return !values.empty();
+	}
+};
+
+bool cpu_frequency::core_frequency::operator==(const core_frequency& param) const {
+	return number == param.number &&
+		current_mhz == param.current_mhz &&
+		base_mhz == param.base_mhz &&
+		limit_mhz == param.limit_mhz &&
+		throttled == param.throttled;
+}
+
+bool cpu_frequency::core_frequency::operator!=(const core_frequency& param) const {
+	return !operator==(param);
+}
+
+bool cpu_frequency::frequency_info::operator==(const frequency_info& param) const {
+	return cores == param.cores;
+}
+
+bool cpu_frequency::frequency_info::operator!=(const frequency_info& param) const {
+	return !operator==(param);
+}
+
+cpu_frequency::cpu_frequency() :
+	_performance(new performance_query()) {}
+
+cpu_frequency::~cpu_frequency() {
+	delete _performance;
+}
+
+bool cpu_frequency::read(frequency_info& info, std::string& error) {
+	info = {};
+
+	if (_buffer.empty()) {
+		const DWORD processors = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+		_buffer.resize(sizeof(PROCESSOR_POWER_INFORMATION) * (processors > 0 ? processors : 1));
+	}
+
+	// one call returns every logical processor, grow the buffer once if the count changed
+	LONG status = CallNtPowerInformation(ProcessorInformation, nullptr, 0,
+		_buffer.data(), static_cast<ULONG>(_buffer.size()));
+
+	if (status == STATUS_BUFFER_TOO_SMALL) {
+		_buffer.resize(_buffer.size() * 2);
+		status = CallNtPowerInformation(ProcessorInformation, nullptr, 0,
+			_buffer.data(), static_cast<ULONG>(_buffer.size()));
+	}
+
+	if (status != 0) {
+		error = "Reading processor frequency failed (status " + std::to_string(status) + ")";
+		return false;
+	}
+
+	std::map<unsigned long, double> performance;
+	_performance->read(performance);
+
+	const size_t count = _buffer.size() / sizeof(PROCESSOR_POWER_INFORMATION);
+	const auto p_info = reinterpret_cast<const PROCESSOR_POWER_INFORMATION*>(_buffer.data());
+
+	info.cores.reserve(count);
+	unsigned long long total_mhz = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		const auto& processor = p_info[i];
+
+		// unused trailing entries are left zeroed
+		if (processor.MaxMhz == 0)
+			continue;
+
+		core_frequency core;
+		core.number = processor.Number;
+		core.current_mhz = processor.CurrentMhz;
+		core.base_mhz = processor.MaxMhz;
+
+		const auto it = performance.find(processor.Number);
+		if (it != performance.end())
+			core.current_mhz = static_cast<unsigned long>(processor.MaxMhz * it->second / 100.0 + 0.5);
+
+		core.limit_mhz = processor.MhzLimit;
+		core.throttled = is_throttled(core.base_mhz, core.limit_mhz);
+
+		total_mhz += core.current_mhz;
+
+		if (info.lowest_mhz == 0 || core.current_mhz < info.lowest_mhz)
+			info.lowest_mhz = core.current_mhz;
+
+		if (core.throttled)
+			info.throttled_cores++;
+
+		info.cores.push_back(core);
+	}
+
+	if (info.cores.empty()) {
+		error = "No processor frequency information available";
+		return false;
+	}
+
+	info.average_mhz = static_cast<unsigned long>(total_mhz / info.cores.size());
+	return true;
+}
+
+bool cpu_frequency::is_throttled(unsigned long base_mhz, unsigned long limit_mhz) {
+	// a zero limit is not reported rather than a cap
+	if (base_mhz == 0 || limit_mhz == 0)
+		return false;
+
+	// the platform, e.g. thermal or power limits, is capping the core well below base speed
+	return limit_mhz < throttle_threshold * base_mhz;
+}
@@ -0,0 +1,112 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Per-core clock frequency sampler.
+/// </summary>
+/// <remarks>
+/// All logical processors are read in a single pass per call to <see cref="read"/>. The buffer
+/// used for the read is kept between calls so periodic sampling does not allocate. The current
+/// speed reported by the power information is nominal or stale on recent Windows builds, so the
+/// effective speed is the base speed scaled by the "% Processor Performance" counter, which
+/// tracks the actual to nominal clock ratio; the reported speed is only a fallback for when the
+/// counter is missing and for the first read, which primes it.
+/// </remarks>
+class cpu_frequency {
+public:
+	/// <summary>
+	/// Cores the platform caps below this fraction of their base speed are flagged as throttled.
+	/// </summary>
+	static const double throttle_threshold;
+
+	struct core_frequency {
+		/// <summary>The logical processor number.</summary>
+		unsigned long number = 0;
+
+		/// <summary>The current (effective) clock speed, in MHz.</summary>
+		unsigned long current_mhz = 0;
+
+		/// <summary>The base (nominal) clock speed, in MHz.</summary>
+		unsigned long base_mhz = 0;
+
+		/// <summary>The limit currently imposed on the clock speed by the platform, in MHz.</summary>
+		unsigned long limit_mhz = 0;
+
+		/// <summary>Whether the platform is capping the core well below its base speed.</summary>
+		bool throttled = false;
+
+		bool operator==(const core_frequency&) const;
+		bool operator!=(const core_frequency&) const;
+	};
+
+	struct frequency_info {
+		std::vector<core_frequency> cores;
+
+		/// <summary>The average current clock speed across all cores, in MHz.</summary>
+		unsigned long average_mhz = 0;
+
+		/// <summary>The lowest current clock speed across all cores, in MHz.</summary>
+		unsigned long lowest_mhz = 0;
+
+		/// <summary>The number of cores flagged as throttled.</summary>
+		size_t throttled_cores = 0;
+
+		bool operator==(const frequency_info&) const;
+		bool operator!=(const frequency_info&) const;
+	};
+
+	cpu_frequency();
+	~cpu_frequency();
+
+	/// <summary>
+	/// Read the current frequency of all logical processors.
+	/// </summary>
+	/// <param name="info">The frequency information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(frequency_info& info, std::string& error);
+
+	/// <summary>
+	/// Check whether a core is throttled.
+	/// </summary>
+	/// <param name="base_mhz">The base clock speed, in MHz.</param>
+	/// <param name="limit_mhz">The platform imposed limit, in MHz.</param>
+	/// <returns>Returns true if the platform is capping the core well below its base speed.</returns>
+	/// <remarks>
+	/// The current speed is deliberately not considered: idle cores drop far below base speed in
+	/// their low power states, which is normal power management and not throttling.
+	/// </remarks>
+	static bool is_throttled(unsigned long base_mhz, unsigned long limit_mhz);
+
+private:
+	std::vector<unsigned char> _buffer;
+
+	struct performance_query;
+	performance_query* _performance = nullptr;
+};
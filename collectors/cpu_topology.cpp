@@ -0,0 +1,303 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "cpu_topology.h"
+
+#include <Windows.h>
+#include <algorithm>
+#include <set>
+
+// leccore
+#include <liblec/leccore/system.h>
+
+namespace {
+	unsigned long count_bits(unsigned long long mask) {
+		unsigned long count = 0;
+		for (; mask; mask &= mask - 1)
+			count++;
+		return count;
+	}
+
+	void add_processors(const std::vector<unsigned long long>& active_masks, const GROUP_AFFINITY& affinity,
+		std::vector<unsigned long>& processors) {
+		for (unsigned long bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+			if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit))
+				processors.push_back(cpu_topology::processor_number(active_masks, affinity.Group, bit));
+		}
+	}
+
+	bool overlaps(const std::vector<unsigned long>& a, const std::vector<unsigned long>& b) {
+		for (const auto& processor : a) {
+			if (std::find(b.begin(), b.end(), processor) != b.end())
+				return true;
+		}
+
+		return false;
+	}
+}
+
+cpu_topology::cpu_topology() {}
+cpu_topology::~cpu_topology() {}
+
+bool cpu_topology::read(topology_info& info, std::string& error) {
+	info = {};
+
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+		error = "Reading processor topology failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	std::vector<unsigned char> buffer(length);
+
+	if (!GetLogicalProcessorInformationEx(RelationAll,
+		reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+		error = "Reading processor topology failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	// the active processors of each group, needed to number processors the way the rest of the app does
+	std::vector<unsigned long long> active_masks;
+
+	for (DWORD offset = 0; offset < length;) {
+		const auto p_record = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+
+		if (p_record->Relationship == RelationGroup) {
+			for (WORD i = 0; i < p_record->Group.ActiveGroupCount; i++)
+				active_masks.push_back(p_record->Group.GroupInfo[i].ActiveProcessorMask);
+		}
+
+		offset += p_record->Size;
+	}
+
+	// records are variable length, walk them by their Size field
+	for (DWORD offset = 0; offset < length;) {
+		const auto p_record = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+
+		switch (p_record->Relationship) {
+		case RelationProcessorPackage: {
+			package_info package;
+			for (WORD i = 0; i < p_record->Processor.GroupCount; i++)
+				add_processors(active_masks, p_record->Processor.GroupMask[i], package.logical_processors);
+
+			info.packages.push_back(package);
+		} break;
+
+		case RelationProcessorCore: {
+			core_info core;
+			core.efficiency_class = p_record->Processor.EfficiencyClass;
+
+			for (WORD i = 0; i < p_record->Processor.GroupCount; i++)
+				add_processors(active_masks, p_record->Processor.GroupMask[i], core.logical_processors);
+
+			info.cores.push_back(core);
+		} break;
+
+		case RelationCache: {
+			const auto& cache_record = p_record->Cache;
+
+			cache_info cache;
+			cache.level = cache_record.Level;
+			cache.size = cache_record.CacheSize;
+			cache.line_size = cache_record.LineSize;
+			cache.associativity = cache_record.Associativity;
+
+			switch (cache_record.Type) {
+			case CacheData: cache.type = "Data"; break;
+			case CacheInstruction: cache.type = "Instruction"; break;
+			case CacheTrace: cache.type = "Trace"; break;
+			case CacheUnified:
+			default: cache.type = "Unified"; break;
+			}
+
+			add_processors(active_masks, cache_record.GroupMask, cache.shared_by);
+			info.caches.push_back(cache);
+		} break;
+
+		case RelationNumaNode: {
+			numa_node_info node;
+			node.number = p_record->NumaNode.NodeNumber;
+			add_processors(active_masks, p_record->NumaNode.GroupMask, node.logical_processors);
+			info.numa_nodes.push_back(node);
+		} break;
+
+		default:
+			break;
+		}
+
+		offset += p_record->Size;
+	}
+
+	// assign cores to packages
+	for (auto& core : info.cores) {
+		for (size_t package = 0; package < info.packages.size(); package++) {
+			if (overlaps(core.logical_processors, info.packages[package].logical_processors)) {
+				core.package = static_cast<unsigned long>(package);
+				break;
+			}
+		}
+	}
+
+	// order caches by level, then type, so summaries read L1d, L1i, L2, L3
+	std::stable_sort(info.caches.begin(), info.caches.end(), [](const cache_info& a, const cache_info& b) {
+		return a.level != b.level ? a.level < b.level : a.type < b.type;
+		});
+
+	if (info.packages.empty()) {
+		error = "No processor topology information available";
+		return false;
+	}
+
+	return true;
+}
+
+std::vector<cpu_topology::cache_info> cpu_topology::package_caches(const topology_info& info, size_t package) {
+	std::vector<cache_info> caches;
+
+	if (package >= info.packages.size())
+		return caches;
+
+	for (const auto& cache : info.caches) {
+		if (overlaps(cache.shared_by, info.packages[package].logical_processors))
+			caches.push_back(cache);
+	}
+
+	return caches;
+}
+
+std::string cpu_topology::cache_summary(const topology_info& info, size_t package) {
+	const auto caches = package_caches(info, package);
+
+	std::string text;
+	unsigned long line_size = 0;
+
+	for (size_t i = 0; i < caches.size();) {
+		// group identical caches at the same level
+		const auto& cache = caches[i];
+		size_t count = 0;
+
+		while (i < caches.size() &&
+			caches[i].level == cache.level &&
+			caches[i].type == cache.type &&
+			caches[i].size == cache.size) {
+			count++;
+			i++;
+		}
+
+		if (!text.empty())
+			text += ", ";
+
+		text += "L" + std::to_string(cache.level);
+
+		if (cache.type == "Data")
+			text += "d";
+		else
+			if (cache.type == "Instruction")
+				text += "i";
+
+		text += " " + liblec::leccore::format_size(cache.size);
+
+		if (count > 1)
+			text += " x" + std::to_string(count);
+
+		line_size = std::max(line_size, cache.line_size);
+	}
+
+	if (line_size > 0)
+		text += ", " + std::to_string(line_size) + "B line";
+
+	return text;
+}
+
+std::string cpu_topology::layout_summary(const topology_info& info, size_t package) {
+	if (package >= info.packages.size())
+		return std::string();
+
+	size_t cores = 0, smt_cores = 0;
+	std::set<unsigned long> efficiency_classes;
+
+	for (const auto& core : info.cores) {
+		if (core.package != package)
+			continue;
+
+		cores++;
+		efficiency_classes.insert(core.efficiency_class);
+
+		if (core.logical_processors.size() > 1)
+			smt_cores++;
+	}
+
+	std::string text = std::to_string(info.numa_nodes.size()) +
+		std::string(info.numa_nodes.size() == 1 ? " NUMA node" : " NUMA nodes");
+
+	text += ", " + std::string(smt_cores > 0 ?
+		std::to_string(smt_cores) + " of " + std::to_string(cores) + " cores with SMT" : "no SMT");
+
+	if (efficiency_classes.size() > 1)
+		text += ", hybrid (" + std::to_string(efficiency_classes.size()) + " core types)";
+
+	return text;
+}
+
+unsigned long cpu_topology::processor_number(const std::vector<unsigned long long>& active_masks,
+	unsigned short group, unsigned long bit) {
+	unsigned long number = 0;
+
+	for (size_t g = 0; g < group && g < active_masks.size(); g++)
+		number += count_bits(active_masks[g]);
+
+	if (group < active_masks.size())
+		number += count_bits(bit < 64 ? active_masks[group] & ((1ULL << bit) - 1) : active_masks[group]);
+	else
+		number += bit;
+
+	return number;
+}
+
+std::string cpu_topology::to_ranges(const std::vector<unsigned long>& processors) {
+	std::vector<unsigned long> sorted = processors;
+	std::sort(sorted.begin(), sorted.end());
+
+	std::string text;
+
+	for (size_t i = 0; i < sorted.size();) {
+		size_t j = i;
+		while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1)
+			j++;
+
+		if (!text.empty())
+			text += ", ";
+
+		text += std::to_string(sorted[i]);
+
+		if (j > i)
+			text += "-" + std::to_string(sorted[j]);
+
+		i = j + 1;
+	}
+
+	return text;
+}
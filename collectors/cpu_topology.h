@@ -0,0 +1,132 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// CPU cache hierarchy and topology detection.
+/// </summary>
+/// <remarks>
+/// Logical processors are numbered contiguously across processor groups, the same way as
+/// GetEventProcessorIndex and the other collectors number them, see <see cref="processor_number"/>.
+/// </remarks>
+class cpu_topology {
+public:
+	struct cache_info {
+		/// <summary>The cache level, e.g. 1 for L1.</summary>
+		unsigned long level = 0;
+
+		/// <summary>The cache type, either "Data", "Instruction" or "Unified".</summary>
+		std::string type;
+
+		/// <summary>The size of the cache, in bytes.</summary>
+		unsigned long long size = 0;
+
+		/// <summary>The cache line size, in bytes.</summary>
+		unsigned long line_size = 0;
+
+		/// <summary>The cache associativity, 0xFF for fully associative.</summary>
+		unsigned long associativity = 0;
+
+		/// <summary>The logical processors sharing this cache.</summary>
+		std::vector<unsigned long> shared_by;
+	};
+
+	struct core_info {
+		/// <summary>The package this core belongs to.</summary>
+		unsigned long package = 0;
+
+		/// <summary>The logical processors (SMT siblings) of this core.</summary>
+		std::vector<unsigned long> logical_processors;
+
+		/// <summary>The core's efficiency class. Higher values are higher performance cores.</summary>
+		unsigned long efficiency_class = 0;
+	};
+
+	struct package_info {
+		std::vector<unsigned long> logical_processors;
+	};
+
+	struct numa_node_info {
+		unsigned long number = 0;
+		std::vector<unsigned long> logical_processors;
+	};
+
+	struct topology_info {
+		std::vector<package_info> packages;
+		std::vector<core_info> cores;
+		std::vector<cache_info> caches;
+		std::vector<numa_node_info> numa_nodes;
+	};
+
+	cpu_topology();
+	~cpu_topology();
+
+	/// <summary>
+	/// Read the cpu topology.
+	/// </summary>
+	/// <param name="info">The topology information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(topology_info& info, std::string& error);
+
+	/// <summary>
+	/// Get the caches belonging to a package.
+	/// </summary>
+	/// <param name="info">The topology information.</param>
+	/// <param name="package">The package number.</param>
+	/// <returns>The caches shared by at least one of the package's logical processors.</returns>
+	static std::vector<cache_info> package_caches(const topology_info& info, size_t package);
+
+	/// <summary>
+	/// Get a one line summary of a package's caches, e.g. "L1d 48KB x8, L2 1.25MB x8, L3 24MB".
+	/// </summary>
+	static std::string cache_summary(const topology_info& info, size_t package);
+
+	/// <summary>
+	/// Get a one line summary of a package's cores, smt and numa layout.
+	/// </summary>
+	static std::string layout_summary(const topology_info& info, size_t package);
+
+	/// <summary>
+	/// Get the number of a logical processor, counted contiguously across processor groups.
+	/// </summary>
+	/// <param name="active_masks">The active processor mask of each processor group.</param>
+	/// <param name="group">The processor's group.</param>
+	/// <param name="bit">The processor's bit in its group's affinity mask.</param>
+	/// <returns>The active processors in the groups before it, plus those below it in its own group.</returns>
+	/// <remarks>
+	/// Two groups of 48 processors number them 0-95, not 0-47 and 64-111.
+	/// </remarks>
+	static unsigned long processor_number(const std::vector<unsigned long long>& active_masks,
+		unsigned short group, unsigned long bit);
+
+	/// <summary>
+	/// Format a list of logical processors as ranges, e.g. "0-3, 8".
+	/// </summary>
+	static std::string to_ranges(const std::vector<unsigned long>& processors);
+};
@@ -0,0 +1,149 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "disk_activity.h"
+
+#include <Windows.h>
+#include <winioctl.h>
+
+struct disk_activity::disk_state {
+	HANDLE handle = INVALID_HANDLE_VALUE;
+	DISK_PERFORMANCE last = {};
+	bool primed = false;
+
+	~disk_state() {
+		if (handle != INVALID_HANDLE_VALUE)
+			CloseHandle(handle);
+	}
+};
+
+bool disk_activity::disk_counters::operator==(const disk_counters& param) const {
+	return number == param.number &&
+		read_bytes == param.read_bytes &&
+		write_bytes == param.write_bytes &&
+		read_iops == param.read_iops &&
+		write_iops == param.write_iops &&
+		queue_depth == param.queue_depth &&
+		busy == param.busy;
+}
+
+bool disk_activity::disk_counters::operator!=(const disk_counters& param) const {
+	return !operator==(param);
+}
+
+const disk_activity::disk_counters* disk_activity::activity_info::find(unsigned long number) const {
+	for (const auto& disk : disks)
+		if (disk.number == number)
+			return &disk;
+
+	return nullptr;
+}
+
+bool disk_activity::activity_info::operator==(const activity_info& param) const {
+	return disks == param.disks;
+}
+
+bool disk_activity::activity_info::operator!=(const activity_info& param) const {
+	return !operator==(param);
+}
+
+disk_activity::disk_activity() {}
+
+disk_activity::~disk_activity() {
+	for (auto& it : _disks)
+		delete it.second;
+}
+
+bool disk_activity::read(const std::vector<unsigned long>& disk_numbers, activity_info& info, std::string& error) {
+	info.disks.clear();
+
+	// close the handles of disks that have gone
+	for (auto it = _disks.begin(); it != _disks.end();) {
+		bool listed = false;
+		for (const auto& number : disk_numbers)
+			listed = listed || number == it->first;
+
+		if (!listed) {
+			delete it->second;
+			it = _disks.erase(it);
+		}
+		else
+			it++;
+	}
+
+	DWORD last_error = ERROR_SUCCESS;
+
+	for (const auto& number : disk_numbers) {
+		auto& state = _disks[number];
+
+		if (!state) {
+			// no access rights are needed for the performance counters
+			state = new disk_state();
+			state->handle = CreateFileA(("\\\\.\\PhysicalDrive" + std::to_string(number)).c_str(), 0,
+				FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+		}
+
+		if (state->handle == INVALID_HANDLE_VALUE)
+			continue;
+
+		DISK_PERFORMANCE current = {};
+		DWORD bytes = 0;
+
+		if (!DeviceIoControl(state->handle, IOCTL_DISK_PERFORMANCE, nullptr, 0,
+			&current, sizeof(current), &bytes, nullptr)) {
+			last_error = GetLastError();
+			continue;
+		}
+
+		disk_counters counters;
+		counters.number = number;
+		counters.queue_depth = current.QueueDepth;
+
+		// query time and idle time are in 100ns units
+		const double interval = static_cast<double>(current.QueryTime.QuadPart - state->last.QueryTime.QuadPart);
+
+		if (state->primed && interval > 0.0) {
+			const double seconds = interval / 1.e7;
+
+			counters.read_bytes = (current.BytesRead.QuadPart - state->last.BytesRead.QuadPart) / seconds;
+			counters.write_bytes = (current.BytesWritten.QuadPart - state->last.BytesWritten.QuadPart) / seconds;
+			counters.read_iops = (current.ReadCount - state->last.ReadCount) / seconds;
+			counters.write_iops = (current.WriteCount - state->last.WriteCount) / seconds;
+
+			const double idle = static_cast<double>(current.IdleTime.QuadPart - state->last.IdleTime.QuadPart);
+			counters.busy = idle >= interval ? 0.0 : 100.0 * (1.0 - idle / interval);
+		}
+
+		state->last = current;
+		state->primed = true;
+		info.disks.push_back(counters);
+	}
+
+	if (info.disks.empty()) {
+		error = "Reading disk performance counters failed (error " + std::to_string(last_error) + ")";
+		return false;
+	}
+
+	return true;
+}
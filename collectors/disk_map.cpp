@@ -0,0 +1,183 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "disk_map.h"
+
+#include <Windows.h>
+#include <winioctl.h>
+#include <cstring>
+
+namespace {
+	// physical disk numbers are not always contiguous, so probe this many
+	const unsigned long max_disks = 64;
+
+	std::string trim(const std::string& text) {
+		const auto begin = text.find_first_not_of(" \t");
+
+		if (begin == std::string::npos)
+			return std::string();
+
+		return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+	}
+
+	std::string descriptor_string(const std::vector<char>& buffer, DWORD offset) {
+		if (offset == 0 || offset >= buffer.size())
+			return std::string();
+
+		// null terminated within the descriptor
+		return trim(std::string(buffer.data() + offset, strnlen(buffer.data() + offset, buffer.size() - offset)));
+	}
+
+	bool read_disk(unsigned long number, disk_map::disk& disk) {
+		disk.number = number;
+		disk.path = "\\\\.\\PhysicalDrive" + std::to_string(number);
+
+		// no access rights are needed to query the device properties
+		HANDLE handle = CreateFileA(disk.path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr, OPEN_EXISTING, 0, nullptr);
+
+		if (handle == INVALID_HANDLE_VALUE)
+			return false;
+
+		STORAGE_PROPERTY_QUERY query = {};
+		query.PropertyId = StorageDeviceProperty;
+		query.QueryType = PropertyStandardQuery;
+
+		std::vector<char> buffer(1024);
+		DWORD bytes = 0;
+
+		if (DeviceIoControl(handle, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query),
+			buffer.data(), static_cast<DWORD>(buffer.size()), &bytes, nullptr) && bytes >= sizeof(STORAGE_DEVICE_DESCRIPTOR)) {
+			const auto descriptor = reinterpret_cast<const STORAGE_DEVICE_DESCRIPTOR*>(buffer.data());
+			buffer.resize(bytes);
+
+			disk.model = descriptor_string(buffer, descriptor->ProductIdOffset);
+			disk.serial_number = descriptor_string(buffer, descriptor->SerialNumberOffset);
+			disk.removable = descriptor->RemovableMedia ||
+				descriptor->BusType == BusTypeUsb ||
+				descriptor->BusType == BusType1394 ||
+				descriptor->BusType == BusTypeSd ||
+				descriptor->BusType == BusTypeMmc;
+		}
+
+		GET_LENGTH_INFORMATION length = {};
+		if (DeviceIoControl(handle, IOCTL_DISK_GET_LENGTH_INFO, nullptr, 0,
+			&length, sizeof(length), &bytes, nullptr))
+			disk.size = static_cast<unsigned long long>(length.Length.QuadPart);
+
+		CloseHandle(handle);
+		return true;
+	}
+
+	void read_volumes(std::vector<disk_map::disk>& disks) {
+		char drive_strings[512] = {};
+		const DWORD length = GetLogicalDriveStringsA(sizeof(drive_strings) - 1, drive_strings);
+
+		if (length == 0 || length >= sizeof(drive_strings))
+			return;
+
+		// double null terminated list of root paths, e.g. "C:\"
+		for (const char* root = drive_strings; *root; root += strlen(root) + 1) {
+			const UINT type = GetDriveTypeA(root);
+
+			if (type != DRIVE_FIXED && type != DRIVE_REMOVABLE)
+				continue;
+
+			const std::string volume_path = "\\\\.\\" + std::string(root, 2);
+			HANDLE handle = CreateFileA(volume_path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE,
+				nullptr, OPEN_EXISTING, 0, nullptr);
+
+			if (handle == INVALID_HANDLE_VALUE)
+				continue;
+
+			// room for a volume spanning a few disks
+			std::vector<char> buffer(sizeof(VOLUME_DISK_EXTENTS) + 7 * sizeof(DISK_EXTENT));
+			DWORD bytes = 0;
+
+			if (DeviceIoControl(handle, IOCTL_VOLUME_GET_VOLUME_DISK_EXTENTS, nullptr, 0,
+				buffer.data(), static_cast<DWORD>(buffer.size()), &bytes, nullptr)) {
+				const auto extents = reinterpret_cast<const VOLUME_DISK_EXTENTS*>(buffer.data());
+
+				for (DWORD i = 0; i < extents->NumberOfDiskExtents && i < 8; i++) {
+					for (auto& disk : disks) {
+						if (disk.number == extents->Extents[i].DiskNumber &&
+							(disk.volumes.empty() || disk.volumes.back() != root))
+							disk.volumes.push_back(root);
+					}
+				}
+			}
+
+			CloseHandle(handle);
+		}
+	}
+}
+
+bool disk_map::read(std::vector<disk>& disks, std::string& error) {
+	disks.clear();
+
+	for (unsigned long number = 0; number < max_disks; number++) {
+		disk disk;
+		if (read_disk(number, disk))
+			disks.push_back(disk);
+	}
+
+	if (disks.empty()) {
+		error = "No physical disks could be opened (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	read_volumes(disks);
+	return true;
+}
+
+bool disk_map::find(const std::vector<disk>& disks, const std::string& model,
+	const std::string& serial_number, unsigned long long size, disk& match) {
+	const std::string serial = trim(serial_number);
+
+	if (!serial.empty()) {
+		for (const auto& disk : disks) {
+			if (disk.serial_number == serial) {
+				match = disk;
+				return true;
+			}
+		}
+	}
+
+	// some bridges report no serial number or a different one, fall back to model and size
+	const disk* candidate = nullptr;
+	for (const auto& disk : disks) {
+		if (disk.model == trim(model) && disk.size == size) {
+			if (candidate)
+				return false;
+
+			candidate = &disk;
+		}
+	}
+
+	if (!candidate)
+		return false;
+
+	match = *candidate;
+	return true;
+}
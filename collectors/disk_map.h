@@ -0,0 +1,90 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Maps physical disks to their device paths and mounted volumes.
+/// </summary>
+/// <remarks>
+/// The drive information from leccore identifies drives by model and serial number only. This
+/// class enumerates \\.\PhysicalDriveN, reads the same identifiers from the storage driver and
+/// lists the drive letters whose extents live on each disk, so that per-disk queries and
+/// benchmarks can be matched back to a drive tab.
+/// </remarks>
+class disk_map {
+public:
+	struct disk {
+		/// <summary>The disk number, as in \\.\PhysicalDriveN.</summary>
+		unsigned long number = 0;
+
+		/// <summary>The device path, e.g. \\.\PhysicalDrive0.</summary>
+		std::string path;
+
+		/// <summary>The model (product id) reported by the storage driver.</summary>
+		std::string model;
+
+		/// <summary>The serial number reported by the storage driver.</summary>
+		std::string serial_number;
+
+		/// <summary>The size of the disk, in bytes.</summary>
+		unsigned long long size = 0;
+
+		/// <summary>Whether the disk can be ejected: removable media, or on a usb, firewire or sd bus.
+		/// USB hard drives and SSDs report themselves as fixed, so the drive type is not enough.</summary>
+		bool removable = false;
+
+		/// <summary>The root paths of the volumes on the disk, e.g. "C:\".</summary>
+		std::vector<std::string> volumes;
+	};
+
+	/// <summary>
+	/// Read the physical disks and their volumes.
+	/// </summary>
+	/// <param name="disks">The disks.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	/// <remarks>Does not require administrator rights.</remarks>
+	static bool read(std::vector<disk>& disks, std::string& error);
+
+	/// <summary>
+	/// Find the disk matching a drive.
+	/// </summary>
+	/// <param name="disks">The disks, from <see cref="read"/>.</param>
+	/// <param name="model">The drive's model.</param>
+	/// <param name="serial_number">The drive's serial number.</param>
+	/// <param name="size">The drive's size, in bytes.</param>
+	/// <param name="match">The matching disk.</param>
+	/// <returns>Returns true if a match was found, else false.</returns>
+	/// <remarks>
+	/// The serial number is compared first, ignoring surrounding whitespace which some drivers
+	/// pad it with. Failing that, a disk with the same model and size is accepted if it is the
+	/// only one.
+	/// </remarks>
+	static bool find(const std::vector<disk>& disks, const std::string& model,
+		const std::string& serial_number, unsigned long long size, disk& match);
+};
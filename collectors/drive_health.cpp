@@ -0,0 +1,400 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "drive_health.h"
+
+#include <Windows.h>
+#include <winioctl.h>
+
+#include <climits>
+#include <sstream>
+
+namespace {
+	// the daily series covers a year
+	const size_t max_samples = 365;
+	const long long seconds_per_day = 86400;
+
+	// wear moves in whole percent, so it is only projected over this much history
+	const long long minimum_wear_span = 30 * seconds_per_day;
+
+	// little endian integer of up to 8 bytes; nvme counters are 16 bytes wide, the upper half
+	// only matters beyond 2^64 and is treated as saturating
+	long long read_le(const unsigned char* p, size_t bytes) {
+		unsigned long long value = 0;
+		for (size_t i = 0; i < bytes && i < 8; i++)
+			value |= static_cast<unsigned long long>(p[i]) << (8 * i);
+
+		for (size_t i = 8; i < bytes; i++)
+			if (p[i] != 0)
+				return LLONG_MAX;
+
+		return value > static_cast<unsigned long long>(LLONG_MAX) ? LLONG_MAX : static_cast<long long>(value);
+	}
+
+	class device_handle {
+	public:
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		~device_handle() {
+			if (handle != INVALID_HANDLE_VALUE)
+				CloseHandle(handle);
+		}
+	};
+
+	bool read_nvme_log(HANDLE handle, std::vector<unsigned char>& page) {
+		// the query and the returned descriptor share one buffer, with the log page after them
+		const size_t header = FIELD_OFFSET(STORAGE_PROPERTY_QUERY, AdditionalParameters) + sizeof(STORAGE_PROTOCOL_SPECIFIC_DATA);
+		std::vector<unsigned char> buffer(header + drive_health::page_size);
+
+		auto query = reinterpret_cast<PSTORAGE_PROPERTY_QUERY>(buffer.data());
+		auto protocol = reinterpret_cast<PSTORAGE_PROTOCOL_SPECIFIC_DATA>(query->AdditionalParameters);
+
+		query->PropertyId = StorageDeviceProtocolSpecificProperty;
+		query->QueryType = PropertyStandardQuery;
+		protocol->ProtocolType = ProtocolTypeNvme;
+		protocol->DataType = NVMeDataTypeLogPage;
+		protocol->ProtocolDataRequestValue = NVME_LOG_PAGE_HEALTH_INFO;
+		protocol->ProtocolDataRequestSubValue = 0;
+		protocol->ProtocolDataOffset = sizeof(STORAGE_PROTOCOL_SPECIFIC_DATA);
+		protocol->ProtocolDataLength = static_cast<DWORD>(drive_health::page_size);
+
+		DWORD bytes = 0;
+		if (!DeviceIoControl(handle, IOCTL_STORAGE_QUERY_PROPERTY, buffer.data(), static_cast<DWORD>(buffer.size()),
+			buffer.data(), static_cast<DWORD>(buffer.size()), &bytes, nullptr))
+			return false;
+
+		auto descriptor = reinterpret_cast<PSTORAGE_PROTOCOL_DATA_DESCRIPTOR>(buffer.data());
+		const auto& data = descriptor->ProtocolSpecificData;
+		const size_t offset = FIELD_OFFSET(STORAGE_PROTOCOL_DATA_DESCRIPTOR, ProtocolSpecificData) + data.ProtocolDataOffset;
+
+		if (data.ProtocolDataLength < drive_health::page_size || offset + drive_health::page_size > buffer.size())
+			return false;
+
+		page.assign(buffer.begin() + offset, buffer.begin() + offset + drive_health::page_size);
+		return true;
+	}
+
+	bool read_ata_smart(HANDLE handle, std::vector<unsigned char>& page) {
+		SENDCMDINPARAMS in = {};
+		in.cBufferSize = READ_ATTRIBUTE_BUFFER_SIZE;
+		in.irDriveRegs.bFeaturesReg = READ_ATTRIBUTES;
+		in.irDriveRegs.bSectorCountReg = 1;
+		in.irDriveRegs.bSectorNumberReg = 1;
+		in.irDriveRegs.bCylLowReg = SMART_CYL_LOW;
+		in.irDriveRegs.bCylHighReg = SMART_CYL_HI;
+		in.irDriveRegs.bDriveHeadReg = 0xa0;
+		in.irDriveRegs.bCommandReg = SMART_CMD;
+
+		std::vector<unsigned char> buffer(sizeof(SENDCMDOUTPARAMS) + READ_ATTRIBUTE_BUFFER_SIZE);
+
+		DWORD bytes = 0;
+		if (!DeviceIoControl(handle, SMART_RCV_DRIVE_DATA, &in, sizeof(in) - 1,
+			buffer.data(), static_cast<DWORD>(buffer.size()), &bytes, nullptr))
+			return false;
+
+		auto out = reinterpret_cast<PSENDCMDOUTPARAMS>(buffer.data());
+		page.assign(out->bBuffer, out->bBuffer + drive_health::page_size);
+		return true;
+	}
+}
+
+const long long drive_health::unknown = -1;
+const size_t drive_health::page_size = 512;
+
+bool drive_health::health_info::operator==(const health_info& param) const {
+	return protocol == param.protocol &&
+		critical_warning == param.critical_warning &&
+		percentage_used == param.percentage_used &&
+		available_spare == param.available_spare &&
+		media_errors == param.media_errors &&
+		temperature == param.temperature &&
+		power_on_hours == param.power_on_hours &&
+		power_cycles == param.power_cycles &&
+		unsafe_shutdowns == param.unsafe_shutdowns;
+}
+
+bool drive_health::health_info::operator!=(const health_info& param) const {
+	return !operator==(param);
+}
+
+bool drive_health::read(const std::string& device_path, health_info& info, std::string& error) {
+	info = {};
+
+	// smart pass-through needs read and write access, the nvme log query usually does not
+	device_handle device;
+	device.handle = CreateFileA(device_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+
+	if (device.handle == INVALID_HANDLE_VALUE)
+		device.handle = CreateFileA(device_path.c_str(), 0,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+
+	if (device.handle == INVALID_HANDLE_VALUE) {
+		error = "Opening " + device_path + " failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	std::vector<unsigned char> page;
+
+	if (read_nvme_log(device.handle, page))
+		return parse_nvme_health_log(page.data(), page.size(), info, error);
+
+	if (read_ata_smart(device.handle, page))
+		return parse_ata_smart_attributes(page.data(), page.size(), info, error);
+
+	error = "Health information is not available for " + device_path;
+	return false;
+}
+
+bool drive_health::parse_nvme_health_log(const unsigned char* data, size_t size, health_info& info, std::string& error) {
+	info = {};
+
+	if (!data || size < page_size) {
+		error = "NVMe health log is too short";
+		return false;
+	}
+
+	info.protocol = "NVMe";
+	info.critical_warning = data[0] != 0;
+
+	// composite temperature is in kelvin, 0 when not reported
+	const long long kelvin = read_le(data + 1, 2);
+	if (kelvin > 0)
+		info.temperature = kelvin - 273;
+
+	info.available_spare = data[3];
+	info.percentage_used = data[5];
+	info.power_cycles = read_le(data + 112, 16);
+	info.power_on_hours = read_le(data + 128, 16);
+	info.unsafe_shutdowns = read_le(data + 144, 16);
+	info.media_errors = read_le(data + 160, 16);
+	return true;
+}
+
+bool drive_health::parse_ata_smart_attributes(const unsigned char* data, size_t size, health_info& info, std::string& error) {
+	info = {};
+
+	if (!data || size < page_size) {
+		error = "SMART attribute page is too short";
+		return false;
+	}
+
+	info.protocol = "ATA";
+
+	// life attributes in order of preference, normalized to count down from 100
+	const unsigned char life_attributes[] = { 231, 233, 177, 202 };
+	int life_rank = sizeof(life_attributes);
+
+	long long reallocated = unknown, uncorrectable = unknown, offline_uncorrectable = unknown;
+	bool found = false;
+
+	// 30 attributes of 12 bytes each after the 2 byte revision
+	for (size_t entry = 0; entry < 30; entry++) {
+		const unsigned char* attribute = data + 2 + entry * 12;
+		const unsigned char id = attribute[0];
+
+		if (id == 0)
+			continue;
+
+		found = true;
+		const unsigned char normalized = attribute[3];
+		const long long raw = read_le(attribute + 5, 6);
+
+		switch (id) {
+		case 5: reallocated = raw; break;
+		case 9: info.power_on_hours = raw & 0xffffffff; break;
+		case 12: info.power_cycles = raw; break;
+		case 187: uncorrectable = raw; break;
+		case 192: info.unsafe_shutdowns = raw; break;
+		case 194: info.temperature = raw & 0xff; break;
+		case 198: offline_uncorrectable = raw; break;
+		default: break;
+		}
+
+		for (int rank = 0; rank < life_rank; rank++) {
+			if (id == life_attributes[rank] && normalized <= 100) {
+				info.percentage_used = 100 - normalized;
+				life_rank = rank;
+				break;
+			}
+		}
+	}
+
+	if (!found) {
+		error = "SMART attribute page has no attributes";
+		return false;
+	}
+
+	if (reallocated != unknown || uncorrectable != unknown || offline_uncorrectable != unknown)
+		info.media_errors = (reallocated > 0 ? reallocated : 0) +
+		(uncorrectable > 0 ? uncorrectable : 0) +
+		(offline_uncorrectable > 0 ? offline_uncorrectable : 0);
+
+	// drives that track wear but do not flag it
+	info.critical_warning = info.percentage_used >= 100;
+	return true;
+}
+
+void drive_health::append(std::vector<health_sample>& series, const health_info& info, long long time) {
+	health_sample sample;
+	sample.time = time;
+	sample.percentage_used = info.percentage_used;
+	sample.media_errors = info.media_errors;
+	sample.temperature = info.temperature;
+	sample.power_on_hours = info.power_on_hours;
+	sample.unsafe_shutdowns = info.unsafe_shutdowns;
+
+	if (!series.empty() && series.back().time / seconds_per_day == time / seconds_per_day)
+		series.back() = sample;
+	else
+		series.push_back(sample);
+
+	if (series.size() > max_samples)
+		series.erase(series.begin(), series.begin() + (series.size() - max_samples));
+}
+
+std::string drive_health::serialize(const std::vector<health_sample>& series) {
+	std::string text;
+
+	for (const auto& sample : series) {
+		if (!text.empty())
+			text += ";";
+
+		text += std::to_string(sample.time) + "," +
+			std::to_string(sample.percentage_used) + "," +
+			std::to_string(sample.media_errors) + "," +
+			std::to_string(sample.temperature) + "," +
+			std::to_string(sample.power_on_hours) + "," +
+			std::to_string(sample.unsafe_shutdowns);
+	}
+
+	return text;
+}
+
+std::vector<drive_health::health_sample> drive_health::deserialize(const std::string& text) {
+	std::vector<health_sample> series;
+	std::stringstream samples(text);
+	std::string item;
+
+	while (std::getline(samples, item, ';')) {
+		std::stringstream fields(item);
+		health_sample sample;
+		char comma = 0;
+
+		if (fields >> sample.time >> comma >> sample.percentage_used >> comma >> sample.media_errors >> comma >>
+			sample.temperature >> comma >> sample.power_on_hours >> comma >> sample.unsafe_shutdowns)
+			series.push_back(sample);
+	}
+
+	return series;
+}
+
+bool drive_health::degrading(const std::vector<health_sample>& series) {
+	if (series.size() < 2)
+		return false;
+
+	const auto& first = series.front();
+	const auto& last = series.back();
+
+	if (first.media_errors != unknown && last.media_errors > first.media_errors)
+		return true;
+
+	// wear growing by more than a percent per 30 days, least squares fit of wear against time
+	// in days from the first sample so that a single tick does not read as a trend
+	const long long origin = first.time;
+	double n = 0.0, sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+	long long span = 0;
+
+	for (const auto& sample : series) {
+		if (sample.percentage_used == unknown)
+			continue;
+
+		const double x = static_cast<double>(sample.time - origin) / seconds_per_day;
+		const double y = static_cast<double>(sample.percentage_used);
+		n += 1.0;
+		sum_x += x;
+		sum_y += y;
+		sum_xx += x * x;
+		sum_xy += x * y;
+		span = sample.time - origin;
+	}
+
+	const double denominator = n * sum_xx - sum_x * sum_x;
+	if (span < minimum_wear_span || denominator <= 0.0)
+		return false;
+
+	const double slope = (n * sum_xy - sum_x * sum_y) / denominator;
+	return slope * 30.0 > 1.0;
+}
+
+std::string drive_health::trend(const std::vector<health_sample>& series) {
+	if (series.size() < 2)
+		return "No history yet";
+
+	const auto& first = series.front();
+	const auto& last = series.back();
+	const long long days = (last.time - first.time) / seconds_per_day;
+
+	std::string text;
+
+	auto add = [&](long long from, long long to, const std::string& what) {
+		if (from == unknown || to == unknown || to == from)
+			return;
+
+		if (!text.empty())
+			text += ", ";
+
+		text += (to > from ? "+" : "") + std::to_string(to - from) + what;
+	};
+
+	add(first.percentage_used, last.percentage_used, "% wear");
+	add(first.media_errors, last.media_errors, " media errors");
+	add(first.unsafe_shutdowns, last.unsafe_shutdowns, " unsafe shutdowns");
+
+	return (text.empty() ? "Stable" : text) + " in " + std::to_string(days) + (days == 1 ? " day" : " days");
+}
+
+std::string drive_health::summary(const health_info& info) {
+	std::string text;
+
+	auto add = [&](long long value, const std::string& prefix, const std::string& suffix) {
+		if (value == unknown)
+			return;
+
+		if (!text.empty())
+			text += ", ";
+
+		text += prefix + std::to_string(value) + suffix;
+	};
+
+	add(info.percentage_used, "", "% used");
+	add(info.media_errors, "", " media errors");
+	add(info.temperature, "", "C");
+	add(info.power_on_hours, "", " hours");
+	add(info.unsafe_shutdowns, "", " unsafe shutdowns");
+
+	if (info.critical_warning)
+		text = "Critical warning" + std::string(text.empty() ? "" : ", ") + text;
+
+	return text.empty() ? "Not available" : text;
+}
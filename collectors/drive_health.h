@@ -0,0 +1,162 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Drive health reader and history.
+/// </summary>
+/// <remarks>
+/// Health is read from the NVMe SMART / health information log page, or from the ATA SMART
+/// attributes on SATA drives. The parsers work on the raw 512 byte pages so they can be run
+/// against saved pages as well as live ones. A compact daily series of the key values can be
+/// kept per drive so that wear and new errors show up as a trend long before the drive's
+/// status changes.
+/// </remarks>
+class drive_health {
+public:
+	/// <summary>Value of a health field the drive does not report.</summary>
+	static const long long unknown;
+
+	/// <summary>The size of an NVMe health log page or ATA SMART attribute page, in bytes.</summary>
+	static const size_t page_size;
+
+	struct health_info {
+		/// <summary>Where the values came from, "NVMe" or "ATA".</summary>
+		std::string protocol;
+
+		/// <summary>Whether the drive reports a critical warning or a failing attribute.</summary>
+		bool critical_warning = false;
+
+		/// <summary>The estimated percentage of the rated endurance used. May exceed 100.</summary>
+		long long percentage_used = unknown;
+
+		/// <summary>The remaining spare capacity, as a percentage.</summary>
+		long long available_spare = unknown;
+
+		/// <summary>Unrecovered media and data integrity errors (reallocated and uncorrectable sectors on ATA).</summary>
+		long long media_errors = unknown;
+
+		/// <summary>The drive temperature, in degrees Celsius.</summary>
+		long long temperature = unknown;
+
+		/// <summary>Power on hours.</summary>
+		long long power_on_hours = unknown;
+
+		/// <summary>Power cycles.</summary>
+		long long power_cycles = unknown;
+
+		/// <summary>Unsafe shutdowns (power lost without a flush).</summary>
+		long long unsafe_shutdowns = unknown;
+
+		bool operator==(const health_info&) const;
+		bool operator!=(const health_info&) const;
+	};
+
+	struct health_sample {
+		/// <summary>The time of the sample, in seconds since 1970.</summary>
+		long long time = 0;
+
+		long long percentage_used = unknown;
+		long long media_errors = unknown;
+		long long temperature = unknown;
+		long long power_on_hours = unknown;
+		long long unsafe_shutdowns = unknown;
+	};
+
+	/// <summary>
+	/// Read the health of a physical disk.
+	/// </summary>
+	/// <param name="device_path">The device path, e.g. \\.\PhysicalDrive0, see disk_map.</param>
+	/// <param name="info">The health information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	/// <remarks>SATA drives and some NVMe drivers need administrator rights.</remarks>
+	static bool read(const std::string& device_path, health_info& info, std::string& error);
+
+	/// <summary>
+	/// Parse an NVMe SMART / health information log page (log identifier 02h).
+	/// </summary>
+	/// <param name="data">The log page.</param>
+	/// <param name="size">The size of the log page, at least <see cref="page_size"/>.</param>
+	/// <param name="info">The health information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool parse_nvme_health_log(const unsigned char* data, size_t size, health_info& info, std::string& error);
+
+	/// <summary>
+	/// Parse an ATA SMART READ DATA attribute page.
+	/// </summary>
+	/// <param name="data">The attribute page.</param>
+	/// <param name="size">The size of the page, at least <see cref="page_size"/>.</param>
+	/// <param name="info">The health information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	/// <remarks>
+	/// Wear is taken from the first of the vendor life attributes present (231, 233, 177 or 202),
+	/// whose normalized value counts down from 100.
+	/// </remarks>
+	static bool parse_ata_smart_attributes(const unsigned char* data, size_t size, health_info& info, std::string& error);
+
+	/// <summary>
+	/// Add a reading to a drive's daily series. A reading on the same day as the last sample
+	/// replaces it, and the oldest samples are dropped beyond a year.
+	/// </summary>
+	/// <param name="series">The series.</param>
+	/// <param name="info">The reading.</param>
+	/// <param name="time">The time of the reading, in seconds since 1970.</param>
+	static void append(std::vector<health_sample>& series, const health_info& info, long long time);
+
+	/// <summary>
+	/// Serialize a series to a compact string for the settings, e.g. "1700000000,3,0,38,5120,41;...".
+	/// </summary>
+	static std::string serialize(const std::vector<health_sample>& series);
+
+	/// <summary>
+	/// Deserialize a series from <see cref="serialize"/>. Malformed samples are skipped.
+	/// </summary>
+	static std::vector<health_sample> deserialize(const std::string& text);
+
+	/// <summary>
+	/// Check whether a series shows the drive degrading: new media errors, or wear growing by
+	/// more than a percent a month over at least 30 days of history.
+	/// </summary>
+	/// <param name="series">The series.</param>
+	static bool degrading(const std::vector<health_sample>& series);
+
+	/// <summary>
+	/// Describe the change across a series, e.g. "+2% wear, +1 media errors in 30 days".
+	/// </summary>
+	/// <param name="series">The series.</param>
+	static std::string trend(const std::vector<health_sample>& series);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "3% used, 0 media errors, 38C, 5120 hours".
+	/// </summary>
+	/// <param name="info">The health information.</param>
+	static std::string summary(const health_info& info);
+};
@@ -0,0 +1,332 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "edid.h"
+
+#include <Windows.h>
+#include <SetupAPI.h>
+#include <initguid.h>
+#include <devguid.h>
+#pragma comment(lib, "SetupAPI.lib")
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+	const size_t block_size = 128;
+	const unsigned char header[] = { 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 };
+
+	// decoded edids are tiny, but a kvm switching through many monitors should not grow the cache forever
+	const size_t max_cached = 32;
+
+	unsigned long long fnv1a(const std::vector<unsigned char>& data) {
+		unsigned long long hash = 14695981039346656037ULL;
+		for (const auto& byte : data) {
+			hash ^= byte;
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	void add_mode(edid::edid_info& info, const edid::mode& mode) {
+		if (mode.horizontal_resolution == 0 || mode.vertical_resolution == 0 || mode.refresh_rate <= 0.0)
+			return;
+
+		// the same mode is often listed in several places, keep the one with a pixel clock
+		for (auto& existing : info.modes) {
+			if (existing.horizontal_resolution == mode.horizontal_resolution &&
+				existing.vertical_resolution == mode.vertical_resolution &&
+				std::fabs(existing.refresh_rate - mode.refresh_rate) < 0.5) {
+				if (existing.pixel_clock_rate == 0)
+					existing = mode;
+
+				return;
+			}
+		}
+
+		info.modes.push_back(mode);
+	}
+
+	// 18 byte detailed timing descriptor, used by the base block and cea-861 extensions
+	void parse_detailed_timing(const unsigned char* d, edid::edid_info& info) {
+		const unsigned long long clock = (static_cast<unsigned long long>(d[0]) | (d[1] << 8)) * 10000ULL;
+
+		if (clock == 0) {
+			// display descriptor, the text fields end with a line feed
+			auto text = [&]() {
+				std::string value(reinterpret_cast<const char*>(d + 5), 13);
+				const auto end = value.find('\n');
+				if (end != std::string::npos)
+					value.resize(end);
+
+				while (!value.empty() && value.back() == ' ')
+					value.pop_back();
+
+				return value;
+			};
+
+			if (d[3] == 0xfc)
+				info.name = text();
+			else if (d[3] == 0xff)
+				info.serial_number = text();
+
+			return;
+		}
+
+		const unsigned long h_active = d[2] | ((d[4] & 0xf0) << 4);
+		const unsigned long h_blank = d[3] | ((d[4] & 0x0f) << 8);
+		const unsigned long v_active = d[5] | ((d[7] & 0xf0) << 4);
+		const unsigned long v_blank = d[6] | ((d[7] & 0x0f) << 8);
+		const unsigned long width_mm = d[12] | ((d[14] & 0xf0) << 4);
+		const unsigned long height_mm = d[13] | ((d[14] & 0x0f) << 8);
+
+		const double total = static_cast<double>(h_active + h_blank) * (v_active + v_blank);
+		if (total <= 0.0)
+			return;
+
+		edid::mode mode;
+		mode.horizontal_resolution = h_active;
+		mode.vertical_resolution = v_active;
+		mode.pixel_clock_rate = clock;
+		mode.refresh_rate = clock / total;
+		add_mode(info, mode);
+
+		// the detailed timing size is in mm, the base block's only in cm
+		if (info.width_mm == 0 || info.width_mm % 10 == 0) {
+			if (width_mm > 0 && height_mm > 0) {
+				info.width_mm = width_mm;
+				info.height_mm = height_mm;
+			}
+		}
+	}
+
+	void parse_standard_timing(const unsigned char* d, unsigned char revision, edid::edid_info& info) {
+		// 01 01 marks an unused slot
+		if ((d[0] == 0x01 && d[1] == 0x01) || d[0] == 0)
+			return;
+
+		edid::mode mode;
+		mode.horizontal_resolution = (d[0] + 31) * 8;
+		mode.refresh_rate = (d[1] & 0x3f) + 60;
+
+		switch (d[1] >> 6) {
+		case 0: mode.vertical_resolution = revision < 3 ? mode.horizontal_resolution : mode.horizontal_resolution * 10 / 16; break;
+		case 1: mode.vertical_resolution = mode.horizontal_resolution * 3 / 4; break;
+		case 2: mode.vertical_resolution = mode.horizontal_resolution * 4 / 5; break;
+		default: mode.vertical_resolution = mode.horizontal_resolution * 9 / 16; break;
+		}
+
+		add_mode(info, mode);
+	}
+
+	void parse_cea_extension(const unsigned char* block, edid::edid_info& info) {
+		// detailed timings run from the offset in byte 2 to the padding before the checksum
+		const size_t start = block[2];
+		if (start < 4)
+			return;
+
+		for (size_t offset = start; offset + 18 < block_size; offset += 18) {
+			if (block[offset] == 0 && block[offset + 1] == 0)
+				break;
+
+			parse_detailed_timing(block + offset, info);
+		}
+	}
+
+	void parse_displayid_extension(const unsigned char* block, edid::edid_info& info) {
+		// section header after the extension tag: version, bytes, product type, extension count
+		const size_t section_end = 5 + static_cast<size_t>(block[2]);
+		size_t offset = 5;
+
+		while (offset + 3 <= section_end && offset + 3 < block_size) {
+			const unsigned char tag = block[offset];
+			const size_t length = block[offset + 2];
+			const unsigned char* payload = block + offset + 3;
+
+			if (offset + 3 + length > block_size)
+				break;
+
+			// type i (10 kHz units) and type vii (1 kHz units) detailed timings, 20 bytes each
+			if (tag == 0x03 || tag == 0x22) {
+				const unsigned long long unit = tag == 0x03 ? 10000ULL : 1000ULL;
+
+				for (size_t t = 0; t + 20 <= length; t += 20) {
+					const unsigned char* d = payload + t;
+					const unsigned long long clock = ((static_cast<unsigned long long>(d[0]) | (d[1] << 8) | (d[2] << 16)) + 1) * unit;
+					const unsigned long h_active = (d[4] | (d[5] << 8)) + 1;
+					const unsigned long h_blank = (d[6] | (d[7] << 8)) + 1;
+					const unsigned long v_active = (d[12] | (d[13] << 8)) + 1;
+					const unsigned long v_blank = (d[14] | (d[15] << 8)) + 1;
+
+					edid::mode mode;
+					mode.horizontal_resolution = h_active;
+					mode.vertical_resolution = v_active;
+					mode.pixel_clock_rate = clock;
+					mode.refresh_rate = clock / (static_cast<double>(h_active + h_blank) * (v_active + v_blank));
+					add_mode(info, mode);
+				}
+			}
+
+			if (tag == 0 && length == 0)
+				break;
+
+			offset += 3 + length;
+		}
+	}
+}
+
+double edid::edid_info::diagonal_inches() const {
+	return std::sqrt(static_cast<double>(width_mm) * width_mm + static_cast<double>(height_mm) * height_mm) / 25.4;
+}
+
+bool edid::read(std::vector<std::vector<unsigned char>>& edids, std::string& error) {
+	edids.clear();
+
+	HDEVINFO devices = SetupDiGetClassDevsA(&GUID_DEVCLASS_MONITOR, nullptr, nullptr, DIGCF_PRESENT);
+
+	if (devices == INVALID_HANDLE_VALUE) {
+		error = "Enumerating monitors failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	SP_DEVINFO_DATA device = {};
+	device.cbSize = sizeof(device);
+
+	for (DWORD index = 0; SetupDiEnumDeviceInfo(devices, index, &device); index++) {
+		// windows keeps the edid it read from the monitor in the device's hardware key
+		HKEY key = SetupDiOpenDevRegKey(devices, &device, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+
+		if (key == INVALID_HANDLE_VALUE)
+			continue;
+
+		std::vector<unsigned char> data(block_size * 8);
+		DWORD size = static_cast<DWORD>(data.size());
+
+		if (RegQueryValueExA(key, "EDID", nullptr, nullptr, data.data(), &size) == ERROR_SUCCESS && size >= block_size) {
+			data.resize(size);
+			edids.push_back(data);
+		}
+
+		RegCloseKey(key);
+	}
+
+	SetupDiDestroyDeviceInfoList(devices);
+	return true;
+}
+
+bool edid::parse(const unsigned char* data, size_t size, edid_info& info, std::string& error) {
+	info = {};
+
+	if (!data || size < block_size || memcmp(data, header, sizeof(header)) != 0) {
+		error = "Not a valid EDID";
+		return false;
+	}
+
+	// three 5 bit letters, big endian
+	const unsigned short id = static_cast<unsigned short>((data[8] << 8) | data[9]);
+	info.manufacturer += static_cast<char>('A' - 1 + ((id >> 10) & 0x1f));
+	info.manufacturer += static_cast<char>('A' - 1 + ((id >> 5) & 0x1f));
+	info.manufacturer += static_cast<char>('A' - 1 + (id & 0x1f));
+
+	char product_code[8] = {};
+	snprintf(product_code, sizeof(product_code), "%04X", data[10] | (data[11] << 8));
+	info.product_code = product_code;
+
+	// image size in cm, refined by the detailed timings
+	info.width_mm = data[21] * 10UL;
+	info.height_mm = data[22] * 10UL;
+
+	// detailed timings and display descriptors come first, the first one is the preferred mode
+	for (size_t offset = 54; offset < 126; offset += 18)
+		parse_detailed_timing(data + offset, info);
+
+	for (size_t offset = 38; offset < 54; offset += 2)
+		parse_standard_timing(data + offset, data[19], info);
+
+	const size_t extensions = data[126];
+
+	for (size_t i = 1; i <= extensions && (i + 1) * block_size <= size; i++) {
+		const unsigned char* block = data + i * block_size;
+
+		if (block[0] == 0x02)
+			parse_cea_extension(block, info);
+		else if (block[0] == 0x70)
+			parse_displayid_extension(block, info);
+	}
+
+	if (info.modes.empty()) {
+		error = "EDID has no usable timings";
+		return false;
+	}
+
+	for (size_t i = 1; i < info.modes.size(); i++) {
+		const auto& mode = info.modes[i];
+		const auto& highest = info.modes[info.highest_mode];
+		const unsigned long long pixels = static_cast<unsigned long long>(mode.horizontal_resolution) * mode.vertical_resolution;
+		const unsigned long long highest_pixels = static_cast<unsigned long long>(highest.horizontal_resolution) * highest.vertical_resolution;
+
+		if (pixels > highest_pixels || (pixels == highest_pixels && mode.refresh_rate > highest.refresh_rate))
+			info.highest_mode = i;
+	}
+
+	return true;
+}
+
+bool edid::decode(const std::vector<unsigned char>& raw, edid_info& info, std::string& error) {
+	const unsigned long long hash = fnv1a(raw);
+	const auto it = _cache.find(hash);
+
+	if (it != _cache.end()) {
+		info = it->second;
+		return true;
+	}
+
+	if (!parse(raw.data(), raw.size(), info, error))
+		return false;
+
+	if (_cache.size() >= max_cached)
+		_cache.clear();
+
+	_cache[hash] = info;
+	return true;
+}
+
+std::string edid::resolution_name(unsigned long horizontal, unsigned long vertical) {
+	struct name { unsigned long horizontal, vertical; const char* text; };
+	static const name names[] = {
+		{ 640, 480, "VGA" }, { 800, 600, "SVGA" }, { 1024, 768, "XGA" }, { 1280, 720, "HD" },
+		{ 1280, 800, "WXGA" }, { 1280, 1024, "SXGA" }, { 1366, 768, "HD" }, { 1440, 900, "WXGA+" },
+		{ 1600, 900, "HD+" }, { 1680, 1050, "WSXGA+" }, { 1920, 1080, "FHD" }, { 1920, 1200, "WUXGA" },
+		{ 2560, 1080, "UW-FHD" }, { 2560, 1440, "QHD" }, { 2560, 1600, "WQXGA" }, { 3440, 1440, "UW-QHD" },
+		{ 3840, 2160, "4K UHD" }, { 5120, 2880, "5K" }, { 7680, 4320, "8K UHD" },
+	};
+
+	for (const auto& n : names)
+		if (n.horizontal == horizontal && n.vertical == vertical)
+			return n.text;
+
+	return std::string();
+}
@@ -0,0 +1,113 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// EDID reader and parser for connected monitors.
+/// </summary>
+/// <remarks>
+/// Parses the 128 byte base block (detailed and standard timings, display descriptors) and the
+/// CEA-861 and DisplayID extension blocks. Decoded results are cached by a hash of the raw
+/// EDID, so reading a monitor that has been seen before costs only the registry read.
+/// </remarks>
+class edid {
+public:
+	struct mode {
+		unsigned long horizontal_resolution = 0;
+		unsigned long vertical_resolution = 0;
+
+		/// <summary>The refresh rate, in Hz.</summary>
+		double refresh_rate = 0.0;
+
+		/// <summary>The pixel clock, in Hz. 0 for standard timings, which do not specify it.</summary>
+		unsigned long long pixel_clock_rate = 0;
+	};
+
+	struct edid_info {
+		/// <summary>The three letter PNP manufacturer id, e.g. "DEL".</summary>
+		std::string manufacturer;
+
+		/// <summary>The product code, as four hex digits, e.g. "A0B1".</summary>
+		std::string product_code;
+
+		/// <summary>The monitor name from the display descriptor, if present.</summary>
+		std::string name;
+
+		/// <summary>The serial number from the display descriptor, if present.</summary>
+		std::string serial_number;
+
+		/// <summary>The image size, in millimetres.</summary>
+		unsigned long width_mm = 0;
+		unsigned long height_mm = 0;
+
+		/// <summary>The supported modes, without duplicates.</summary>
+		std::vector<mode> modes;
+
+		/// <summary>The index in modes of the highest resolution (then refresh rate) mode.</summary>
+		size_t highest_mode = 0;
+
+		/// <summary>The diagonal size, in inches.</summary>
+		double diagonal_inches() const;
+	};
+
+	/// <summary>
+	/// Read the raw EDID of every connected monitor.
+	/// </summary>
+	/// <param name="edids">The raw EDIDs.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool read(std::vector<std::vector<unsigned char>>& edids, std::string& error);
+
+	/// <summary>
+	/// Parse a raw EDID, including any extension blocks.
+	/// </summary>
+	/// <param name="data">The raw EDID.</param>
+	/// <param name="size">The size of the EDID, a multiple of 128 bytes.</param>
+	/// <param name="info">The decoded information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool parse(const unsigned char* data, size_t size, edid_info& info, std::string& error);
+
+	/// <summary>
+	/// Decode a raw EDID, using the cached result if it has been decoded before.
+	/// </summary>
+	/// <param name="raw">The raw EDID.</param>
+	/// <param name="info">The decoded information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool decode(const std::vector<unsigned char>& raw, edid_info& info, std::string& error);
+
+	/// <summary>
+	/// Get the common name of a resolution, e.g. "FHD" for 1920x1080.
+	/// </summary>
+	static std::string resolution_name(unsigned long horizontal, unsigned long vertical);
+
+private:
+	std::unordered_map<unsigned long long, edid_info> _cache;
+};
@@ -0,0 +1,121 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "energy_accounting.h"
+
+#include <liblec/leccore/system.h>
+
+#include <algorithm>
+
+namespace {
+	// longer gaps between samples are treated as sleep and not integrated
+	const long long maximum_gap = 120;
+	const size_t minutes_per_hour = 60;
+
+	std::string energy_text(double milliwatt_hours) {
+		return liblec::leccore::round_off::to_string(milliwatt_hours / 1000.0, 1) + "Wh";
+	}
+}
+
+energy_accounting::energy_accounting() :
+	_minutes(minutes_per_hour, 0.0) {}
+
+void energy_accounting::add(long long time, bool ac, double charge_rate, int level) {
+	if (_started && time > _time) {
+		// count every change of power source
+		if (ac != _ac) {
+			if (ac)
+				_info.plugged++;
+			else
+				_info.unplugged++;
+		}
+
+		// clear the minutes of the last hour that have gone by without samples
+		const long long minute = time / 60;
+		for (long long m = _minute + 1; m <= minute && m - _minute <= static_cast<long long>(minutes_per_hour); m++)
+			_minutes[m % minutes_per_hour] = 0.0;
+
+		_minute = minute;
+
+		const long long elapsed = time - _time;
+
+		if (elapsed <= maximum_gap) {
+			// trapezoidal rule, mW over seconds into mWh
+			const double energy = (charge_rate + _charge_rate) / 2.0 * static_cast<double>(elapsed) / 3600.0;
+
+			if (energy < 0.0) {
+				_info.session_discharged -= energy;
+				_info.since_full_discharged -= energy;
+				_minutes[minute % minutes_per_hour] -= energy;
+			}
+			else
+				_info.session_charged += energy;
+
+			if (!ac && !_ac)
+				_info.session_battery_seconds += static_cast<double>(elapsed);
+		}
+	}
+	else
+		if (!_started)
+			_minute = time / 60;
+
+	// start counting afresh at every full charge
+	if (level >= 100) {
+		_info.full_charge_seen = true;
+		_info.since_full_discharged = 0.0;
+	}
+
+	_started = true;
+	_time = std::max(_time, time);
+	_ac = ac;
+	_charge_rate = charge_rate;
+}
+
+energy_accounting::accounting_info energy_accounting::get() const {
+	accounting_info info = _info;
+
+	info.hour_discharged = 0.0;
+	for (const auto& energy : _minutes)
+		info.hour_discharged += energy;
+
+	return info;
+}
+
+double energy_accounting::average_discharge(const accounting_info& info) {
+	if (info.session_battery_seconds <= 0.0)
+		return 0.0;
+
+	return info.session_discharged * 3600.0 / info.session_battery_seconds;
+}
+
+std::string energy_accounting::summary(const accounting_info& info) {
+	std::string text = energy_text(info.session_discharged) + " used";
+
+	const double average = average_discharge(info);
+	if (average > 0.0)
+		text += " (" + liblec::leccore::round_off::to_string(average / 1000.0, 1) + "W average)";
+
+	text += ", " + energy_text(info.hour_discharged) + " in the last hour";
+	return text;
+}
@@ -0,0 +1,108 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Battery energy accounting for the session.
+/// </summary>
+/// <remarks>
+/// The charge rate is integrated (trapezoidal rule) as each sample comes in, so no samples are
+/// kept. Energy drawn from the batteries and energy put into them are accounted separately,
+/// for the whole session, for the last hour (in one minute buckets) and since the last full
+/// charge. Gaps longer than a couple of minutes, e.g. sleep, are not integrated.
+/// </remarks>
+class energy_accounting {
+public:
+	struct accounting_info {
+		/// <summary>Energy drawn from the batteries this session, in mWh.</summary>
+		double session_discharged = 0.0;
+
+		/// <summary>Energy put into the batteries this session, in mWh.</summary>
+		double session_charged = 0.0;
+
+		/// <summary>Time spent on battery this session, in seconds.</summary>
+		double session_battery_seconds = 0.0;
+
+		/// <summary>Energy drawn from the batteries in the last hour, in mWh.</summary>
+		double hour_discharged = 0.0;
+
+		/// <summary>Whether the batteries have been fully charged this session.</summary>
+		bool full_charge_seen = false;
+
+		/// <summary>Energy drawn from the batteries since the last full charge, in mWh.</summary>
+		double since_full_discharged = 0.0;
+
+		/// <summary>The number of times AC power was connected this session.</summary>
+		int plugged = 0;
+
+		/// <summary>The number of times AC power was disconnected this session.</summary>
+		int unplugged = 0;
+	};
+
+	energy_accounting();
+
+	/// <summary>
+	/// Add a sample.
+	/// </summary>
+	/// <param name="time">The time of the sample, in seconds.</param>
+	/// <param name="ac">Whether the system is on AC power.</param>
+	/// <param name="charge_rate">The total charge rate of the batteries, in mW. Negative when discharging.</param>
+	/// <param name="level">The overall charge level, as a percentage, or -1 if unknown.</param>
+	void add(long long time, bool ac, double charge_rate, int level);
+
+	/// <summary>
+	/// Get the accounting so far.
+	/// </summary>
+	accounting_info get() const;
+
+	/// <summary>
+	/// Get the average power drawn from the batteries while on battery, in mW.
+	/// </summary>
+	/// <param name="info">The accounting information.</param>
+	/// <returns>The average, or 0 if the session has not been on battery.</returns>
+	static double average_discharge(const accounting_info& info);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "12.3Wh used (8.1W average), 4.2Wh in the last hour".
+	/// </summary>
+	/// <param name="info">The accounting information.</param>
+	static std::string summary(const accounting_info& info);
+
+private:
+	accounting_info _info;
+
+	// the previous sample
+	bool _started = false;
+	long long _time = 0;
+	bool _ac = false;
+	double _charge_rate = 0.0;
+
+	// energy drawn in each minute of the last hour, by minute of the hour
+	std::vector<double> _minutes;
+	long long _minute = 0;
+};
@@ -0,0 +1,284 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "energy_meter.h"
+
+#include <liblec/leccore/system.h>
+
+#include <Windows.h>
+#include <SetupAPI.h>
+#include <initguid.h>
+#include <emi.h>
+#pragma comment(lib, "SetupAPI.lib")
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+	// anything above this is a counter reset, not a reading
+	const double max_plausible_watts = 10000.0;
+
+	std::string narrow(const wchar_t* text, size_t length) {
+		std::string value;
+		for (size_t i = 0; i < length && text[i]; i++)
+			value += static_cast<char>(text[i] < 128 ? text[i] : '?');
+
+		return value;
+	}
+}
+
+struct energy_meter::meter {
+	HANDLE handle = INVALID_HANDLE_VALUE;
+	std::vector<std::string> channels;
+
+	// previous measurement of each channel
+	std::vector<EMI_CHANNEL_MEASUREMENT_DATA> previous;
+	bool primed = false;
+
+	// kept between reads so that sampling does not allocate
+	std::vector<EMI_CHANNEL_MEASUREMENT_DATA> current;
+
+	~meter() {
+		if (handle != INVALID_HANDLE_VALUE)
+			CloseHandle(handle);
+	}
+
+	bool open(const std::string& path) {
+		handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (handle == INVALID_HANDLE_VALUE)
+			return false;
+
+		EMI_VERSION version = {};
+		DWORD returned = 0;
+
+		if (!DeviceIoControl(handle, IOCTL_EMI_GET_VERSION, nullptr, 0, &version, sizeof(version), &returned, nullptr))
+			return false;
+
+		EMI_METADATA_SIZE metadata_size = {};
+
+		if (!DeviceIoControl(handle, IOCTL_EMI_GET_METADATA_SIZE, nullptr, 0, &metadata_size, sizeof(metadata_size), &returned, nullptr) ||
+			metadata_size.MetadataSize == 0)
+			return false;
+
+		std::vector<unsigned char> metadata(metadata_size.MetadataSize);
+
+		if (!DeviceIoControl(handle, IOCTL_EMI_GET_METADATA, nullptr, 0, metadata.data(),
+			static_cast<DWORD>(metadata.size()), &returned, nullptr))
+			return false;
+
+		if (version.EmiVersion == EMI_VERSION_V1) {
+			// one channel, named after the metered hardware
+			const auto v1 = reinterpret_cast<const EMI_METADATA_V1*>(metadata.data());
+			channels.push_back(narrow(v1->MeteredHardwareName, v1->MeteredHardwareNameSize / sizeof(WCHAR)));
+		}
+		else if (version.EmiVersion == EMI_VERSION_V2) {
+			const auto v2 = reinterpret_cast<const EMI_METADATA_V2*>(metadata.data());
+			const EMI_CHANNEL_V2* channel = &v2->Channels[0];
+
+			for (USHORT i = 0; i < v2->ChannelCount; i++) {
+				channels.push_back(narrow(channel->ChannelName, channel->ChannelNameSize / sizeof(WCHAR)));
+				channel = EMI_CHANNEL_V2_NEXT_CHANNEL(channel);
+			}
+		}
+		else
+			return false;
+
+		current.resize(channels.size());
+		previous.resize(channels.size());
+		return !channels.empty();
+	}
+
+	bool measure() {
+		DWORD returned = 0;
+		return DeviceIoControl(handle, IOCTL_EMI_GET_MEASUREMENT, nullptr, 0, current.data(),
+			static_cast<DWORD>(current.size() * sizeof(EMI_CHANNEL_MEASUREMENT_DATA)), &returned, nullptr) &&
+			returned >= current.size() * sizeof(EMI_CHANNEL_MEASUREMENT_DATA);
+	}
+};
+
+bool energy_meter::channel_power::operator==(const channel_power& param) const {
+	return name == param.name &&
+		domain == param.domain &&
+		watts == param.watts;
+}
+
+bool energy_meter::channel_power::operator!=(const channel_power& param) const {
+	return !operator==(param);
+}
+
+const energy_meter::channel_power* energy_meter::power_info::find(const std::string& domain) const {
+	for (const auto& channel : channels)
+		if (channel.domain == domain)
+			return &channel;
+
+	return nullptr;
+}
+
+bool energy_meter::power_info::operator==(const power_info& param) const {
+	return channels == param.channels;
+}
+
+bool energy_meter::power_info::operator!=(const power_info& param) const {
+	return !operator==(param);
+}
+
+energy_meter::energy_meter() {}
+
+energy_meter::~energy_meter() {
+	for (auto& it : _meters)
+		delete it;
+}
+
+void energy_meter::enumerate() {
+	_enumerated = true;
+
+	HDEVINFO devices = SetupDiGetClassDevsA(&GUID_DEVICE_ENERGY_METER, nullptr, nullptr,
+		DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+
+	if (devices == INVALID_HANDLE_VALUE)
+		return;
+
+	SP_DEVICE_INTERFACE_DATA device_interface = {};
+	device_interface.cbSize = sizeof(device_interface);
+
+	for (DWORD index = 0; SetupDiEnumDeviceInterfaces(devices, nullptr, &GUID_DEVICE_ENERGY_METER, index, &device_interface); index++) {
+		DWORD size = 0;
+		SetupDiGetDeviceInterfaceDetailA(devices, &device_interface, nullptr, 0, &size, nullptr);
+
+		if (size == 0)
+			continue;
+
+		std::vector<unsigned char> buffer(size);
+		auto detail = reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_A*>(buffer.data());
+		detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_A);
+
+		if (!SetupDiGetDeviceInterfaceDetailA(devices, &device_interface, detail, size, nullptr, nullptr))
+			continue;
+
+		auto new_meter = new meter();
+
+		if (new_meter->open(detail->DevicePath))
+			_meters.push_back(new_meter);
+		else
+			delete new_meter;
+	}
+
+	SetupDiDestroyDeviceInfoList(devices);
+}
+
+bool energy_meter::read(power_info& info, std::string& error) {
+	info = {};
+
+	// meters are fixed for the life of the session, look for them once
+	if (!_enumerated)
+		enumerate();
+
+	if (_meters.empty()) {
+		error = "No energy meters found";
+		return false;
+	}
+
+	for (auto& meter : _meters) {
+		if (!meter->measure())
+			continue;
+
+		for (size_t i = 0; i < meter->channels.size(); i++) {
+			channel_power channel;
+			channel.name = meter->channels[i];
+			channel.domain = domain(channel.name);
+
+			if (meter->primed) {
+				const double power = watts(meter->previous[i].AbsoluteEnergy, meter->current[i].AbsoluteEnergy,
+					meter->previous[i].AbsoluteTime, meter->current[i].AbsoluteTime);
+
+				if (power >= 0.0)
+					channel.watts = power;
+			}
+
+			info.channels.push_back(channel);
+		}
+
+		meter->previous = meter->current;
+		meter->primed = true;
+	}
+
+	// package first, the finer domains after it
+	std::stable_sort(info.channels.begin(), info.channels.end(), [](const channel_power& a, const channel_power& b) {
+		return (a.domain == "Package") > (b.domain == "Package");
+	});
+
+	return true;
+}
+
+std::string energy_meter::domain(const std::string& channel) {
+	struct rapl_domain { const char* suffix; const char* domain; };
+	static const rapl_domain domains[] = {
+		{ "_PKG", "Package" }, { "_PP0", "Cores" }, { "_PP1", "Graphics" },
+		{ "_DRAM", "DRAM" }, { "_PSYS", "Platform" },
+	};
+
+	for (const auto& d : domains) {
+		const std::string suffix = d.suffix;
+		if (channel.size() >= suffix.size() &&
+			channel.compare(channel.size() - suffix.size(), suffix.size(), suffix) == 0)
+			return d.domain;
+	}
+
+	return channel;
+}
+
+double energy_meter::watts(unsigned long long energy_before, unsigned long long energy_after,
+	unsigned long long time_before, unsigned long long time_after) {
+	if (time_after <= time_before)
+		return -1.0;
+
+	// unsigned subtraction is also correct across a wrap of the counter
+	const unsigned long long energy = energy_after - energy_before;
+	const unsigned long long time = time_after - time_before;
+
+	// picowatt-hours over 100ns units: 3.6e-9 J per pWh, 1e-7 s per unit
+	const double power = static_cast<double>(energy) * 0.036 / static_cast<double>(time);
+
+	return power <= max_plausible_watts ? power : -1.0;
+}
+
+std::string energy_meter::summary(const power_info& info) {
+	std::string text;
+
+	for (const auto& channel : info.channels) {
+		if (!text.empty())
+			text += ", ";
+
+		std::string domain = channel.domain;
+		if (domain != "DRAM")
+			for (auto& c : domain)
+				c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+
+		text += liblec::leccore::round_off::to_string(channel.watts, 1) + "W " + domain;
+	}
+
+	return text.empty() ? "Not available" : text;
+}
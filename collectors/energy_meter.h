@@ -0,0 +1,113 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Live power readings from the hardware energy counters.
+/// </summary>
+/// <remarks>
+/// Reads the Energy Meter Interface devices, which is how Windows exposes the processor's
+/// RAPL counters (package, cores, graphics, DRAM and platform). The meters are found and opened
+/// once; each read is one measurement call per meter, and power is the energy used since the
+/// previous read divided by the time between them, so the first read only primes the counters.
+/// </remarks>
+class energy_meter {
+public:
+	struct channel_power {
+		/// <summary>The channel name, e.g. "RAPL_Package0_PKG".</summary>
+		std::string name;
+
+		/// <summary>What the channel measures, e.g. "Package", "Cores" or "DRAM".</summary>
+		std::string domain;
+
+		/// <summary>The average power since the previous read, in watts.</summary>
+		double watts = 0.0;
+
+		bool operator==(const channel_power&) const;
+		bool operator!=(const channel_power&) const;
+	};
+
+	struct power_info {
+		std::vector<channel_power> channels;
+
+		/// <summary>Find the first channel of a domain.</summary>
+		/// <returns>The channel, or nullptr if there is none.</returns>
+		const channel_power* find(const std::string& domain) const;
+
+		bool operator==(const power_info&) const;
+		bool operator!=(const power_info&) const;
+	};
+
+	energy_meter();
+	~energy_meter();
+
+	/// <summary>
+	/// Read all energy meters.
+	/// </summary>
+	/// <param name="info">The power readings.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if there is at least one meter, else false.</returns>
+	bool read(power_info& info, std::string& error);
+
+	/// <summary>
+	/// Work out what a channel measures from its name.
+	/// </summary>
+	/// <param name="channel">The channel name, e.g. "RAPL_Package0_PP0".</param>
+	/// <returns>The domain, e.g. "Cores", or the channel name if it is not a known RAPL domain.</returns>
+	static std::string domain(const std::string& channel);
+
+	/// <summary>
+	/// Work out the average power between two readings of an energy counter.
+	/// </summary>
+	/// <param name="energy_before">The earlier energy reading, in picowatt-hours.</param>
+	/// <param name="energy_after">The later energy reading, in picowatt-hours.</param>
+	/// <param name="time_before">The time of the earlier reading, in 100ns units.</param>
+	/// <param name="time_after">The time of the later reading, in 100ns units.</param>
+	/// <returns>The power in watts, or a negative value if the readings cannot be used.</returns>
+	/// <remarks>
+	/// The counter may wrap around between readings. A jump no real part could draw is taken
+	/// to be a counter reset rather than a wrap.
+	/// </remarks>
+	static double watts(unsigned long long energy_before, unsigned long long energy_after,
+		unsigned long long time_before, unsigned long long time_after);
+
+	/// <summary>
+	/// Summarize the readings, e.g. "42.3W package, 30.1W cores, 2.2W DRAM".
+	/// </summary>
+	static std::string summary(const power_info& info);
+
+private:
+	struct meter;
+	std::vector<meter*> _meters;
+	bool _enumerated = false;
+
+	void enumerate();
+
+	energy_meter(const energy_meter&) = delete;
+	energy_meter& operator=(const energy_meter&) = delete;
+};
@@ -0,0 +1,443 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "hardware_counters.h"
+
+#include <Windows.h>
+#include <evntrace.h>
+#include <evntcons.h>
+#pragma comment(lib, "advapi32.lib")
+
+#include <liblec/leccore/system.h>
+
+namespace {
+	const wchar_t* session_name = L"pc_info hardware counters";
+
+	// held by the instance that owns the session, and released by windows if that instance dies
+	const wchar_t* owner_name = L"Global\\pc_info hardware counters";
+
+	// {d3c7b0a1-5e2f-4c1b-9a6e-2f4b8c1d7e90}
+	const GUID session_guid = { 0xd3c7b0a1, 0x5e2f, 0x4c1b, { 0x9a, 0x6e, 0x2f, 0x4b, 0x8c, 0x1d, 0x7e, 0x90 } };
+
+	// the kernel thread event class, whose type 36 is the context switch
+	const GUID thread_guid = { 0x3d6fa8d1, 0xfe05, 0x11d0, { 0x9d, 0xda, 0x00, 0xc0, 0x4f, 0xd7, 0xba, 0x7c } };
+	const UCHAR context_switch_type = 36;
+
+	// not declared in the sdk headers; the first mask holds the classic kernel flags
+	struct perfinfo_groupmask {
+		ULONG masks[8];
+	};
+
+	// profile source names differ between processor vendors, the first one found is used
+	const std::vector<std::vector<std::wstring>> source_names = {
+		{ L"InstructionRetired", L"TotalIssues" },
+		{ L"UnhaltedCoreCycles", L"TotalCycles" },
+		{ L"LLCMisses", L"CacheMisses", L"DcacheMisses" },
+		{ L"BranchMispredictsRetired", L"BranchMispredictions" },
+	};
+
+	std::string narrow(const std::wstring& text) {
+		std::string value;
+		for (const auto& c : text)
+			value += static_cast<char>(c < 128 ? c : '?');
+		return value;
+	}
+
+	double per_thousand(unsigned long long events, unsigned long long instructions) {
+		return instructions > 0 ? 1000.0 * static_cast<double>(events) / static_cast<double>(instructions) : 0.0;
+	}
+}
+
+const double hardware_counters::memory_bound_ipc = 1.0;
+const double hardware_counters::memory_bound_mpki = 5.0;
+
+bool hardware_counters::core_counters::operator==(const core_counters& param) const {
+	return number == param.number &&
+		instructions == param.instructions &&
+		cycles == param.cycles &&
+		ipc == param.ipc &&
+		cache_mpki == param.cache_mpki &&
+		branch_mpki == param.branch_mpki;
+}
+
+bool hardware_counters::core_counters::operator!=(const core_counters& param) const {
+	return !operator==(param);
+}
+
+bool hardware_counters::counters_info::operator==(const counters_info& param) const {
+	return cores == param.cores &&
+		cache_counter == param.cache_counter;
+}
+
+bool hardware_counters::counters_info::operator!=(const counters_info& param) const {
+	return !operator==(param);
+}
+
+hardware_counters::hardware_counters() {
+	_slots.fill(-1);
+}
+
+hardware_counters::~hardware_counters() {
+	stop();
+}
+
+bool hardware_counters::permitted(std::string& reason) {
+	HANDLE token = nullptr;
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token)) {
+		reason = "Checking for administrator rights failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	TOKEN_ELEVATION elevation = {};
+	DWORD size = 0;
+	const bool elevated = GetTokenInformation(token, TokenElevation, &elevation, sizeof(elevation), &size) &&
+		elevation.TokenIsElevated != 0;
+	CloseHandle(token);
+
+	if (!elevated)
+		reason = "Needs administrator rights";
+
+	return elevated;
+}
+
+bool hardware_counters::start(std::string& error) {
+	if (running())
+		return true;
+
+	if (!permitted(error))
+		return false;
+
+	// pick the profile sources this processor exposes
+	std::vector<unsigned char> list(64 * 1024);
+	ULONG returned = 0;
+	ULONG status = TraceQueryInformation(0, TraceProfileSourceListInfo, list.data(), static_cast<ULONG>(list.size()), &returned);
+
+	if (status != ERROR_SUCCESS) {
+		error = "Listing the processor counters failed (error " + std::to_string(status) + ")";
+		return false;
+	}
+
+	std::vector<ULONG> sources;
+	_slots.fill(-1);
+	_cache_counter.clear();
+
+	for (size_t counter = 0; counter < counters; counter++) {
+		for (const auto& name : source_names[counter]) {
+			for (size_t offset = 0; offset + sizeof(PROFILE_SOURCE_INFO) <= returned;) {
+				const auto source = reinterpret_cast<const PROFILE_SOURCE_INFO*>(list.data() + offset);
+
+				if (name == source->Description) {
+					_slots[counter] = static_cast<int>(sources.size());
+					sources.push_back(source->Source);
+
+					if (counter == cache_misses)
+						_cache_counter = narrow(name);
+					break;
+				}
+
+				if (source->NextEntryOffset == 0)
+					break;
+
+				offset += source->NextEntryOffset;
+			}
+
+			if (_slots[counter] >= 0)
+				break;
+		}
+	}
+
+	// without both of these there is nothing worth showing
+	if (_slots[instructions] < 0 || _slots[cycles] < 0) {
+		error = "The processor counters are not exposed, as is common in virtual machines";
+		return false;
+	}
+
+	_properties.assign(sizeof(EVENT_TRACE_PROPERTIES) + (wcslen(session_name) + 1) * sizeof(wchar_t), 0);
+	auto properties = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(_properties.data());
+	properties->Wnode.BufferSize = static_cast<ULONG>(_properties.size());
+	properties->Wnode.Guid = session_guid;
+	properties->Wnode.ClientContext = 1;	// query performance counter timestamps
+	properties->Wnode.Flags = WNODE_FLAG_TRACED_GUID;
+	properties->LogFileMode = EVENT_TRACE_REAL_TIME_MODE | EVENT_TRACE_SYSTEM_LOGGER_MODE;
+	properties->FlushTimer = 1;
+	properties->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+
+	// a live instance holds the owner mutex for as long as its session runs
+	_owner = CreateMutexW(nullptr, FALSE, owner_name);
+
+	if (!_owner) {
+		error = "Checking for another instance failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	if (GetLastError() == ERROR_ALREADY_EXISTS) {
+		CloseHandle(_owner);
+		_owner = nullptr;
+		error = "Already being sampled by another instance of the app";
+		return false;
+	}
+
+	TRACEHANDLE session = 0;
+	status = StartTraceW(&session, session_name, properties);
+
+	if (status == ERROR_ALREADY_EXISTS) {
+		// nobody holds the owner mutex, so the session outlived an instance that crashed
+		std::vector<unsigned char> stale(_properties.size(), 0);
+		auto stale_properties = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(stale.data());
+		stale_properties->Wnode.BufferSize = static_cast<ULONG>(stale.size());
+		stale_properties->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+		ControlTraceW(0, session_name, stale_properties, EVENT_TRACE_CONTROL_STOP);
+
+		status = StartTraceW(&session, session_name, properties);
+	}
+
+	if (status != ERROR_SUCCESS) {
+		error = status == ERROR_ACCESS_DENIED ? "Needs administrator rights" :
+			"Starting the kernel session failed (error " + std::to_string(status) + ")";
+
+		CloseHandle(_owner);
+		_owner = nullptr;
+		return false;
+	}
+
+	_session = session;
+
+	// counters first, then the event that carries them, then turn the event on
+	CLASSIC_EVENT_ID context_switch = {};
+	context_switch.EventGuid = thread_guid;
+	context_switch.Type = context_switch_type;
+
+	perfinfo_groupmask mask = {};
+	mask.masks[0] = EVENT_TRACE_FLAG_CSWITCH;
+
+	status = TraceSetInformation(session, TracePmcCounterListInfo, sources.data(), static_cast<ULONG>(sources.size() * sizeof(ULONG)));
+
+	if (status == ERROR_SUCCESS)
+		status = TraceSetInformation(session, TracePmcEventListInfo, &context_switch, sizeof(context_switch));
+
+	if (status == ERROR_SUCCESS)
+		status = TraceSetInformation(session, TraceSystemTraceEnableFlagsInfo, &mask, sizeof(mask));
+
+	if (status != ERROR_SUCCESS) {
+		error = "Configuring the processor counters failed (error " + std::to_string(status) + ")";
+		close();
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		const DWORD processors = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+		_latest.assign(processors, totals{});
+		_seen.assign(processors, false);
+		_previous.assign(processors, totals{});
+	}
+
+	EVENT_TRACE_LOGFILEW logfile = {};
+	logfile.LoggerName = const_cast<wchar_t*>(session_name);
+	logfile.ProcessTraceMode = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
+	logfile.EventRecordCallback = &hardware_counters::on_event;
+	logfile.Context = this;
+
+	_trace = OpenTraceW(&logfile);
+
+	if (_trace == INVALID_PROCESSTRACE_HANDLE) {
+		error = "Opening the kernel session failed (error " + std::to_string(GetLastError()) + ")";
+		_trace = 0;
+		close();
+		return false;
+	}
+
+	// blocks until the session is stopped
+	_consumer = std::thread([this]() {
+		TRACEHANDLE trace = _trace;
+		ProcessTrace(&trace, 1, nullptr, nullptr);
+		});
+
+	return true;
+}
+
+void hardware_counters::stop() {
+	close();
+
+	if (_consumer.joinable())
+		_consumer.join();
+
+	if (_trace) {
+		CloseTrace(_trace);
+		_trace = 0;
+	}
+}
+
+bool hardware_counters::running() {
+	return _session != 0;
+}
+
+void hardware_counters::close() {
+	if (_session == 0)
+		return;
+
+	// stopping the session ends ProcessTrace once the remaining buffers are delivered
+	auto properties = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(_properties.data());
+	properties->Wnode.BufferSize = static_cast<ULONG>(_properties.size());
+	properties->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+	ControlTraceW(_session, nullptr, properties, EVENT_TRACE_CONTROL_STOP);
+	_session = 0;
+
+	if (_owner) {
+		CloseHandle(_owner);
+		_owner = nullptr;
+	}
+}
+
+void __stdcall hardware_counters::on_event(_EVENT_RECORD* record) {
+	auto self = static_cast<hardware_counters*>(record->UserContext);
+
+	for (USHORT i = 0; i < record->ExtendedDataCount; i++) {
+		const auto& item = record->ExtendedData[i];
+
+		if (item.ExtType != EVENT_HEADER_EXT_TYPE_PMC_COUNTERS)
+			continue;
+
+		// the running totals of the core the context switch happened on
+		const auto values = reinterpret_cast<const ULONG64*>(item.DataPtr);
+		const size_t count = item.DataSize / sizeof(ULONG64);
+		const ULONG processor = GetEventProcessorIndex(record);
+
+		std::lock_guard<std::mutex> lock(self->_lock);
+
+		if (processor >= self->_latest.size())
+			return;
+
+		auto& latest = self->_latest[processor];
+		for (size_t counter = 0; counter < counters; counter++) {
+			const int slot = self->_slots[counter];
+			if (slot >= 0 && static_cast<size_t>(slot) < count)
+				latest[counter] = values[slot];
+		}
+
+		self->_seen[processor] = true;
+		return;
+	}
+}
+
+bool hardware_counters::read(counters_info& info, std::string& error) {
+	info = {};
+
+	if (!running()) {
+		error = "The hardware counters are not running";
+		return false;
+	}
+
+	std::vector<totals> latest;
+	std::vector<bool> seen;
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		latest = _latest;
+		seen = _seen;
+	}
+
+	info.cache_counter = _cache_counter;
+	unsigned long long total[counters] = {};
+
+	for (size_t processor = 0; processor < latest.size(); processor++) {
+		// a core that has not switched context yet has no totals to compare with
+		if (!seen[processor])
+			continue;
+
+		const totals previous = _previous[processor];
+		totals delta = {};
+		for (size_t counter = 0; counter < counters; counter++)
+			delta[counter] = latest[processor][counter] - previous[counter];
+
+		_previous[processor] = latest[processor];
+
+		// the first totals of a core only prime it
+		if (previous[cycles] == 0)
+			continue;
+
+		core_counters core;
+		core.number = static_cast<unsigned long>(processor);
+		core.instructions = delta[instructions];
+		core.cycles = delta[cycles];
+		core.ipc = core.cycles > 0 ? static_cast<double>(core.instructions) / static_cast<double>(core.cycles) : 0.0;
+
+		if (_slots[cache_misses] >= 0)
+			core.cache_mpki = per_thousand(delta[cache_misses], core.instructions);
+
+		if (_slots[branch_misses] >= 0)
+			core.branch_mpki = per_thousand(delta[branch_misses], core.instructions);
+
+		for (size_t counter = 0; counter < counters; counter++)
+			total[counter] += delta[counter];
+
+		info.cores.push_back(core);
+	}
+
+	if (total[cycles] > 0)
+		info.ipc = static_cast<double>(total[instructions]) / static_cast<double>(total[cycles]);
+
+	if (_slots[cache_misses] >= 0)
+		info.cache_mpki = per_thousand(total[cache_misses], total[instructions]);
+
+	if (_slots[branch_misses] >= 0)
+		info.branch_mpki = per_thousand(total[branch_misses], total[instructions]);
+
+	info.memory_bound = info.ipc > 0.0 && info.ipc < memory_bound_ipc && info.cache_mpki >= memory_bound_mpki;
+	return true;
+}
+
+std::string hardware_counters::summary(const counters_info& info) {
+	if (info.cores.empty())
+		return "Measuring ...";
+
+	std::string text = "IPC " + liblec::leccore::round_off::to_string(info.ipc, 2);
+
+	std::string misses;
+	if (info.cache_mpki >= 0.0)
+		misses += liblec::leccore::round_off::to_string(info.cache_mpki, 1) +
+		(info.cache_counter == "LLCMisses" ? " LLC" : " cache");
+
+	if (info.branch_mpki >= 0.0)
+		misses += (misses.empty() ? "" : " and ") + liblec::leccore::round_off::to_string(info.branch_mpki, 1) + " branch";
+
+	if (!misses.empty())
+		text += ", " + misses + " misses per 1k instructions";
+
+	return text + (info.memory_bound ? ", memory-bound" : ", compute-bound");
+}
+
+std::string hardware_counters::core_text(const counters_info& info) {
+	std::string text;
+
+	for (const auto& core : info.cores) {
+		text += (text.empty() ? "" : ", ") + std::to_string(core.number) + ": IPC " +
+			liblec::leccore::round_off::to_string(core.ipc, 2);
+
+		if (core.cache_mpki >= 0.0 || core.branch_mpki >= 0.0)
+			text += " (" + (core.cache_mpki >= 0.0 ? liblec::leccore::round_off::to_string(core.cache_mpki, 1) : std::string("-")) + ", " +
+			(core.branch_mpki >= 0.0 ? liblec::leccore::round_off::to_string(core.branch_mpki, 1) : std::string("-")) + ")";
+	}
+
+	return text;
+}
@@ -0,0 +1,181 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct _EVENT_RECORD;
+
+/// <summary>
+/// System-wide hardware performance counters per core: instructions per cycle, last level cache
+/// misses and branch mispredictions.
+/// </summary>
+/// <remarks>
+/// Windows reads the processor's counters on behalf of an ETW kernel session: the session is set
+/// to collect them on every context switch, and each context switch event carries the running
+/// totals of the core it happened on. A consumer thread keeps the latest totals per core, and
+/// <see cref="read"/> reports the difference from the previous read. Kernel sessions need
+/// administrator rights and the counters are often hidden by hypervisors, so the sampler is off
+/// until started and <see cref="start"/> explains why it could not be.
+/// </remarks>
+class hardware_counters {
+public:
+	/// <summary>
+	/// Below this many instructions per cycle, with at least <see cref="memory_bound_mpki"/> cache
+	/// misses per thousand instructions, the work is considered memory-bound.
+	/// </summary>
+	static const double memory_bound_ipc;
+
+	/// <summary>
+	/// The cache misses per thousand instructions above which the work is considered memory-bound.
+	/// </summary>
+	static const double memory_bound_mpki;
+
+	struct core_counters {
+		/// <summary>The logical processor number, counted across all processor groups.</summary>
+		unsigned long number = 0;
+
+		/// <summary>Instructions retired since the previous read.</summary>
+		unsigned long long instructions = 0;
+
+		/// <summary>Unhalted core cycles since the previous read.</summary>
+		unsigned long long cycles = 0;
+
+		/// <summary>Instructions per cycle.</summary>
+		double ipc = 0.0;
+
+		/// <summary>Cache misses per thousand instructions, or -1 if not available.</summary>
+		double cache_mpki = -1.0;
+
+		/// <summary>Branch mispredictions per thousand instructions, or -1 if not available.</summary>
+		double branch_mpki = -1.0;
+
+		bool operator==(const core_counters&) const;
+		bool operator!=(const core_counters&) const;
+	};
+
+	struct counters_info {
+		std::vector<core_counters> cores;
+
+		/// <summary>The counter the cache misses come from, e.g. "LLCMisses".</summary>
+		std::string cache_counter;
+
+		/// <summary>Instructions per cycle, across all cores.</summary>
+		double ipc = 0.0;
+
+		/// <summary>Cache misses per thousand instructions across all cores, or -1 if not available.</summary>
+		double cache_mpki = -1.0;
+
+		/// <summary>Branch mispredictions per thousand instructions across all cores, or -1 if not available.</summary>
+		double branch_mpki = -1.0;
+
+		/// <summary>Whether the work looks memory-bound rather than compute-bound.</summary>
+		bool memory_bound = false;
+
+		bool operator==(const counters_info&) const;
+		bool operator!=(const counters_info&) const;
+	};
+
+	hardware_counters();
+	~hardware_counters();
+
+	/// <summary>
+	/// Check whether the sampler can be started at all.
+	/// </summary>
+	/// <param name="reason">Why it cannot, e.g. "Needs administrator rights".</param>
+	/// <returns>Returns true if the process is elevated, else false.</returns>
+	static bool permitted(std::string& reason);
+
+	/// <summary>
+	/// Start the kernel session and its consumer thread.
+	/// </summary>
+	/// <remarks>
+	/// Fails if another running instance owns the session. A session left behind by an instance
+	/// that crashed is stopped and replaced.
+	/// </remarks>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool start(std::string& error);
+
+	/// <summary>
+	/// Stop the kernel session and wait for the consumer thread to exit.
+	/// </summary>
+	void stop();
+
+	/// <summary>
+	/// Check whether the sampler is running.
+	/// </summary>
+	bool running();
+
+	/// <summary>
+	/// Read the counters since the previous read.
+	/// </summary>
+	/// <param name="info">The counter information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(counters_info& info, std::string& error);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "IPC 1.62, 0.8 LLC and 3.1 branch misses per 1k instructions".
+	/// </summary>
+	static std::string summary(const counters_info& info);
+
+	/// <summary>
+	/// List every core's counters, e.g. "0: IPC 1.71 (0.6, 2.9), 1: IPC 0.42 (12.4, 1.0)".
+	/// </summary>
+	static std::string core_text(const counters_info& info);
+
+private:
+	// the counters collected on each context switch, in this order
+	enum counter { instructions, cycles, cache_misses, branch_misses, counters };
+	using totals = std::array<unsigned long long, counters>;
+
+	unsigned long long _session = 0;
+	unsigned long long _trace = 0;
+
+	// the named mutex that marks this instance as the session's owner
+	void* _owner = nullptr;
+	std::vector<unsigned char> _properties;
+	std::thread _consumer;
+	std::string _cache_counter;
+
+	// the position of each counter in the event's counter list, or -1 if not collected
+	std::array<int, counters> _slots;
+
+	std::mutex _lock;
+	std::vector<totals> _latest;
+	std::vector<bool> _seen;
+	std::vector<totals> _previous;
+
+	static void __stdcall on_event(_EVENT_RECORD* record);
+	void close();
+
+	hardware_counters(const hardware_counters&) = delete;
+	hardware_counters& operator=(const hardware_counters&) = delete;
+};
@@ -0,0 +1,307 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "interrupt_activity.h"
+
+#include <Windows.h>
+#include <winternl.h>
+#pragma comment(lib, "ntdll.lib")
+
+#include <liblec/leccore/system.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	// the full layouts, winternl.h leaves the dpc and interrupt fields opaque
+	struct processor_performance_information {
+		LARGE_INTEGER IdleTime;
+		LARGE_INTEGER KernelTime;	// includes the idle, dpc and interrupt time
+		LARGE_INTEGER UserTime;
+		LARGE_INTEGER DpcTime;
+		LARGE_INTEGER InterruptTime;
+		ULONG InterruptCount;
+	};
+
+	struct system_interrupt_information {
+		ULONG ContextSwitches;
+		ULONG DpcCount;
+		ULONG DpcRate;
+		ULONG TimeIncrement;
+		ULONG DpcBypassCount;
+		ULONG ApcBypassCount;
+	};
+
+	const ULONG system_processor_performance_information_class = 8;
+	const ULONG system_interrupt_information_class = 23;
+
+	// exported by ntdll but not declared in the sdk headers; takes the processor group as input
+	typedef NTSTATUS(NTAPI* query_ex_function)(ULONG, PVOID, ULONG, PVOID, ULONG, PULONG);
+
+	long long now_100ns() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count() / 100;
+	}
+
+	NTSTATUS query(void* query_ex, WORD group, ULONG information_class, std::vector<unsigned char>& buffer, ULONG& returned) {
+		if (query_ex) {
+			USHORT number = group;
+			return reinterpret_cast<query_ex_function>(query_ex)(information_class, &number, sizeof(number),
+				buffer.data(), static_cast<ULONG>(buffer.size()), &returned);
+		}
+
+		return NtQuerySystemInformation(static_cast<SYSTEM_INFORMATION_CLASS>(information_class),
+			buffer.data(), static_cast<ULONG>(buffer.size()), &returned);
+	}
+
+	std::string rate_text(double rate) {
+		return rate >= 1000.0 ?
+			liblec::leccore::round_off::to_string(rate / 1000.0, 1) + "k" :
+			liblec::leccore::round_off::to_string(rate, 0);
+	}
+
+	double share(const interrupt_activity::core_activity& core) {
+		return core.interrupt_time + core.dpc_time;
+	}
+}
+
+const double interrupt_activity::hot_spot_factor = 2.0;
+const double interrupt_activity::hot_spot_minimum = 1.0;
+
+bool interrupt_activity::core_activity::operator==(const core_activity& param) const {
+	return number == param.number &&
+		interrupts == param.interrupts &&
+		dpcs == param.dpcs &&
+		interrupt_time == param.interrupt_time &&
+		dpc_time == param.dpc_time &&
+		hot_spot == param.hot_spot;
+}
+
+bool interrupt_activity::core_activity::operator!=(const core_activity& param) const {
+	return !operator==(param);
+}
+
+bool interrupt_activity::activity_info::operator==(const activity_info& param) const {
+	return cores == param.cores;
+}
+
+bool interrupt_activity::activity_info::operator!=(const activity_info& param) const {
+	return !operator==(param);
+}
+
+interrupt_activity::interrupt_activity() {
+	// only needed to reach the processor groups beyond the calling thread's own
+	if (GetActiveProcessorGroupCount() > 1) {
+		HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+		if (ntdll)
+			_query_ex = reinterpret_cast<void*>(GetProcAddress(ntdll, "NtQuerySystemInformationEx"));
+	}
+}
+
+bool interrupt_activity::read(activity_info& info, std::string& error) {
+	const WORD groups = _query_ex ? GetActiveProcessorGroupCount() : 1;
+	const DWORD processors = GetActiveProcessorCount(_query_ex ? ALL_PROCESSOR_GROUPS : 0);
+
+	if (processors == 0) {
+		error = "Reading the processor count failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	if (processors != _processors)
+		resize(processors);
+
+	size_t first = 0;
+
+	for (WORD group = 0; group < groups && first < _processors; group++) {
+		ULONG returned = 0;
+
+		NTSTATUS status = query(_query_ex, group, system_processor_performance_information_class, _performance_buffer, returned);
+		const size_t count = std::min<size_t>(returned / sizeof(processor_performance_information), _processors - first);
+
+		if (status >= 0)
+			status = query(_query_ex, group, system_interrupt_information_class, _interrupt_buffer, returned);
+
+		if (status < 0) {
+			error = "Reading the interrupt counters failed (error " + std::to_string(static_cast<unsigned long>(status)) + ")";
+			return false;
+		}
+
+		gather(_performance_buffer.data(), _interrupt_buffer.data(),
+			first, std::min<size_t>(count, returned / sizeof(system_interrupt_information)));
+		first += count;
+	}
+
+	update(now_100ns(), info);
+	return true;
+}
+
+void interrupt_activity::replay(const unsigned char* performance, const unsigned char* interrupts, size_t processors,
+	long long time, activity_info& info) {
+	if (processors != _processors)
+		resize(processors);
+
+	gather(performance, interrupts, 0, processors);
+	update(time, info);
+}
+
+void interrupt_activity::resize(size_t processors) {
+	_processors = processors;
+	_current.assign(columns * processors, 0);
+	_previous.assign(columns * processors, 0);
+	_delta.assign(columns * processors, 0);
+	_previous_time = 0;
+
+	// a group never has more processors than the whole system, so these never grow
+	_performance_buffer.resize(sizeof(processor_performance_information) * processors);
+	_interrupt_buffer.resize(sizeof(system_interrupt_information) * processors);
+}
+
+void interrupt_activity::gather(const unsigned char* performance, const unsigned char* interrupts, size_t first, size_t count) {
+	const auto performance_info = reinterpret_cast<const processor_performance_information*>(performance);
+	const auto interrupt_info = reinterpret_cast<const system_interrupt_information*>(interrupts);
+
+	unsigned long long* interrupt_counts = &_current[interrupt_count * _processors + first];
+	unsigned long long* dpc_counts = &_current[dpc_count * _processors + first];
+	unsigned long long* interrupt_times = &_current[interrupt_time * _processors + first];
+	unsigned long long* dpc_times = &_current[dpc_time * _processors + first];
+	unsigned long long* total_times = &_current[total_time * _processors + first];
+
+	for (size_t i = 0; i < count; i++) {
+		interrupt_counts[i] = performance_info[i].InterruptCount;
+		dpc_counts[i] = interrupt_info[i].DpcCount;
+		interrupt_times[i] = static_cast<unsigned long long>(performance_info[i].InterruptTime.QuadPart);
+		dpc_times[i] = static_cast<unsigned long long>(performance_info[i].DpcTime.QuadPart);
+		total_times[i] = static_cast<unsigned long long>(performance_info[i].KernelTime.QuadPart + performance_info[i].UserTime.QuadPart);
+	}
+}
+
+void interrupt_activity::update(long long time, activity_info& info) {
+	info = {};
+
+	const bool primed = _previous_time > 0;
+	const double seconds = static_cast<double>(time - _previous_time) / 10000000.0;
+	_previous_time = time;
+
+	// the whole matrix in one straight loop, then the two 32-bit count columns wrap modulo 2^32
+	const size_t size = _current.size();
+	const unsigned long long* current = _current.data();
+	const unsigned long long* previous = _previous.data();
+	unsigned long long* delta = _delta.data();
+
+	for (size_t i = 0; i < size; i++)
+		delta[i] = current[i] - previous[i];
+
+	for (size_t i = 0; i < 2 * _processors; i++)
+		delta[i] &= 0xFFFFFFFFull;
+
+	_previous.swap(_current);
+
+	if (!primed || seconds <= 0.0)
+		return;
+
+	const unsigned long long* interrupt_counts = &_delta[interrupt_count * _processors];
+	const unsigned long long* dpc_counts = &_delta[dpc_count * _processors];
+	const unsigned long long* interrupt_times = &_delta[interrupt_time * _processors];
+	const unsigned long long* dpc_times = &_delta[dpc_time * _processors];
+	const unsigned long long* total_times = &_delta[total_time * _processors];
+
+	double busy = 0.0, total = 0.0;
+	info.cores.resize(_processors);
+
+	for (size_t p = 0; p < _processors; p++) {
+		auto& core = info.cores[p];
+		core.number = static_cast<unsigned long>(p);
+		core.interrupts = static_cast<double>(interrupt_counts[p]) / seconds;
+		core.dpcs = static_cast<double>(dpc_counts[p]) / seconds;
+
+		if (total_times[p] > 0) {
+			core.interrupt_time = 100.0 * static_cast<double>(interrupt_times[p]) / static_cast<double>(total_times[p]);
+			core.dpc_time = 100.0 * static_cast<double>(dpc_times[p]) / static_cast<double>(total_times[p]);
+		}
+
+		info.interrupts += core.interrupts;
+		info.dpcs += core.dpcs;
+		busy += static_cast<double>(interrupt_times[p] + dpc_times[p]);
+		total += static_cast<double>(total_times[p]);
+	}
+
+	info.time = total > 0.0 ? 100.0 * busy / total : 0.0;
+
+	// a single core has nothing to be compared with
+	if (_processors < 2)
+		return;
+
+	for (auto& core : info.cores) {
+		if (share(core) >= hot_spot_minimum && share(core) >= hot_spot_factor * info.time) {
+			core.hot_spot = true;
+			info.hot_spots.push_back(core.number);
+		}
+	}
+
+	std::sort(info.hot_spots.begin(), info.hot_spots.end(), [&](unsigned long a, unsigned long b) {
+		return share(info.cores[a]) > share(info.cores[b]);
+		});
+}
+
+std::string interrupt_activity::summary(const activity_info& info) {
+	if (info.cores.empty())
+		return "Measuring ...";
+
+	return rate_text(info.interrupts) + " interrupts/s, " + rate_text(info.dpcs) + " DPCs/s, " +
+		liblec::leccore::round_off::to_string(info.time, 1) + "% of CPU time";
+}
+
+std::string interrupt_activity::hot_spot_text(const activity_info& info) {
+	if (info.cores.empty())
+		return std::string();
+
+	if (info.hot_spots.empty())
+		return "No hot spots, the load is spread evenly";
+
+	// the busiest few are enough to tell where the load lands
+	const size_t shown = 3;
+	std::string text;
+
+	for (size_t i = 0; i < std::min(shown, info.hot_spots.size()); i++) {
+		const auto& core = info.cores[info.hot_spots[i]];
+		text += std::string(text.empty() ? "Core " : ", core ") + std::to_string(core.number) + " at " +
+			liblec::leccore::round_off::to_string(share(core), 1) + "%";
+	}
+
+	if (info.hot_spots.size() > shown)
+		text += " and " + std::to_string(info.hot_spots.size() - shown) + " more";
+
+	return text + " (average " + liblec::leccore::round_off::to_string(info.time, 1) + "%)";
+}
+
+std::string interrupt_activity::distribution_text(const activity_info& info) {
+	std::string text;
+
+	for (const auto& core : info.cores)
+		text += (text.empty() ? "" : ", ") + std::to_string(core.number) + ": " +
+		rate_text(core.interrupts + core.dpcs) + "/s " +
+		liblec::leccore::round_off::to_string(share(core), 1) + "%";
+
+	return text;
+}
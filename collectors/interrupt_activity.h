@@ -0,0 +1,148 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Interrupt and DPC activity per logical processor.
+/// </summary>
+/// <remarks>
+/// Each read is one NtQuerySystemInformation call for the per-processor interrupt counts and
+/// interrupt and DPC times, and one for the per-processor DPC counts, per processor group. The
+/// counters are gathered into a flat matrix with one contiguous column per counter, so the
+/// differences from the previous read are a single straight loop over the whole matrix. Rates
+/// are the difference between consecutive reads, so the first read only primes the counters.
+/// </remarks>
+class interrupt_activity {
+public:
+	/// <summary>
+	/// A core is a hot spot when the share of its time spent in interrupts and DPCs is at least
+	/// this many times the average across all cores ...
+	/// </summary>
+	static const double hot_spot_factor;
+
+	/// <summary>
+	/// ... and at least this percentage of its time.
+	/// </summary>
+	static const double hot_spot_minimum;
+
+	struct core_activity {
+		/// <summary>The logical processor number, counted across all processor groups.</summary>
+		unsigned long number = 0;
+
+		/// <summary>Hardware interrupts per second.</summary>
+		double interrupts = 0.0;
+
+		/// <summary>Deferred procedure calls (DPCs) per second.</summary>
+		double dpcs = 0.0;
+
+		/// <summary>The percentage of the core's time spent servicing interrupts.</summary>
+		double interrupt_time = 0.0;
+
+		/// <summary>The percentage of the core's time spent running DPCs.</summary>
+		double dpc_time = 0.0;
+
+		/// <summary>Whether the core takes a disproportionate share of the interrupt load.</summary>
+		bool hot_spot = false;
+
+		bool operator==(const core_activity&) const;
+		bool operator!=(const core_activity&) const;
+	};
+
+	struct activity_info {
+		std::vector<core_activity> cores;
+
+		/// <summary>Hardware interrupts per second, across all cores.</summary>
+		double interrupts = 0.0;
+
+		/// <summary>DPCs per second, across all cores.</summary>
+		double dpcs = 0.0;
+
+		/// <summary>The percentage of all CPU time spent in interrupts and DPCs.</summary>
+		double time = 0.0;
+
+		/// <summary>The hot spot core numbers, busiest first.</summary>
+		std::vector<unsigned long> hot_spots;
+
+		bool operator==(const activity_info&) const;
+		bool operator!=(const activity_info&) const;
+	};
+
+	interrupt_activity();
+
+	/// <summary>
+	/// Read the interrupt activity since the previous read.
+	/// </summary>
+	/// <param name="info">The interrupt activity.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(activity_info& info, std::string& error);
+
+	/// <summary>
+	/// Work out the activity from raw counters, e.g. recorded ones, instead of reading them.
+	/// </summary>
+	/// <param name="performance">The processor performance information of every logical processor, laid out as the kernel returns it.</param>
+	/// <param name="interrupts">The interrupt information of every logical processor, laid out as the kernel returns it.</param>
+	/// <param name="processors">The number of logical processors.</param>
+	/// <param name="time">The time the counters were taken, in 100ns units.</param>
+	/// <param name="info">The interrupt activity since the previous call.</param>
+	void replay(const unsigned char* performance, const unsigned char* interrupts, size_t processors,
+		long long time, activity_info& info);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "8.2k interrupts/s, 1.4k DPCs/s, 0.6% of CPU time".
+	/// </summary>
+	static std::string summary(const activity_info& info);
+
+	/// <summary>
+	/// Describe the hot spots, e.g. "Core 0 at 4.2%, 3.1x the average".
+	/// </summary>
+	static std::string hot_spot_text(const activity_info& info);
+
+	/// <summary>
+	/// List every core's interrupt and DPC rate and its share of time in them, e.g. "0: 2.1k/s 0.8%, 1: 310/s 0.1%".
+	/// </summary>
+	static std::string distribution_text(const activity_info& info);
+
+private:
+	// the counters of each logical processor, one column per counter
+	enum column { interrupt_count, dpc_count, interrupt_time, dpc_time, total_time, columns };
+
+	size_t _processors = 0;
+	std::vector<unsigned long long> _current;
+	std::vector<unsigned long long> _previous;
+	std::vector<unsigned long long> _delta;
+	long long _previous_time = 0;
+
+	std::vector<unsigned char> _performance_buffer;
+	std::vector<unsigned char> _interrupt_buffer;
+	void* _query_ex = nullptr;
+
+	void resize(size_t processors);
+	void gather(const unsigned char* performance, const unsigned char* interrupts, size_t first, size_t count);
+	void update(long long time, activity_info& info);
+};
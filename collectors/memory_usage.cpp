@@ -0,0 +1,189 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "memory_usage.h"
+
+#include <Windows.h>
+#include <Psapi.h>
+#include <Pdh.h>
+#pragma comment(lib, "Psapi.lib")
+#pragma comment(lib, "Pdh.lib")
+
+// five minutes at the default refresh interval
+const size_t memory_usage::history_size = 100;
+
+namespace {
+	// pressure thresholds; available memory and commit charge as a fraction, hard faults per second
+	const double moderate_available = 0.15, high_available = 0.05;
+	const double moderate_commit = 0.85, high_commit = 0.95;
+	const double moderate_page_reads = 50.0, high_page_reads = 250.0;
+}
+
+struct memory_usage::paging_query {
+	PDH_HQUERY query = nullptr;
+	PDH_HCOUNTER page_faults = nullptr;
+	PDH_HCOUNTER page_reads = nullptr;
+	PDH_HCOUNTER page_file_usage = nullptr;
+	bool primed = false;
+
+	paging_query() {
+		if (PdhOpenQueryA(nullptr, 0, &query) != ERROR_SUCCESS) {
+			query = nullptr;
+			return;
+		}
+
+		// english names so the counters are found on localized systems too
+		if (PdhAddEnglishCounterA(query, "\\Memory\\Page Faults/sec", 0, &page_faults) != ERROR_SUCCESS ||
+			PdhAddEnglishCounterA(query, "\\Memory\\Page Reads/sec", 0, &page_reads) != ERROR_SUCCESS) {
+			PdhCloseQuery(query);
+			query = nullptr;
+			return;
+		}
+
+		// there is no paging file instance when paging is disabled
+		if (PdhAddEnglishCounterA(query, "\\Paging File(_Total)\\% Usage", 0, &page_file_usage) != ERROR_SUCCESS)
+			page_file_usage = nullptr;
+	}
+
+	~paging_query() {
+		if (query)
+			PdhCloseQuery(query);
+	}
+
+	static double value(PDH_HCOUNTER counter) {
+		PDH_FMT_COUNTERVALUE counter_value = {};
+
+		if (!counter || PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE, nullptr, &counter_value) != ERROR_SUCCESS)
+			return 0.0;
+
+		return counter_value.doubleValue;
+	}
+};
+
+bool memory_usage::memory_info::operator==(const memory_info& param) const {
+	return total == param.total &&
+		available == param.available &&
+		used == param.used &&
+		cached == param.cached &&
+		commit_total == param.commit_total &&
+		commit_limit == param.commit_limit &&
+		page_file_total == param.page_file_total &&
+		page_file_used == param.page_file_used &&
+		page_faults == param.page_faults &&
+		page_reads == param.page_reads &&
+		pressure == param.pressure;
+}
+
+bool memory_usage::memory_info::operator!=(const memory_info& param) const {
+	return !operator==(param);
+}
+
+memory_usage::memory_usage() :
+	_paging(new paging_query()) {}
+
+memory_usage::~memory_usage() {
+	delete _paging;
+}
+
+bool memory_usage::read(memory_info& info, std::string& error) {
+	MEMORYSTATUSEX status = {};
+	status.dwLength = sizeof(status);
+
+	if (!GlobalMemoryStatusEx(&status)) {
+		error = "Reading memory status failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	PERFORMANCE_INFORMATION performance = {};
+	performance.cb = sizeof(performance);
+
+	if (!GetPerformanceInfo(&performance, sizeof(performance))) {
+		error = "Reading performance information failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	const unsigned long long page_size = performance.PageSize;
+
+	info = {};
+	info.total = status.ullTotalPhys;
+	info.available = status.ullAvailPhys;
+	info.used = status.ullTotalPhys - status.ullAvailPhys;
+	info.cached = static_cast<unsigned long long>(performance.SystemCache) * page_size;
+	info.commit_total = static_cast<unsigned long long>(performance.CommitTotal) * page_size;
+	info.commit_limit = static_cast<unsigned long long>(performance.CommitLimit) * page_size;
+
+	// the commit limit is physical memory plus the page files
+	const unsigned long long physical = static_cast<unsigned long long>(performance.PhysicalTotal) * page_size;
+	info.page_file_total = info.commit_limit > physical ? info.commit_limit - physical : 0;
+
+	if (_paging->query && PdhCollectQueryData(_paging->query) == ERROR_SUCCESS) {
+		// rates need two collections, the first one only primes them
+		if (_paging->primed) {
+			info.page_faults = paging_query::value(_paging->page_faults);
+			info.page_reads = paging_query::value(_paging->page_reads);
+		}
+
+		_paging->primed = true;
+
+		info.page_file_used = static_cast<unsigned long long>(info.page_file_total *
+			paging_query::value(_paging->page_file_usage) / 100.0);
+	}
+
+	info.pressure = pressure(info);
+
+	if (info.total > 0) {
+		_history.push_back(100.0 * info.used / info.total);
+
+		if (_history.size() > history_size)
+			_history.erase(_history.begin());
+	}
+
+	return true;
+}
+
+const std::vector<double>& memory_usage::history() const {
+	return _history;
+}
+
+memory_usage::pressure_level memory_usage::pressure(const memory_info& info) {
+	const double available = info.total > 0 ? static_cast<double>(info.available) / info.total : 1.0;
+	const double commit = info.commit_limit > 0 ? static_cast<double>(info.commit_total) / info.commit_limit : 0.0;
+
+	if (available < high_available || commit > high_commit || info.page_reads > high_page_reads)
+		return pressure_level::high;
+
+	if (available < moderate_available || commit > moderate_commit || info.page_reads > moderate_page_reads)
+		return pressure_level::moderate;
+
+	return pressure_level::low;
+}
+
+std::string memory_usage::to_string(pressure_level level) {
+	switch (level) {
+	case pressure_level::high: return "high";
+	case pressure_level::moderate: return "moderate";
+	case pressure_level::low:
+	default: return "low";
+	}
+}
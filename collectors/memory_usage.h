@@ -0,0 +1,124 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Live memory usage, paging and pressure sampler.
+/// </summary>
+/// <remarks>
+/// Usage comes from GlobalMemoryStatusEx and GetPerformanceInfo, paging rates from a PDH query
+/// that is opened once and only collected on each read, so a sample costs a few system calls.
+/// Windows has no pressure stall information, so pressure is graded from available memory,
+/// commit charge and hard page faults instead. The first read only primes the paging rates.
+/// </remarks>
+class memory_usage {
+public:
+	enum class pressure_level {
+		low,
+		moderate,
+		high,
+	};
+
+	/// <summary>
+	/// The number of samples kept in the usage history.
+	/// </summary>
+	static const size_t history_size;
+
+	struct memory_info {
+		/// <summary>The physical memory visible to Windows, in bytes.</summary>
+		unsigned long long total = 0;
+
+		/// <summary>The physical memory available without paging anything out, in bytes.</summary>
+		unsigned long long available = 0;
+
+		/// <summary>The physical memory in use, in bytes.</summary>
+		unsigned long long used = 0;
+
+		/// <summary>The physical memory holding the file cache, in bytes.</summary>
+		unsigned long long cached = 0;
+
+		/// <summary>The committed virtual memory, in bytes.</summary>
+		unsigned long long commit_total = 0;
+
+		/// <summary>The most virtual memory that can be committed, in bytes.</summary>
+		unsigned long long commit_limit = 0;
+
+		/// <summary>The size of the page files, in bytes.</summary>
+		unsigned long long page_file_total = 0;
+
+		/// <summary>The page file space in use, in bytes.</summary>
+		unsigned long long page_file_used = 0;
+
+		/// <summary>Page faults per second, soft and hard.</summary>
+		double page_faults = 0.0;
+
+		/// <summary>Hard page faults (reads from disk) per second.</summary>
+		double page_reads = 0.0;
+
+		pressure_level pressure = pressure_level::low;
+
+		bool operator==(const memory_info&) const;
+		bool operator!=(const memory_info&) const;
+	};
+
+	memory_usage();
+	~memory_usage();
+
+	/// <summary>
+	/// Sample the current memory usage and add it to the history.
+	/// </summary>
+	/// <param name="info">The memory information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(memory_info& info, std::string& error);
+
+	/// <summary>
+	/// The percentage of physical memory in use in each of the recent samples, oldest first.
+	/// </summary>
+	const std::vector<double>& history() const;
+
+	/// <summary>
+	/// Grade memory pressure.
+	/// </summary>
+	/// <param name="info">The memory information.</param>
+	/// <returns>The pressure level.</returns>
+	static pressure_level pressure(const memory_info& info);
+
+	/// <summary>
+	/// Get the name of a pressure level, e.g. "moderate".
+	/// </summary>
+	static std::string to_string(pressure_level level);
+
+private:
+	struct paging_query;
+	paging_query* _paging = nullptr;
+	std::vector<double> _history;
+
+	memory_usage(const memory_usage&) = delete;
+	memory_usage& operator=(const memory_usage&) = delete;
+};
@@ -0,0 +1,282 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "network.h"
+
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <iphlpapi.h>
+#include <netioapi.h>
+#include <liblec/leccore/system.h>
+#pragma comment(lib, "Iphlpapi.lib")
+#pragma comment(lib, "Ws2_32.lib")
+
+#include <chrono>
+
+namespace {
+	std::string narrow(const wchar_t* text) {
+		std::string value;
+		for (size_t i = 0; text && text[i]; i++)
+			value += static_cast<char>(text[i] < 128 ? text[i] : '?');
+
+		return value;
+	}
+
+	std::string type_text(unsigned long type) {
+		switch (type) {
+		case IF_TYPE_ETHERNET_CSMACD: return "Ethernet";
+		case IF_TYPE_IEEE80211: return "Wi-Fi";
+		case IF_TYPE_WWANPP:
+		case IF_TYPE_WWANPP2: return "Mobile Broadband";
+		case IF_TYPE_PPP: return "PPP";
+		default: return "Other";
+		}
+	}
+
+	std::string mac_text(const unsigned char* address, unsigned long length) {
+		std::string text;
+		char byte[4] = {};
+
+		for (unsigned long i = 0; i < length; i++) {
+			snprintf(byte, sizeof(byte), i == 0 ? "%02X" : "-%02X", address[i]);
+			text += byte;
+		}
+
+		return text;
+	}
+
+	std::string address_text(const SOCKADDR* address) {
+		char text[INET6_ADDRSTRLEN] = {};
+
+		if (address->sa_family == AF_INET)
+			inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(address)->sin_addr, text, sizeof(text));
+		else
+			if (address->sa_family == AF_INET6)
+				inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(address)->sin6_addr, text, sizeof(text));
+
+		return text;
+	}
+}
+
+bool network::adapter_info::operator==(const adapter_info& param) const {
+	return luid == param.luid &&
+		name == param.name &&
+		description == param.description &&
+		type == param.type &&
+		mac == param.mac &&
+		connected == param.connected &&
+		receive_speed == param.receive_speed &&
+		transmit_speed == param.transmit_speed &&
+		addresses == param.addresses &&
+		receive_bytes == param.receive_bytes &&
+		send_bytes == param.send_bytes &&
+		receive_packets == param.receive_packets &&
+		send_packets == param.send_packets &&
+		total_received == param.total_received &&
+		total_sent == param.total_sent;
+}
+
+bool network::adapter_info::operator!=(const adapter_info& param) const {
+	return !operator==(param);
+}
+
+size_t network::network_info::connected() const {
+	size_t count = 0;
+	for (const auto& adapter : adapters)
+		if (adapter.connected)
+			count++;
+
+	return count;
+}
+
+bool network::network_info::operator==(const network_info& param) const {
+	return adapters == param.adapters;
+}
+
+bool network::network_info::operator!=(const network_info& param) const {
+	return !operator==(param);
+}
+
+network::network() {
+	// addresses can change without the adapter or its connection state changing
+	HANDLE notification = nullptr;
+	if (NotifyUnicastIpAddressChange(AF_UNSPEC, [](PVOID context, PMIB_UNICASTIPADDRESS_ROW, MIB_NOTIFICATION_TYPE) {
+		static_cast<network*>(context)->_addresses_changed = true;
+		}, this, FALSE, &notification) == NO_ERROR)
+		_notification = notification;
+}
+
+network::~network() {
+	if (_notification)
+		CancelMibChangeNotify2(_notification);
+}
+
+bool network::read(network_info& info, std::string& error) {
+	info = {};
+
+	PMIB_IF_TABLE2 table = nullptr;
+	const DWORD result = GetIfTable2(&table);
+
+	if (result != NO_ERROR) {
+		error = "Reading the network interface table failed (error " + std::to_string(result) + ")";
+		return false;
+	}
+
+	const long long now = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+	const double seconds = _previous_time > 0 ? static_cast<double>(now - _previous_time) / 1.e6 : 0.0;
+
+	std::map<unsigned long long, counters> current;
+	std::string addresses_key;
+
+	for (ULONG i = 0; i < table->NumEntries; i++) {
+		const MIB_IF_ROW2& row = table->Table[i];
+
+		// physical adapters only, the loopback, tunnels and the lightweight filters stacked on
+		// each adapter are left out
+		if (!row.InterfaceAndOperStatusFlags.HardwareInterface ||
+			row.InterfaceAndOperStatusFlags.FilterInterface)
+			continue;
+
+		adapter_info adapter;
+		adapter.luid = row.InterfaceLuid.Value;
+		adapter.name = narrow(row.Alias);
+		adapter.description = narrow(row.Description);
+		adapter.type = type_text(row.Type);
+		adapter.mac = mac_text(row.PhysicalAddress, row.PhysicalAddressLength);
+		adapter.connected = row.OperStatus == IfOperStatusUp;
+		adapter.total_received = row.InOctets;
+		adapter.total_sent = row.OutOctets;
+
+		if (adapter.connected) {
+			adapter.receive_speed = row.ReceiveLinkSpeed;
+			adapter.transmit_speed = row.TransmitLinkSpeed;
+		}
+
+		counters sample;
+		sample.received = row.InOctets;
+		sample.sent = row.OutOctets;
+		sample.received_packets = row.InUcastPkts + row.InNUcastPkts;
+		sample.sent_packets = row.OutUcastPkts + row.OutNUcastPkts;
+
+		// counters are reset when an adapter restarts, skip that interval
+		const auto it = _previous.find(adapter.luid);
+		if (it != _previous.end() && seconds > 0.0 &&
+			sample.received >= it->second.received && sample.sent >= it->second.sent &&
+			sample.received_packets >= it->second.received_packets && sample.sent_packets >= it->second.sent_packets) {
+			adapter.receive_bytes = (sample.received - it->second.received) / seconds;
+			adapter.send_bytes = (sample.sent - it->second.sent) / seconds;
+			adapter.receive_packets = (sample.received_packets - it->second.received_packets) / seconds;
+			adapter.send_packets = (sample.sent_packets - it->second.sent_packets) / seconds;
+		}
+
+		current[adapter.luid] = sample;
+		addresses_key += std::to_string(adapter.luid) + (adapter.connected ? "+" : "-");
+		info.adapters.push_back(adapter);
+	}
+
+	FreeMibTable(table);
+
+	_previous = current;
+	_previous_time = now;
+
+	// without the notification, fall back to looking them up about once a minute
+	if (!_notification && ++_reads % 60 == 0)
+		_addresses_changed = true;
+
+	// look the addresses up again only when they may have changed
+	if (addresses_key != _addresses_key || _addresses_changed.exchange(false)) {
+		read_addresses();
+		_addresses_key = addresses_key;
+	}
+
+	for (auto& adapter : info.adapters) {
+		const auto it = _addresses.find(adapter.luid);
+		if (it != _addresses.end())
+			adapter.addresses = it->second;
+	}
+
+	return true;
+}
+
+void network::read_addresses() {
+	_addresses.clear();
+
+	const ULONG flags = GAA_FLAG_SKIP_ANYCAST | GAA_FLAG_SKIP_MULTICAST | GAA_FLAG_SKIP_DNS_SERVER;
+	ULONG size = 16 * 1024;
+	std::vector<unsigned char> buffer;
+	ULONG result = ERROR_BUFFER_OVERFLOW;
+
+	// the list can grow between the two calls, try a few times
+	for (int attempt = 0; attempt < 3 && result == ERROR_BUFFER_OVERFLOW; attempt++) {
+		buffer.resize(size);
+		result = GetAdaptersAddresses(AF_UNSPEC, flags, nullptr,
+			reinterpret_cast<PIP_ADAPTER_ADDRESSES>(buffer.data()), &size);
+	}
+
+	if (result != NO_ERROR)
+		return;
+
+	for (auto adapter = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(buffer.data()); adapter; adapter = adapter->Next) {
+		auto& addresses = _addresses[adapter->Luid.Value];
+
+		for (auto address = adapter->FirstUnicastAddress; address; address = address->Next) {
+			const std::string text = address_text(address->Address.lpSockaddr);
+			if (!text.empty())
+				addresses.push_back(text);
+		}
+	}
+}
+
+bool network::same_adapters(const network_info& a, const network_info& b) {
+	if (a.adapters.size() != b.adapters.size())
+		return false;
+
+	for (size_t i = 0; i < a.adapters.size(); i++)
+		if (a.adapters[i].luid != b.adapters[i].luid)
+			return false;
+
+	return true;
+}
+
+std::string network::speed_text(unsigned long long bits_per_second) {
+	if (bits_per_second == 0)
+		return "Not connected";
+
+	if (bits_per_second >= 1000000000ULL)
+		return liblec::leccore::round_off::to_string(bits_per_second / 1.e9, 1) + " Gbps";
+
+	if (bits_per_second >= 1000000ULL)
+		return liblec::leccore::round_off::to_string(bits_per_second / 1.e6, 1) + " Mbps";
+
+	return liblec::leccore::round_off::to_string(bits_per_second / 1.e3, 0) + " Kbps";
+}
+
+std::string network::summary(const network_info& info) {
+	if (info.adapters.empty())
+		return "No network adapters";
+
+	return std::to_string(info.connected()) + " of " + std::to_string(info.adapters.size()) +
+		(info.adapters.size() == 1 ? " adapter connected" : " adapters connected");
+}
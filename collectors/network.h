@@ -0,0 +1,159 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Network adapter details and live throughput.
+/// </summary>
+/// <remarks>
+/// Each read is a single GetIfTable2 call, which returns the status, link speed and traffic
+/// counters of every interface at once; rates are the difference between consecutive reads,
+/// so the first read of an interface only primes its counters. Addresses come from
+/// GetAdaptersAddresses, which is slower, so they are only looked up again when an adapter
+/// comes, goes or changes its connection state, or when the system reports a unicast address
+/// change (DHCP renewals, rotating IPv6 temporary addresses). Only hardware adapters are listed,
+/// not the loopback, tunnel and filter interfaces.
+/// </remarks>
+class network {
+public:
+	struct adapter_info {
+		/// <summary>The interface LUID, which identifies the adapter for the session.</summary>
+		unsigned long long luid = 0;
+
+		/// <summary>The connection name, e.g. "Wi-Fi".</summary>
+		std::string name;
+
+		/// <summary>The adapter description, e.g. "Intel(R) Wi-Fi 6 AX201 160MHz".</summary>
+		std::string description;
+
+		/// <summary>The kind of adapter, e.g. "Ethernet", "Wi-Fi" or "Mobile Broadband".</summary>
+		std::string type;
+
+		/// <summary>The MAC address, e.g. "3C-58-C2-11-22-33".</summary>
+		std::string mac;
+
+		/// <summary>Whether the adapter is connected.</summary>
+		bool connected = false;
+
+		/// <summary>The receive link speed, in bits per second.</summary>
+		unsigned long long receive_speed = 0;
+
+		/// <summary>The transmit link speed, in bits per second.</summary>
+		unsigned long long transmit_speed = 0;
+
+		/// <summary>The unicast IPv4 and IPv6 addresses.</summary>
+		std::vector<std::string> addresses;
+
+		/// <summary>Bytes received per second.</summary>
+		double receive_bytes = 0.0;
+
+		/// <summary>Bytes sent per second.</summary>
+		double send_bytes = 0.0;
+
+		/// <summary>Packets received per second.</summary>
+		double receive_packets = 0.0;
+
+		/// <summary>Packets sent per second.</summary>
+		double send_packets = 0.0;
+
+		/// <summary>Bytes received since the adapter started.</summary>
+		unsigned long long total_received = 0;
+
+		/// <summary>Bytes sent since the adapter started.</summary>
+		unsigned long long total_sent = 0;
+
+		bool operator==(const adapter_info&) const;
+		bool operator!=(const adapter_info&) const;
+	};
+
+	struct network_info {
+		std::vector<adapter_info> adapters;
+
+		/// <summary>The number of connected adapters.</summary>
+		size_t connected() const;
+
+		bool operator==(const network_info&) const;
+		bool operator!=(const network_info&) const;
+	};
+
+	network();
+	~network();
+
+	/// <summary>
+	/// Read the adapters and their traffic since the previous read.
+	/// </summary>
+	/// <param name="info">The network information.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool read(network_info& info, std::string& error);
+
+	/// <summary>
+	/// Check whether the same adapters are listed, in the same order.
+	/// </summary>
+	/// <remarks>Used to tell when the adapter tabs need to be rebuilt.</remarks>
+	static bool same_adapters(const network_info& a, const network_info& b);
+
+	/// <summary>
+	/// Format a link speed, e.g. "866.7 Mbps" or "1 Gbps".
+	/// </summary>
+	/// <param name="bits_per_second">The speed, in bits per second.</param>
+	static std::string speed_text(unsigned long long bits_per_second);
+
+	/// <summary>
+	/// Get a one line summary, e.g. "1 of 2 adapters connected".
+	/// </summary>
+	static std::string summary(const network_info& info);
+
+private:
+	struct counters {
+		unsigned long long received = 0;
+		unsigned long long sent = 0;
+		unsigned long long received_packets = 0;
+		unsigned long long sent_packets = 0;
+	};
+
+	// the previous read, by interface luid
+	std::map<unsigned long long, counters> _previous;
+	long long _previous_time = 0;
+
+	// addresses by interface luid, and the adapters and states they were looked up for
+	std::map<unsigned long long, std::vector<std::string>> _addresses;
+	std::string _addresses_key;
+
+	// set by the address change notification, which arrives on a system thread
+	std::atomic<bool> _addresses_changed = true;
+	void* _notification = nullptr;
+	size_t _reads = 0;
+
+	void read_addresses();
+
+	network(const network&) = delete;
+	network& operator=(const network&) = delete;
+};
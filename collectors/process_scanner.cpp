@@ -0,0 +1,192 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "process_scanner.h"
+
+#include <Windows.h>
+#include <winternl.h>
+#pragma comment(lib, "ntdll.lib")
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	// the full layout of SYSTEM_PROCESS_INFORMATION, winternl.h leaves the cpu times opaque
+	struct system_process_information {
+		ULONG NextEntryOffset;
+		ULONG NumberOfThreads;
+		LARGE_INTEGER WorkingSetPrivateSize;
+		ULONG HardFaultCount;
+		ULONG NumberOfThreadsHighWatermark;
+		ULONGLONG CycleTime;
+		LARGE_INTEGER CreateTime;
+		LARGE_INTEGER UserTime;
+		LARGE_INTEGER KernelTime;
+		UNICODE_STRING ImageName;
+		LONG BasePriority;
+		HANDLE UniqueProcessId;
+		HANDLE InheritedFromUniqueProcessId;
+		ULONG HandleCount;
+		ULONG SessionId;
+		ULONG_PTR UniqueProcessKey;
+		SIZE_T PeakVirtualSize;
+		SIZE_T VirtualSize;
+		ULONG PageFaultCount;
+		SIZE_T PeakWorkingSetSize;
+		SIZE_T WorkingSetSize;
+		SIZE_T QuotaPeakPagedPoolUsage;
+		SIZE_T QuotaPagedPoolUsage;
+		SIZE_T QuotaPeakNonPagedPoolUsage;
+		SIZE_T QuotaNonPagedPoolUsage;
+		SIZE_T PagefileUsage;
+		SIZE_T PeakPagefileUsage;
+		SIZE_T PrivatePageCount;
+		LARGE_INTEGER IoCounters[6];
+	};
+
+	const ULONG system_process_information_class = 5;
+	const NTSTATUS status_info_length_mismatch = static_cast<NTSTATUS>(0xC0000004L);
+
+	// the process list rarely grows much between scans, leave room so it seldom needs a retry
+	const size_t initial_buffer_size = 512 * 1024;
+
+	long long now_100ns() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count() / 100;
+	}
+
+	std::string narrow(const UNICODE_STRING& text) {
+		std::string value;
+		const size_t length = text.Buffer ? text.Length / sizeof(WCHAR) : 0;
+		value.reserve(length);
+
+		for (size_t i = 0; i < length; i++)
+			value += static_cast<char>(text.Buffer[i] < 128 ? text.Buffer[i] : '?');
+
+		return value;
+	}
+}
+
+process_scanner::process_scanner() {
+	// cpu time is counted across all processor groups
+	const DWORD processors = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	_processors = processors > 0 ? processors : 1;
+}
+
+bool process_scanner::scan(size_t top, scan_info& info, std::string& error) {
+	const auto start = std::chrono::steady_clock::now();
+
+	if (_buffer.empty())
+		_buffer.resize(initial_buffer_size);
+
+	ULONG needed = 0;
+	NTSTATUS status = 0;
+
+	for (int attempt = 0; attempt < 4; attempt++) {
+		status = NtQuerySystemInformation(static_cast<SYSTEM_INFORMATION_CLASS>(system_process_information_class),
+			_buffer.data(), static_cast<ULONG>(_buffer.size()), &needed);
+
+		if (status != status_info_length_mismatch)
+			break;
+
+		// processes may start between calls, grow with some headroom
+		_buffer.resize(std::max<size_t>(needed, _buffer.size()) + _buffer.size() / 4);
+	}
+
+	if (status < 0) {
+		error = "Reading the process list failed (error " + std::to_string(static_cast<unsigned long>(status)) + ")";
+		return false;
+	}
+
+	replay(_buffer.data(), std::min<size_t>(needed ? needed : _buffer.size(), _buffer.size()), now_100ns(), top, info);
+	info.scan_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+void process_scanner::replay(const unsigned char* data, size_t size, long long time, size_t top, scan_info& info) {
+	_generation++;
+	_processes.clear();
+	info = {};
+
+	const double elapsed = _previous_time > 0 ? static_cast<double>(time - _previous_time) * _processors : 0.0;
+	_previous_time = time;
+
+	for (size_t offset = 0; offset + sizeof(system_process_information) <= size;) {
+		const auto process = reinterpret_cast<const system_process_information*>(data + offset);
+		const unsigned long pid = static_cast<unsigned long>(reinterpret_cast<ULONG_PTR>(process->UniqueProcessId));
+		const long long cpu_time = process->KernelTime.QuadPart + process->UserTime.QuadPart;
+
+		info.processes++;
+		info.threads += process->NumberOfThreads;
+
+		// the idle process is not a process, leave it out
+		if (pid != 0) {
+			auto& entry = _cache[pid];
+			process_info value;
+			value.pid = pid;
+
+			if (entry.generation == 0 || entry.create_time != process->CreateTime.QuadPart) {
+				// new process, or the id has been reused; the name is the only field worth caching
+				entry.create_time = process->CreateTime.QuadPart;
+				entry.name = narrow(process->ImageName);
+			}
+			else
+				if (elapsed > 0.0 && cpu_time >= entry.cpu_time)
+					value.cpu = 100.0 * static_cast<double>(cpu_time - entry.cpu_time) / elapsed;
+
+			entry.cpu_time = cpu_time;
+			entry.generation = _generation;
+
+			value.name = entry.name;
+			value.working_set = process->WorkingSetSize;
+			value.private_bytes = process->PrivatePageCount;
+			value.threads = process->NumberOfThreads;
+			_processes.push_back(std::move(value));
+		}
+
+		if (process->NextEntryOffset == 0)
+			break;
+
+		offset += process->NextEntryOffset;
+	}
+
+	// forget the processes that have exited
+	for (auto it = _cache.begin(); it != _cache.end();) {
+		if (it->second.generation != _generation)
+			it = _cache.erase(it);
+		else
+			it++;
+	}
+
+	// only the top few are sorted
+	const size_t count = std::min(top, _processes.size());
+
+	info.top_cpu.resize(count);
+	std::partial_sort_copy(_processes.begin(), _processes.end(), info.top_cpu.begin(), info.top_cpu.end(),
+		[](const process_info& a, const process_info& b) { return a.cpu > b.cpu; });
+
+	info.top_memory.resize(count);
+	std::partial_sort_copy(_processes.begin(), _processes.end(), info.top_memory.begin(), info.top_memory.end(),
+		[](const process_info& a, const process_info& b) { return a.working_set > b.working_set; });
+}
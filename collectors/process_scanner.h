@@ -0,0 +1,116 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Lightweight process table, the top processes by CPU and by memory.
+/// </summary>
+/// <remarks>
+/// A scan is one NtQuerySystemInformation call, which returns every process with its CPU
+/// times and memory counters in a single buffer. The buffer and the process list are kept
+/// and reused between scans. Names are only converted the first time a process is seen; after
+/// that, a per-process cache keyed on the process ID and creation time supplies the name and
+/// the previous CPU time, so a repeated scan does little more than walk the buffer. CPU usage
+/// is the CPU time used since the previous scan, so the first scan only primes it.
+/// </remarks>
+class process_scanner {
+public:
+	struct process_info {
+		/// <summary>The process ID.</summary>
+		unsigned long pid = 0;
+
+		/// <summary>The image name, e.g. "explorer.exe".</summary>
+		std::string name;
+
+		/// <summary>CPU usage since the previous scan, as a percentage of all logical processors.</summary>
+		double cpu = 0.0;
+
+		/// <summary>The working set (resident memory), in bytes.</summary>
+		unsigned long long working_set = 0;
+
+		/// <summary>The private (committed) memory, in bytes.</summary>
+		unsigned long long private_bytes = 0;
+
+		/// <summary>The number of threads.</summary>
+		unsigned long threads = 0;
+	};
+
+	struct scan_info {
+		/// <summary>The busiest processes, busiest first.</summary>
+		std::vector<process_info> top_cpu;
+
+		/// <summary>The processes with the largest working sets, largest first.</summary>
+		std::vector<process_info> top_memory;
+
+		/// <summary>The number of processes.</summary>
+		size_t processes = 0;
+
+		/// <summary>The number of threads across all processes.</summary>
+		size_t threads = 0;
+
+		/// <summary>How long the scan took, in milliseconds.</summary>
+		double scan_time = 0.0;
+	};
+
+	process_scanner();
+
+	/// <summary>
+	/// Scan the processes.
+	/// </summary>
+	/// <param name="top">How many processes to list by CPU and by memory.</param>
+	/// <param name="info">The scan results.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	bool scan(size_t top, scan_info& info, std::string& error);
+
+	/// <summary>
+	/// Work out the top processes from a process table, e.g. a recorded one, instead of reading it.
+	/// </summary>
+	/// <param name="data">The process table, laid out as the kernel returns it.</param>
+	/// <param name="size">The size of the table, in bytes.</param>
+	/// <param name="time">The time the table was taken, in 100ns units.</param>
+	/// <param name="top">How many processes to list by CPU and by memory.</param>
+	/// <param name="info">The scan results; the scan time is left at 0.</param>
+	void replay(const unsigned char* data, size_t size, long long time, size_t top, scan_info& info);
+
+private:
+	struct cache_entry {
+		long long create_time = 0;
+		long long cpu_time = 0;
+		std::string name;
+		unsigned long long generation = 0;
+	};
+
+	std::vector<unsigned char> _buffer;
+	std::vector<process_info> _processes;
+	std::unordered_map<unsigned long, cache_entry> _cache;
+	unsigned long long _generation = 0;
+	long long _previous_time = 0;
+	unsigned long _processors = 1;
+};
@@ -0,0 +1,170 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "resource_limits.h"
+
+#include <liblec/leccore/system.h>
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <bitset>
+
+bool resource_limits::limits_info::cpu_limited() const {
+	return effective_processors > 0.0 && effective_processors < processors;
+}
+
+bool resource_limits::limits_info::memory_limited() const {
+	return memory_limit > 0;
+}
+
+bool resource_limits::read(limits_info& info, std::string& error) {
+	info = {};
+	info.processors = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	info.allowed_processors = info.processors;
+
+	if (info.processors == 0) {
+		error = "Reading the processor count failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	// windows containers mark themselves in the registry
+	DWORD container_type = 0, size = sizeof(container_type);
+	info.in_container = RegGetValueA(HKEY_LOCAL_MACHINE, "SYSTEM\\CurrentControlSet\\Control",
+		"ContainerType", RRF_RT_REG_DWORD, nullptr, &container_type, &size) == ERROR_SUCCESS;
+
+	// the process affinity only covers one processor group, it is only meaningful when there is one
+	USHORT group_count = 0;
+	GetProcessGroupAffinity(GetCurrentProcess(), &group_count, nullptr);
+
+	if (group_count <= 1) {
+		DWORD_PTR process_mask = 0, system_mask = 0;
+
+		if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) && process_mask != 0)
+			info.allowed_processors = static_cast<unsigned long>(std::bitset<64>(process_mask).count());
+	}
+
+	BOOL in_job = FALSE;
+	if (!IsProcessInJob(GetCurrentProcess(), nullptr, &in_job)) {
+		error = "Checking for a job object failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	info.in_job = in_job == TRUE;
+
+	if (info.in_job) {
+		// a null handle queries the job this process is in
+		JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+
+		if (QueryInformationJobObject(nullptr, JobObjectExtendedLimitInformation, &limits, sizeof(limits), nullptr)) {
+			const auto flags = limits.BasicLimitInformation.LimitFlags;
+
+			if (flags & JOB_OBJECT_LIMIT_JOB_MEMORY)
+				info.memory_limit = limits.JobMemoryLimit;
+
+			if ((flags & JOB_OBJECT_LIMIT_PROCESS_MEMORY) &&
+				(info.memory_limit == 0 || limits.ProcessMemoryLimit < info.memory_limit))
+				info.memory_limit = limits.ProcessMemoryLimit;
+
+			if ((flags & JOB_OBJECT_LIMIT_AFFINITY) && group_count <= 1)
+				info.allowed_processors = std::min(info.allowed_processors,
+					static_cast<unsigned long>(std::bitset<64>(limits.BasicLimitInformation.Affinity).count()));
+		}
+
+		JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rate = {};
+
+		if (QueryInformationJobObject(nullptr, JobObjectCpuRateControlInformation, &rate, sizeof(rate), nullptr) &&
+			(rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE)) {
+			// rates are in hundredths of a percent, weights are relative and not a cap
+			if (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP)
+				info.cpu_rate = rate.CpuRate / 100.0;
+			else if (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_MIN_MAX_RATE)
+				info.cpu_rate = rate.MaxRate / 100.0;
+		}
+	}
+
+	info.effective_processors = effective_processors(info.allowed_processors, info.processors, info.cpu_rate);
+	return true;
+}
+
+double resource_limits::effective_processors(unsigned long allowed_processors,
+	unsigned long processors, double cpu_rate) {
+	double effective = static_cast<double>(allowed_processors);
+
+	// the rate cap is a share of the whole system, not of the allowed processors
+	if (cpu_rate > 0.0 && cpu_rate < 100.0)
+		effective = std::min(effective, processors * cpu_rate / 100.0);
+
+	return effective;
+}
+
+std::string resource_limits::cpu_summary(const limits_info& info) {
+	std::string text;
+
+	if (!info.cpu_limited())
+		text = "Not limited";
+	else {
+		text = liblec::leccore::round_off::to_string(info.effective_processors, 1) + " of " +
+			std::to_string(info.processors) + " logical processors";
+
+		std::string reasons;
+
+		if (info.allowed_processors < info.processors)
+			reasons += std::to_string(info.allowed_processors) + " allowed";
+
+		if (info.cpu_rate > 0.0 && info.cpu_rate < 100.0) {
+			if (!reasons.empty())
+				reasons += ", ";
+
+			reasons += liblec::leccore::round_off::to_string(info.cpu_rate, 1) + "% cap";
+		}
+
+		text += " (" + reasons + ")";
+	}
+
+	if (info.in_container)
+		text += ", in a container";
+
+	return text;
+}
+
+std::string resource_limits::memory_summary(const limits_info& info, unsigned long long installed) {
+	std::string text;
+
+	if (!info.memory_limited())
+		text = "Not limited";
+	else {
+		text = liblec::leccore::format_size(std::min(info.memory_limit, installed > 0 ? installed : info.memory_limit));
+
+		if (installed > 0)
+			text += " of " + liblec::leccore::format_size(installed);
+
+		text += " (job limit)";
+	}
+
+	if (info.in_container)
+		text += ", in a container";
+
+	return text;
+}
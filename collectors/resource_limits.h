@@ -0,0 +1,93 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// Effective cpu and memory limits imposed on this process.
+/// </summary>
+/// <remarks>
+/// Windows containers and most resource managers confine processes with job objects, so the
+/// limits are read from the job this process runs in: the cpu rate cap, the processor affinity
+/// and the job or per-process memory limit. Physical hardware is reported elsewhere; these are
+/// the share of it that is actually usable from here.
+/// </remarks>
+class resource_limits {
+public:
+	struct limits_info {
+		/// <summary>Whether this process runs in a job object.</summary>
+		bool in_job = false;
+
+		/// <summary>Whether this process runs in a Windows container.</summary>
+		bool in_container = false;
+
+		/// <summary>The number of logical processors in the system.</summary>
+		unsigned long processors = 0;
+
+		/// <summary>The number of logical processors this process may run on.</summary>
+		unsigned long allowed_processors = 0;
+
+		/// <summary>The hard cpu rate cap, as a percentage of the whole system. 0 if there is none.</summary>
+		double cpu_rate = 0.0;
+
+		/// <summary>The number of processors' worth of cpu time available, after the affinity and rate cap.</summary>
+		double effective_processors = 0.0;
+
+		/// <summary>The committed memory limit of the job or process, in bytes. 0 if there is none.</summary>
+		unsigned long long memory_limit = 0;
+
+		bool cpu_limited() const;
+		bool memory_limited() const;
+	};
+
+	/// <summary>
+	/// Read the limits that apply to this process.
+	/// </summary>
+	/// <param name="info">The limits.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool read(limits_info& info, std::string& error);
+
+	/// <summary>
+	/// Work out the processors' worth of cpu time available.
+	/// </summary>
+	/// <param name="allowed_processors">The processors this process may run on.</param>
+	/// <param name="processors">The processors in the system.</param>
+	/// <param name="cpu_rate">The cpu rate cap as a percentage of the system, 0 if there is none.</param>
+	/// <returns>The effective number of processors.</returns>
+	static double effective_processors(unsigned long allowed_processors,
+		unsigned long processors, double cpu_rate);
+
+	/// <summary>
+	/// Summarize the cpu limits, e.g. "2.5 of 16 logical processors (25% cap)".
+	/// </summary>
+	static std::string cpu_summary(const limits_info& info);
+
+	/// <summary>
+	/// Summarize the memory limit against the installed memory, e.g. "4GB of 16GB (job limit)".
+	/// </summary>
+	static std::string memory_summary(const limits_info& info, unsigned long long installed);
+};
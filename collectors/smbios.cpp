@@ -0,0 +1,321 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "smbios.h"
+
+#include <Windows.h>
+
+namespace {
+	// the header GetSystemFirmwareTable puts before the structure table
+	const size_t raw_header_size = 8;
+
+	enum structure_type : unsigned char {
+		type_bios = 0,
+		type_system = 1,
+		type_board = 2,
+		type_memory_device = 17,
+		type_end = 127,
+	};
+
+	unsigned short word_at(const unsigned char* p) {
+		return static_cast<unsigned short>(p[0] | (p[1] << 8));
+	}
+
+	unsigned long dword_at(const unsigned char* p) {
+		return static_cast<unsigned long>(p[0]) | (static_cast<unsigned long>(p[1]) << 8) |
+			(static_cast<unsigned long>(p[2]) << 16) | (static_cast<unsigned long>(p[3]) << 24);
+	}
+
+	std::string_view trim(std::string_view text) {
+		while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+			text.remove_prefix(1);
+
+		while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+			text.remove_suffix(1);
+
+		return text;
+	}
+
+	// one structure: the formatted area followed by its string set
+	class structure {
+	public:
+		const unsigned char* data = nullptr;
+		unsigned char length = 0;
+		std::vector<std::string_view>* strings = nullptr;
+
+		unsigned char byte(size_t offset) const {
+			return offset < length ? data[offset] : 0;
+		}
+
+		unsigned short word(size_t offset) const {
+			return offset + 2 <= length ? word_at(data + offset) : 0;
+		}
+
+		unsigned long dword(size_t offset) const {
+			return offset + 4 <= length ? dword_at(data + offset) : 0;
+		}
+
+		// strings are numbered from 1, 0 means none
+		std::string_view string(size_t offset) const {
+			const unsigned char index = byte(offset);
+			return index > 0 && index <= strings->size() ? (*strings)[index - 1] : std::string_view();
+		}
+	};
+
+	void decode_memory_device(const structure& s, smbios::memory_device& device) {
+		device.form_factor = s.byte(0x0e);
+		device.locator = s.string(0x10);
+		device.bank = s.string(0x11);
+		device.type = s.byte(0x12);
+		device.manufacturer = s.string(0x17);
+		device.serial_number = s.string(0x18);
+		device.part_number = s.string(0x1a);
+
+		// 0x7fff means the size is in the extended size field, in MB; bit 15 set means KB units
+		const unsigned short size = s.word(0x0c);
+
+		if (size == 0 || size == 0xffff)
+			device.size = 0;
+		else if (size == 0x7fff)
+			device.size = static_cast<unsigned long long>(s.dword(0x1c) & 0x7fffffff) * 1024 * 1024;
+		else if (size & 0x8000)
+			device.size = static_cast<unsigned long long>(size & 0x7fff) * 1024;
+		else
+			device.size = static_cast<unsigned long long>(size) * 1024 * 1024;
+
+		// 0xffff means the speed is in the extended speed fields (smbios 3.3)
+		const unsigned short speed = s.word(0x15);
+		device.speed = speed == 0xffff ? s.dword(0x54) : speed;
+
+		const unsigned short configured_speed = s.word(0x20);
+		device.configured_speed = configured_speed == 0xffff ? s.dword(0x58) : configured_speed;
+	}
+}
+
+bool smbios::read(std::vector<unsigned char>& table, std::string& error) {
+	const DWORD signature = 'RSMB';
+	const UINT size = GetSystemFirmwareTable(signature, 0, nullptr, 0);
+
+	if (size == 0) {
+		error = "Reading the SMBIOS table failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	table.resize(size);
+
+	if (GetSystemFirmwareTable(signature, 0, table.data(), size) != size) {
+		error = "Reading the SMBIOS table failed (error " + std::to_string(GetLastError()) + ")";
+		return false;
+	}
+
+	return true;
+}
+
+bool smbios::parse_raw(const std::vector<unsigned char>& table, smbios_info& info, std::string& error) {
+	if (table.size() < raw_header_size) {
+		error = "SMBIOS table is too short";
+		return false;
+	}
+
+	const size_t length = dword_at(table.data() + 4);
+	const size_t available = table.size() - raw_header_size;
+
+	if (!parse(table.data() + raw_header_size, length < available ? length : available, info, error))
+		return false;
+
+	info.major_version = table[1];
+	info.minor_version = table[2];
+	return true;
+}
+
+bool smbios::parse(const unsigned char* data, size_t size, smbios_info& info, std::string& error) {
+	info = {};
+
+	if (!data || size < 4) {
+		error = "SMBIOS table is too short";
+		return false;
+	}
+
+	std::vector<std::string_view> strings;
+	size_t offset = 0;
+	bool found = false;
+
+	while (offset + 4 <= size) {
+		structure s;
+		s.data = data + offset;
+		s.length = data[offset + 1];
+		s.strings = &strings;
+
+		const unsigned char type = data[offset];
+
+		if (s.length < 4 || offset + s.length > size)
+			break;
+
+		// the string set follows the formatted area and ends with a double null, or is just
+		// the double null if the structure has no strings
+		strings.clear();
+		size_t position = offset + s.length;
+		size_t next = 0;
+
+		if (position + 1 < size && data[position] == 0 && data[position + 1] == 0)
+			next = position + 2;
+		else {
+			while (position < size && data[position] != 0) {
+				const char* start = reinterpret_cast<const char*>(data + position);
+				size_t length = 0;
+				while (position + length < size && data[position + length] != 0)
+					length++;
+
+				strings.push_back(trim(std::string_view(start, length)));
+				position += length + 1;
+			}
+
+			if (position >= size)
+				break;
+
+			next = position + 1;
+		}
+
+		switch (type) {
+		case type_bios:
+			info.bios.vendor = s.string(0x04);
+			info.bios.version = s.string(0x05);
+			info.bios.release_date = s.string(0x08);
+			found = true;
+			break;
+
+		case type_system:
+			info.system.manufacturer = s.string(0x04);
+			info.system.product = s.string(0x05);
+			info.system.serial_number = s.string(0x07);
+			info.system.sku = s.string(0x19);
+			info.system.family = s.string(0x1a);
+			found = true;
+			break;
+
+		case type_board:
+			// the first board is the motherboard, later ones are add-in boards
+			if (info.board.manufacturer.empty() && info.board.product.empty()) {
+				info.board.manufacturer = s.string(0x04);
+				info.board.product = s.string(0x05);
+				info.board.serial_number = s.string(0x07);
+			}
+
+			found = true;
+			break;
+
+		case type_memory_device: {
+			memory_device device;
+			decode_memory_device(s, device);
+			info.memory_devices.push_back(device);
+			found = true;
+		} break;
+
+		default:
+			break;
+		}
+
+		offset = next;
+
+		if (type == type_end)
+			break;
+	}
+
+	if (!found) {
+		error = "No usable SMBIOS structures found";
+		return false;
+	}
+
+	return true;
+}
+
+std::string smbios::computer_name() {
+	char name[MAX_COMPUTERNAME_LENGTH + 1] = {};
+	DWORD size = sizeof(name);
+
+	if (!GetComputerNameA(name, &size))
+		return std::string();
+
+	return std::string(name, size);
+}
+
+std::string smbios::system_type() {
+	SYSTEM_INFO info = {};
+	GetNativeSystemInfo(&info);
+
+	switch (info.wProcessorArchitecture) {
+	case PROCESSOR_ARCHITECTURE_AMD64: return "x64-based PC";
+	case PROCESSOR_ARCHITECTURE_ARM64: return "ARM64-based PC";
+	case PROCESSOR_ARCHITECTURE_INTEL: return "X86-based PC";
+	default: return "Unknown";
+	}
+}
+
+std::string smbios::memory_type(unsigned char type) {
+	switch (type) {
+	case 0x03: return "DRAM";
+	case 0x04: return "EDRAM";
+	case 0x05: return "VRAM";
+	case 0x06: return "SRAM";
+	case 0x07: return "RAM";
+	case 0x08: return "ROM";
+	case 0x09: return "Flash";
+	case 0x0f: return "SDRAM";
+	case 0x12: return "DDR";
+	case 0x13: return "DDR2";
+	case 0x14: return "DDR2 FB-DIMM";
+	case 0x18: return "DDR3";
+	case 0x1a: return "DDR4";
+	case 0x1b: return "LPDDR";
+	case 0x1c: return "LPDDR2";
+	case 0x1d: return "LPDDR3";
+	case 0x1e: return "LPDDR4";
+	case 0x20: return "HBM";
+	case 0x21: return "HBM2";
+	case 0x22: return "DDR5";
+	case 0x23: return "LPDDR5";
+	case 0x24: return "HBM3";
+	default: return "Unknown";
+	}
+}
+
+std::string smbios::form_factor(unsigned char form_factor) {
+	switch (form_factor) {
+	case 0x03: return "SIMM";
+	case 0x04: return "SIP";
+	case 0x05: return "Chip";
+	case 0x06: return "DIP";
+	case 0x07: return "ZIP";
+	case 0x08: return "Proprietary Card";
+	case 0x09: return "DIMM";
+	case 0x0a: return "TSOP";
+	case 0x0b: return "Row of chips";
+	case 0x0c: return "RIMM";
+	case 0x0d: return "SODIMM";
+	case 0x0e: return "SRIMM";
+	case 0x0f: return "FB-DIMM";
+	case 0x10: return "Die";
+	default: return "Unknown";
+	}
+}
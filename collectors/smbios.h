@@ -0,0 +1,146 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// Raw SMBIOS (DMI) table reader and parser.
+/// </summary>
+/// <remarks>
+/// The whole table is fetched from the firmware in one call and parsed in a single pass without
+/// copying: the strings in the results are views into the table, so the table must outlive
+/// them. Only the structures needed for the system, board, BIOS and memory details are decoded
+/// (types 0, 1, 2 and 17).
+/// </remarks>
+class smbios {
+public:
+	struct bios_info {
+		std::string_view vendor;
+		std::string_view version;
+		std::string_view release_date;
+	};
+
+	struct system_info {
+		std::string_view manufacturer;
+		std::string_view product;
+		std::string_view serial_number;
+		std::string_view sku;
+		std::string_view family;
+	};
+
+	struct board_info {
+		std::string_view manufacturer;
+		std::string_view product;
+		std::string_view serial_number;
+	};
+
+	struct memory_device {
+		/// <summary>The slot, e.g. "DIMM A1".</summary>
+		std::string_view locator;
+		std::string_view bank;
+		std::string_view manufacturer;
+		std::string_view serial_number;
+		std::string_view part_number;
+
+		/// <summary>The size, in bytes. 0 if the slot is empty.</summary>
+		unsigned long long size = 0;
+
+		/// <summary>The SMBIOS memory type code, see <see cref="memory_type"/>.</summary>
+		unsigned char type = 0;
+
+		/// <summary>The SMBIOS form factor code, see <see cref="form_factor"/>.</summary>
+		unsigned char form_factor = 0;
+
+		/// <summary>The maximum speed, in MT/s. 0 if unknown.</summary>
+		unsigned long speed = 0;
+
+		/// <summary>The configured speed, in MT/s. 0 if unknown.</summary>
+		unsigned long configured_speed = 0;
+	};
+
+	struct smbios_info {
+		unsigned char major_version = 0;
+		unsigned char minor_version = 0;
+		bios_info bios;
+		system_info system;
+		board_info board;
+
+		/// <summary>All memory device structures, including empty slots.</summary>
+		std::vector<memory_device> memory_devices;
+	};
+
+	/// <summary>
+	/// Read the raw SMBIOS table from the firmware.
+	/// </summary>
+	/// <param name="table">The raw table, including the 8 byte header Windows puts in front of it.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool read(std::vector<unsigned char>& table, std::string& error);
+
+	/// <summary>
+	/// Parse a raw table as returned by <see cref="read"/>.
+	/// </summary>
+	/// <param name="table">The raw table.</param>
+	/// <param name="info">The decoded information, with views into the table.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	static bool parse_raw(const std::vector<unsigned char>& table, smbios_info& info, std::string& error);
+
+	/// <summary>
+	/// Parse the SMBIOS structure table, e.g. the contents of a DMI table dump.
+	/// </summary>
+	/// <param name="data">The structure table.</param>
+	/// <param name="size">The size of the structure table, in bytes.</param>
+	/// <param name="info">The decoded information, with views into data.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if successful, else false.</returns>
+	/// <remarks>Structures that run past the end of the table are ignored.</remarks>
+	static bool parse(const unsigned char* data, size_t size, smbios_info& info, std::string& error);
+
+	/// <summary>
+	/// Get the computer's NetBIOS name.
+	/// </summary>
+	/// <remarks>Not part of the table, read here so the pc details need no management query.</remarks>
+	static std::string computer_name();
+
+	/// <summary>
+	/// Get the system type in the form the management queries use, e.g. "x64-based PC".
+	/// </summary>
+	/// <remarks>Not part of the table, read here so the pc details need no management query.</remarks>
+	static std::string system_type();
+
+	/// <summary>
+	/// Get the name of a memory type code, e.g. "DDR4".
+	/// </summary>
+	static std::string memory_type(unsigned char type);
+
+	/// <summary>
+	/// Get the name of a memory form factor code, e.g. "SODIMM".
+	/// </summary>
+	static std::string form_factor(unsigned char form_factor);
+};
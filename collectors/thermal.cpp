@@ -0,0 +1,359 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "thermal.h"
+
+#include <Windows.h>
+#include <winioctl.h>
+#include <Pdh.h>
+#include <WbemIdl.h>
+#pragma comment(lib, "Pdh.lib")
+#pragma comment(lib, "wbemuuid.lib")
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <thread>
+
+namespace {
+	const double kelvin_offset = 273.15;
+
+	std::string narrow(const wchar_t* text) {
+		std::string value;
+		for (; text && *text; text++)
+			value += static_cast<char>(*text < 128 ? *text : '?');
+
+		return value;
+	}
+
+	std::string to_celsius_string(double temperature) {
+		return std::to_string(static_cast<long>(std::lround(temperature))) + "C";
+	}
+
+	class device_handle {
+	public:
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		~device_handle() {
+			if (handle != INVALID_HANDLE_VALUE)
+				CloseHandle(handle);
+		}
+	};
+
+	bool read_drive_temperature(const disk_map::disk& disk, thermal::sensor& sensor) {
+		// the temperature property needs no access rights
+		device_handle device;
+		device.handle = CreateFileA(disk.path.c_str(), 0,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+
+		if (device.handle == INVALID_HANDLE_VALUE)
+			return false;
+
+		STORAGE_PROPERTY_QUERY query = {};
+		query.PropertyId = StorageDeviceTemperatureProperty;
+		query.QueryType = PropertyStandardQuery;
+
+		// room for a handful of sensors, the first one is the composite temperature
+		unsigned char buffer[sizeof(STORAGE_TEMPERATURE_DATA_DESCRIPTOR) + 8 * sizeof(STORAGE_TEMPERATURE_INFO)] = {};
+		DWORD returned = 0;
+
+		if (!DeviceIoControl(device.handle, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query),
+			buffer, sizeof(buffer), &returned, nullptr) || returned < sizeof(STORAGE_TEMPERATURE_DATA_DESCRIPTOR))
+			return false;
+
+		const auto descriptor = reinterpret_cast<const STORAGE_TEMPERATURE_DATA_DESCRIPTOR*>(buffer);
+		if (descriptor->InfoCount == 0)
+			return false;
+
+		const auto& temperature = descriptor->TemperatureInfo[0];
+
+		sensor.name = disk.model;
+		sensor.group = thermal::sensor_group::drive;
+		sensor.temperature = temperature.Temperature;
+		sensor.critical = descriptor->CriticalTemperature > 0 ?
+			descriptor->CriticalTemperature : std::max<short>(temperature.OverThreshold, 0);
+		return true;
+	}
+}
+
+struct thermal::zone_query {
+	PDH_HQUERY query = nullptr;
+	PDH_HCOUNTER temperature = nullptr;
+
+	// high precision readings are in tenths of a kelvin, the older counter in whole kelvin
+	double scale = 0.1;
+
+	// kept between reads so that sampling does not allocate
+	std::vector<unsigned char> buffer;
+
+	zone_query() {
+		if (PdhOpenQueryA(nullptr, 0, &query) != ERROR_SUCCESS) {
+			query = nullptr;
+			return;
+		}
+
+		if (PdhAddEnglishCounterA(query, "\\Thermal Zone Information(*)\\High Precision Temperature", 0, &temperature) != ERROR_SUCCESS) {
+			scale = 1.0;
+
+			if (PdhAddEnglishCounterA(query, "\\Thermal Zone Information(*)\\Temperature", 0, &temperature) != ERROR_SUCCESS) {
+				PdhCloseQuery(query);
+				query = nullptr;
+			}
+		}
+	}
+
+	~zone_query() {
+		if (query)
+			PdhCloseQuery(query);
+	}
+};
+
+bool thermal::sensor::critical_reached() const {
+	return critical > 0.0 && temperature >= critical;
+}
+
+bool thermal::sensor::operator==(const sensor& param) const {
+	return name == param.name &&
+		group == param.group &&
+		temperature == param.temperature &&
+		critical == param.critical;
+}
+
+bool thermal::sensor::operator!=(const sensor& param) const {
+	return !operator==(param);
+}
+
+const thermal::sensor* thermal::thermal_info::hottest() const {
+	const sensor* hottest = nullptr;
+
+	for (const auto& sensor : sensors)
+		if (!hottest || sensor.temperature > hottest->temperature)
+			hottest = &sensor;
+
+	return hottest;
+}
+
+size_t thermal::thermal_info::critical_sensors() const {
+	return static_cast<size_t>(std::count_if(sensors.begin(), sensors.end(),
+		[](const sensor& sensor) { return sensor.critical_reached(); }));
+}
+
+bool thermal::thermal_info::operator==(const thermal_info& param) const {
+	return sensors == param.sensors;
+}
+
+bool thermal::thermal_info::operator!=(const thermal_info& param) const {
+	return !operator==(param);
+}
+
+thermal::thermal() :
+	_zones(new zone_query()) {}
+
+thermal::~thermal() {
+	delete _zones;
+}
+
+bool thermal::read(const std::vector<disk_map::disk>& disks, thermal_info& info, std::string& error) {
+	info = {};
+
+	if (!_trip_points_read)
+		read_trip_points();
+
+	// all thermal zones come back from one collection
+	if (_zones->query && PdhCollectQueryData(_zones->query) == ERROR_SUCCESS) {
+		DWORD size = static_cast<DWORD>(_zones->buffer.size()), count = 0;
+		auto items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(_zones->buffer.data());
+
+		PDH_STATUS status = PdhGetFormattedCounterArrayA(_zones->temperature, PDH_FMT_DOUBLE, &size, &count, items);
+
+		if (status == PDH_MORE_DATA) {
+			_zones->buffer.resize(size);
+			items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(_zones->buffer.data());
+			status = PdhGetFormattedCounterArrayA(_zones->temperature, PDH_FMT_DOUBLE, &size, &count, items);
+		}
+
+		if (status == ERROR_SUCCESS) {
+			for (DWORD i = 0; i < count; i++) {
+				const double kelvin = items[i].FmtValue.doubleValue * _zones->scale;
+
+				// zones without a sensor read as absolute zero
+				if (kelvin <= 0.0)
+					continue;
+
+				sensor zone;
+				zone.name = zone_name(items[i].szName ? items[i].szName : "");
+				zone.group = classify(zone.name);
+				zone.temperature = kelvin - kelvin_offset;
+
+				const auto trip_point = _trip_points.find(zone.name);
+				if (trip_point != _trip_points.end())
+					zone.critical = trip_point->second;
+
+				info.sensors.push_back(zone);
+			}
+		}
+	}
+
+	for (const auto& disk : disks) {
+		sensor drive;
+		if (read_drive_temperature(disk, drive))
+			info.sensors.push_back(drive);
+	}
+
+	if (info.sensors.empty()) {
+		error = "No temperature sensors found";
+		return false;
+	}
+
+	// cpu first, then drives, then the board
+	std::stable_sort(info.sensors.begin(), info.sensors.end(),
+		[](const sensor& a, const sensor& b) { return a.group < b.group; });
+
+	return true;
+}
+
+void thermal::read_trip_points() {
+	_trip_points_read = true;
+
+	const HRESULT initialized = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+
+	IWbemLocator* locator = nullptr;
+	IWbemServices* services = nullptr;
+	IEnumWbemClassObject* enumerator = nullptr;
+
+	if (SUCCEEDED(CoCreateInstance(CLSID_WbemLocator, nullptr, CLSCTX_INPROC_SERVER, IID_IWbemLocator,
+		reinterpret_cast<void**>(&locator)))) {
+		BSTR resource = SysAllocString(L"ROOT\\WMI");
+
+		if (SUCCEEDED(locator->ConnectServer(resource, nullptr, nullptr, nullptr, 0, nullptr, nullptr, &services))) {
+			CoSetProxyBlanket(services, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, nullptr,
+				RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, nullptr, EOAC_NONE);
+
+			BSTR language = SysAllocString(L"WQL");
+			BSTR query = SysAllocString(L"SELECT InstanceName, CriticalTripPoint FROM MSAcpi_ThermalZoneTemperature");
+
+			// access is denied unless running as administrator, there are simply no trip points then
+			if (SUCCEEDED(services->ExecQuery(language, query, WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+				nullptr, &enumerator))) {
+				IWbemClassObject* object = nullptr;
+				ULONG returned = 0;
+
+				while (enumerator->Next(WBEM_INFINITE, 1, &object, &returned) == S_OK && returned == 1) {
+					VARIANT name, trip_point;
+					VariantInit(&name);
+					VariantInit(&trip_point);
+
+					if (SUCCEEDED(object->Get(L"InstanceName", 0, &name, nullptr, nullptr)) && name.vt == VT_BSTR &&
+						SUCCEEDED(object->Get(L"CriticalTripPoint", 0, &trip_point, nullptr, nullptr)) &&
+						(trip_point.vt == VT_I4 || trip_point.vt == VT_UI4) && trip_point.ulVal > 0) {
+						// tenths of a kelvin
+						_trip_points[zone_name(narrow(name.bstrVal))] = trip_point.ulVal / 10.0 - kelvin_offset;
+					}
+
+					VariantClear(&name);
+					VariantClear(&trip_point);
+					object->Release();
+				}
+
+				enumerator->Release();
+			}
+
+			SysFreeString(query);
+			SysFreeString(language);
+			services->Release();
+		}
+
+		SysFreeString(resource);
+		locator->Release();
+	}
+
+	if (SUCCEEDED(initialized))
+		CoUninitialize();
+}
+
+thermal::sensor_group thermal::classify(const std::string& zone) {
+	std::string name = zone;
+	for (auto& c : name)
+		c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+
+	for (const char* hint : { "CPU", "PROC", "PKG", "CORE" })
+		if (name.find(hint) != std::string::npos)
+			return sensor_group::cpu;
+
+	return sensor_group::board;
+}
+
+std::string thermal::zone_name(std::string instance) {
+	auto pos = instance.find_last_of(".\\");
+	if (pos != std::string::npos)
+		instance = instance.substr(pos + 1);
+
+	pos = instance.find('_');
+	if (pos != std::string::npos && pos > 0)
+		instance = instance.substr(0, pos);
+
+	for (auto& c : instance)
+		c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+
+	return instance;
+}
+
+std::string thermal::to_string(sensor_group group) {
+	switch (group) {
+	case sensor_group::cpu: return "CPU";
+	case sensor_group::drive: return "Drives";
+	case sensor_group::board:
+	default: return "Board";
+	}
+}
+
+std::string thermal::to_string(const sensor& sensor) {
+	std::string text = to_celsius_string(sensor.temperature);
+
+	if (sensor.critical > 0.0)
+		text += " (critical " + to_celsius_string(sensor.critical) + ")";
+
+	return text;
+}
+
+std::string thermal::summary(const thermal_info& info) {
+	const auto hottest = info.hottest();
+
+	if (!hottest)
+		return "No sensors";
+
+	std::string text = to_celsius_string(hottest->temperature) + " hottest, " +
+		std::to_string(info.sensors.size()) + (info.sensors.size() == 1 ? " sensor" : " sensors");
+
+	const auto critical = info.critical_sensors();
+	if (critical > 0)
+		text += ", " + std::to_string(critical) + " critical";
+
+	return text;
+}
+
+void thermal::alert(const std::string& caption, const std::string& text) {
+	std::thread([caption, text]() {
+		MessageBoxA(nullptr, text.c_str(), caption.c_str(), MB_OK | MB_ICONWARNING | MB_TOPMOST | MB_SETFOREGROUND);
+	}).detach();
+}
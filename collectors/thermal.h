@@ -0,0 +1,144 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "disk_map.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Temperature sensor reader.
+/// </summary>
+/// <remarks>
+/// Reads the ACPI thermal zones through a PDH query that is opened once, so all zones come back
+/// from a single collection, and the drives' own temperature sensors through the storage driver.
+/// Critical trip points of the thermal zones are static and only read once, from WMI; they are
+/// only available when running as administrator. Sensors are grouped by what they measure.
+/// </remarks>
+class thermal {
+public:
+	enum class sensor_group {
+		cpu,
+		drive,
+		board,
+	};
+
+	struct sensor {
+		/// <summary>The sensor name, the thermal zone or the drive model.</summary>
+		std::string name;
+
+		sensor_group group = sensor_group::board;
+
+		/// <summary>The temperature, in degrees Celsius.</summary>
+		double temperature = 0.0;
+
+		/// <summary>The critical trip point, in degrees Celsius. 0 if it is not known.</summary>
+		double critical = 0.0;
+
+		/// <summary>Whether the temperature has reached the critical trip point.</summary>
+		bool critical_reached() const;
+
+		bool operator==(const sensor&) const;
+		bool operator!=(const sensor&) const;
+	};
+
+	struct thermal_info {
+		std::vector<sensor> sensors;
+
+		/// <summary>The hottest sensor, or nullptr if there are none.</summary>
+		const sensor* hottest() const;
+
+		/// <summary>The number of sensors at or above their critical trip point.</summary>
+		size_t critical_sensors() const;
+
+		bool operator==(const thermal_info&) const;
+		bool operator!=(const thermal_info&) const;
+	};
+
+	thermal();
+	~thermal();
+
+	/// <summary>
+	/// Read all sensors in one pass.
+	/// </summary>
+	/// <param name="disks">The disks whose temperature to read, see disk_map.</param>
+	/// <param name="info">The sensor readings.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if at least one sensor was read, else false.</returns>
+	bool read(const std::vector<disk_map::disk>& disks, thermal_info& info, std::string& error);
+
+	/// <summary>
+	/// Work out what a thermal zone measures from its ACPI name.
+	/// </summary>
+	/// <param name="zone">The zone name, e.g. "CPUZ".</param>
+	/// <returns>The sensor group; zones that do not name the processor count as board sensors.</returns>
+	static sensor_group classify(const std::string& zone);
+
+	/// <summary>
+	/// Get the zone name from a performance counter or WMI instance name, so readings and trip
+	/// points of the same zone can be matched.
+	/// </summary>
+	/// <param name="instance">The instance name, e.g. "\_TZ.CPUZ" or "ACPI\ThermalZone\CPUZ_0".</param>
+	/// <returns>The upper case zone name, e.g. "CPUZ".</returns>
+	static std::string zone_name(std::string instance);
+
+	/// <summary>
+	/// Get the name of a sensor group, e.g. "CPU".
+	/// </summary>
+	static std::string to_string(sensor_group group);
+
+	/// <summary>
+	/// Format a sensor reading, e.g. "52C (critical 95C)".
+	/// </summary>
+	static std::string to_string(const sensor& sensor);
+
+	/// <summary>
+	/// Summarize the readings, e.g. "52C hottest, 6 sensors".
+	/// </summary>
+	static std::string summary(const thermal_info& info);
+
+	/// <summary>
+	/// Show an alert without blocking the caller. The message box is topmost and runs on a
+	/// thread of its own, so it shows even while the app is in the tray and reading goes on.
+	/// </summary>
+	/// <param name="caption">The caption, e.g. the app name.</param>
+	/// <param name="text">The alert.</param>
+	static void alert(const std::string& caption, const std::string& text);
+
+private:
+	struct zone_query;
+	zone_query* _zones = nullptr;
+
+	// critical trip points by zone name, read once
+	std::map<std::string, double> _trip_points;
+	bool _trip_points_read = false;
+
+	void read_trip_points();
+
+	thermal(const thermal&) = delete;
+	thermal& operator=(const thermal&) = delete;
+};
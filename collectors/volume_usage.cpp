@@ -0,0 +1,220 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "volume_usage.h"
+
+#include <Windows.h>
+
+#include <chrono>
+#include <deque>
+
+namespace {
+	// re-measure at least this often, some changes (e.g. shadow copies) raise no notification
+	const double fallback_interval = 60.0;
+
+	// removable volumes are polled instead, more often since they have no notification
+	const double removable_interval = 10.0;
+
+	// fill rate is estimated from this much history, keeping at most one sample per spacing
+	const double history_window = 3600.0;
+	const double sample_spacing = 10.0;
+
+	// too short a history makes for wild estimates
+	const double minimum_history = 120.0;
+
+	struct sample {
+		double time = 0.0;	// seconds
+		double used = 0.0;	// bytes
+	};
+
+	// least squares slope of used space over time
+	double slope(const std::deque<sample>& samples) {
+		if (samples.size() < 2 || samples.back().time - samples.front().time < minimum_history)
+			return 0.0;
+
+		double mean_time = 0.0, mean_used = 0.0;
+		for (const auto& s : samples) {
+			mean_time += s.time;
+			mean_used += s.used;
+		}
+
+		mean_time /= samples.size();
+		mean_used /= samples.size();
+
+		double covariance = 0.0, variance = 0.0;
+		for (const auto& s : samples) {
+			covariance += (s.time - mean_time) * (s.used - mean_used);
+			variance += (s.time - mean_time) * (s.time - mean_time);
+		}
+
+		return variance > 0.0 ? covariance / variance : 0.0;
+	}
+}
+
+struct volume_usage::volume_state {
+	HANDLE notification = INVALID_HANDLE_VALUE;
+	bool removable = false;
+	volume_info info;
+	std::deque<sample> history;
+	double last_read = -1.0;
+
+	~volume_state() {
+		if (notification != INVALID_HANDLE_VALUE)
+			FindCloseChangeNotification(notification);
+	}
+};
+
+bool volume_usage::volume_info::operator==(const volume_info& param) const {
+	return root == param.root &&
+		label == param.label &&
+		file_system == param.file_system &&
+		total == param.total &&
+		free == param.free &&
+		fill_rate == param.fill_rate &&
+		time_to_full == param.time_to_full;
+}
+
+bool volume_usage::volume_info::operator!=(const volume_info& param) const {
+	return !operator==(param);
+}
+
+volume_usage::volume_usage() {}
+
+volume_usage::~volume_usage() {
+	for (auto& it : _volumes)
+		delete it.second;
+}
+
+bool volume_usage::read(const std::vector<disk_map::disk>& disks, std::vector<volume_info>& volumes, std::string& error) {
+	volumes.clear();
+
+	// the root of each volume and whether its disk can be ejected
+	std::vector<std::pair<std::string, bool>> roots;
+	for (const auto& disk : disks)
+		for (const auto& volume : disk.volumes)
+			roots.push_back({ volume, disk.removable });
+
+	// stop tracking volumes that have gone
+	for (auto it = _volumes.begin(); it != _volumes.end();) {
+		bool listed = false;
+		for (const auto& root : roots)
+			listed = listed || root.first == it->first;
+
+		if (!listed) {
+			delete it->second;
+			it = _volumes.erase(it);
+		}
+		else
+			it++;
+	}
+
+	static const auto epoch = std::chrono::steady_clock::now();
+	const double now = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+	bool success = true;
+
+	for (const auto& it : roots) {
+		const std::string& root = it.first;
+		auto& state = _volumes[root];
+
+		if (!state) {
+			state = new volume_state();
+			state->info.root = root;
+
+			// file creation, deletion and size changes anywhere on the volume; the notification
+			// holds a handle on the volume that would block ejecting removable drives, which
+			// go by the disk's bus since usb hard drives report DRIVE_FIXED
+			state->removable = it.second || GetDriveTypeA(root.c_str()) == DRIVE_REMOVABLE;
+
+			if (!state->removable)
+				state->notification = FindFirstChangeNotificationA(root.c_str(), TRUE,
+					FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE);
+
+			char label[MAX_PATH + 1] = {};
+			char file_system[MAX_PATH + 1] = {};
+
+			if (GetVolumeInformationA(root.c_str(), label, MAX_PATH, nullptr, nullptr, nullptr, file_system, MAX_PATH)) {
+				state->info.label = label;
+				state->info.file_system = file_system;
+			}
+		}
+
+		bool changed = state->last_read < 0.0 ||
+			now - state->last_read >= (state->removable ? removable_interval : fallback_interval);
+
+		if (state->notification != INVALID_HANDLE_VALUE &&
+			WaitForSingleObject(state->notification, 0) == WAIT_OBJECT_0) {
+			changed = true;
+			FindNextChangeNotification(state->notification);
+		}
+
+		if (changed) {
+			ULARGE_INTEGER free_bytes = {}, total_bytes = {};
+
+			if (GetDiskFreeSpaceExA(root.c_str(), &free_bytes, &total_bytes, nullptr)) {
+				state->info.total = total_bytes.QuadPart;
+				state->info.free = free_bytes.QuadPart;
+				state->last_read = now;
+
+				// a notification storm should not crowd out the older history
+				if (state->history.empty() || now - state->history.back().time >= sample_spacing)
+					state->history.push_back({ now, static_cast<double>(state->info.total - state->info.free) });
+				else
+					state->history.back().used = static_cast<double>(state->info.total - state->info.free);
+
+				while (!state->history.empty() && now - state->history.front().time > history_window)
+					state->history.pop_front();
+
+				state->info.fill_rate = slope(state->history);
+				state->info.time_to_full = state->info.fill_rate > 0.0 ?
+					state->info.free / state->info.fill_rate : 0.0;
+			}
+			else {
+				error = "Reading the free space on " + root + " failed (error " + std::to_string(GetLastError()) + ")";
+				success = false;
+			}
+		}
+
+		volumes.push_back(state->info);
+	}
+
+	return success;
+}
+
+std::string volume_usage::to_string(double seconds) {
+	auto count = [](double value, const std::string& unit) {
+		const long long rounded = static_cast<long long>(value + 0.5);
+		return std::to_string(rounded) + " " + unit + (rounded == 1 ? "" : "s");
+	};
+
+	if (seconds < 3600.0)
+		return count(seconds / 60.0, "minute");
+
+	if (seconds < 2.0 * 86400.0)
+		return count(seconds / 3600.0, "hour");
+
+	if (seconds < 365.0 * 86400.0)
+		return count(seconds / 86400.0, "day");
+
+	return "over a year";
+}
@@ -0,0 +1,98 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include "disk_map.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Volume capacity and free space tracker.
+/// </summary>
+/// <remarks>
+/// Each volume is re-measured only when a change notification on it fires, or once a minute
+/// as a fallback for changes that do not raise notifications, so frequent reads are cheap.
+/// Volumes on removable disks, including usb drives that report themselves as fixed, get no
+/// notification, which would keep them from being ejected, and are polled every few seconds
+/// instead.
+/// The used space history of the last hour is fitted with a straight line to estimate how fast
+/// the volume is filling up and when it will be full.
+/// </remarks>
+class volume_usage {
+public:
+	struct volume_info {
+		/// <summary>The root path of the volume, e.g. "C:\".</summary>
+		std::string root;
+
+		/// <summary>The volume label.</summary>
+		std::string label;
+
+		/// <summary>The file system, e.g. "NTFS".</summary>
+		std::string file_system;
+
+		/// <summary>The capacity of the volume, in bytes.</summary>
+		unsigned long long total = 0;
+
+		/// <summary>The free space on the volume, in bytes.</summary>
+		unsigned long long free = 0;
+
+		/// <summary>The rate the volume is filling up at, in bytes per second. Negative when it is emptying.</summary>
+		double fill_rate = 0.0;
+
+		/// <summary>The estimated time until the volume is full, in seconds. 0 if it is not filling up.</summary>
+		double time_to_full = 0.0;
+
+		bool operator==(const volume_info&) const;
+		bool operator!=(const volume_info&) const;
+	};
+
+	volume_usage();
+	~volume_usage();
+
+	/// <summary>
+	/// Read the usage of the volumes on a set of disks.
+	/// </summary>
+	/// <param name="disks">The disks, from disk_map.</param>
+	/// <param name="volumes">The volume information, in the order the disks list them.</param>
+	/// <param name="error">Error information.</param>
+	/// <returns>Returns true if every volume was read, else false.</returns>
+	/// <remarks>Volumes no longer listed stop being tracked.</remarks>
+	bool read(const std::vector<disk_map::disk>& disks, std::vector<volume_info>& volumes, std::string& error);
+
+	/// <summary>
+	/// Format a duration roughly, e.g. "5 hours" or "3 days".
+	/// </summary>
+	/// <param name="seconds">The duration, in seconds.</param>
+	static std::string to_string(double seconds);
+
+private:
+	struct volume_state;
+	std::map<std::string, volume_state*> _volumes;
+
+	volume_usage(const volume_usage&) = delete;
+	volume_usage& operator=(const volume_usage&) = delete;
+};
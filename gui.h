@@ -43,6 +43,38 @@
 #include <liblec/leccore/web_update.h>
 #include <liblec/leccore/pc_info.h>
 
+// collectors
+#include "collectors/cpu_frequency.h"
+#include "collectors/cpu_topology.h"
+#include "collectors/cpu_features.h"
+#include "collectors/disk_map.h"
+#include "collectors/disk_activity.h"
+#include "collectors/volume_usage.h"
+#include "collectors/drive_health.h"
+#include "collectors/smbios.h"
+#include "collectors/edid.h"
+#include "collectors/memory_usage.h"
+#include "collectors/resource_limits.h"
+#include "collectors/thermal.h"
+#include "collectors/energy_meter.h"
+#include "collectors/battery_telemetry.h"
+#include "collectors/battery_estimator.h"
+#include "collectors/battery_wear.h"
+#include "collectors/energy_accounting.h"
+#include "collectors/network.h"
+#include "collectors/interrupt_activity.h"
+#include "collectors/hardware_counters.h"
+
+// benchmarks
+#include "benchmarks/memory_benchmark.h"
+#include "benchmarks/cache_latency_probe.h"
+#include "benchmarks/cpu_benchmark.h"
+#include "benchmarks/storage_benchmark.h"
+#include "benchmarks/power_capture.h"
+
+// STL
+#include <map>
+
 using namespace liblec;
 using snap_type = lecui::rect::snap_type;
 
@@ -104,6 +136,8 @@ class main_form : public lecui::form {
 
 	bool _settings_open = false;
 	bool _about_open = false;
+	bool _processes_open = false;
+	bool _sensors_open = false;
 
 	lecui::controls _ctrls{ *this };
 	lecui::page_manager _page_man{ *this };
@@ -121,9 +155,58 @@ class main_form : public lecui::form {
 	std::vector<leccore::pc_info::cpu_info> _cpus;
 	std::vector<leccore::pc_info::gpu_info> _gpus;
 	std::vector<leccore::pc_info::monitor_info> _monitors;
+	std::vector<leccore::pc_info::video_mode> _monitor_highest_modes;
+	edid _edid;
 	leccore::pc_info::ram_info _ram;
+	std::vector<unsigned char> _smbios_table;
 	std::vector<leccore::pc_info::drive_info> _drives;
 	leccore::pc_info::power_info _power;
+	std::vector<battery_telemetry> _battery_telemetry;
+	battery_estimator _battery_estimator;
+	energy_accounting _energy_accounting;
+	std::map<std::string, std::vector<battery_wear::wear_sample>> _battery_wear_series;
+	std::string _tray_text;
+
+	cpu_frequency _cpu_frequency;
+	cpu_frequency::frequency_info _cpu_frequency_info;
+	interrupt_activity _interrupt_activity;
+	interrupt_activity::activity_info _interrupt_info;
+	hardware_counters _hardware_counters;
+	hardware_counters::counters_info _hardware_counters_info;
+	std::string _hardware_counters_error;
+	memory_usage _memory_usage;
+	memory_usage::memory_info _memory_info;
+	resource_limits::limits_info _resource_limits;
+	thermal _thermal;
+	thermal::thermal_info _thermal_info;
+	std::vector<std::string> _thermal_alerts;
+	network _network;
+	network::network_info _network_info;
+	energy_meter _energy_meter;
+	energy_meter::power_info _energy_info;
+	std::vector<disk_map::disk> _disks;
+	disk_activity _disk_activity;
+	disk_activity::activity_info _disk_activity_info;
+	volume_usage _volume_usage;
+	std::vector<volume_usage::volume_info> _volumes;
+	std::map<std::string, drive_health::health_info> _drive_health;
+	std::map<std::string, std::vector<drive_health::health_sample>> _drive_health_series;
+	cpu_topology _cpu_topology;
+	cpu_topology::topology_info _cpu_topology_info;
+	cpu_features _cpu_features;
+	cpu_features::features_info _cpu_features_info;
+
+	memory_benchmark _memory_benchmark;
+	memory_benchmark::benchmark_results _memory_benchmark_results;
+	cache_latency_probe _cache_latency_probe;
+	cache_latency_probe::probe_results _cache_latency_results;
+	cpu_benchmark _cpu_benchmark;
+	cpu_benchmark::benchmark_results _cpu_benchmark_results;
+	storage_benchmark _storage_benchmark;
+	std::string _storage_benchmark_drive;
+	std::map<std::string, storage_benchmark::benchmark_results> _storage_benchmark_results;
+	power_capture _power_capture;
+	power_capture::capture_results _power_capture_results;
 
 	bool _update_details_displayed = false;
 
@@ -140,6 +223,8 @@ class main_form : public lecui::form {
 	void start_refresh_timer();
 	void stop_refresh_timer();
 	void about();
+	void processes();
+	void sensors();
 	void settings();
 	void updates();
 	void copy_pc_info();
@@ -164,6 +249,20 @@ class main_form : public lecui::form {
 	void add_drive_tab_pane();
 
 	void on_refresh();
+	void start_memory_benchmark();
+	void on_memory_benchmark();
+	void start_cache_latency_probe();
+	void on_cache_latency_probe();
+	void start_cpu_benchmark();
+	void on_cpu_benchmark();
+	void start_hardware_counters();
+	void start_storage_benchmark(int drive_number);
+	void on_storage_benchmark();
+	void start_power_capture();
+	void on_power_capture();
+	bool benchmark_running();
+	void enable_benchmark_buttons(bool enable);
+	void save_power_capture();
 	void on_update_check();
 	void on_update_download();
 	bool installed();
@@ -177,6 +276,59 @@ class main_form : public lecui::form {
 	std::string graphics_details_text();
 	std::string ram_details_text();
 	std::string drive_details_text();
+	std::string thermal_details_text();
+	std::string network_details_text();
+	static std::string network_traffic_text(double bytes, double packets);
+	static std::string network_addresses_text(const network::adapter_info& adapter);
+	std::string cpu_power_text();
+	std::string energy_use_text();
+	std::string power_capture_text();
+	std::string time_remaining_text();
+	std::string tray_text();
+	bool show_power_pane(const leccore::pc_info::power_info& power);
+	std::string current_speed_text();
+	std::string memory_benchmark_text();
+	std::string memory_usage_text();
+	std::string memory_paging_text();
+	std::vector<lecui::point> memory_usage_curve(float width, float height);
+	void record_battery_telemetry(const leccore::pc_info::power_info& power);
+	std::vector<lecui::point> battery_curve(size_t battery_number, battery_telemetry::field which, float width, float height);
+	std::string cache_latency_text();
+	std::string cpu_benchmark_text();
+	std::string hardware_counters_text();
+	std::string storage_benchmark_text(const leccore::pc_info::drive_info& drive);
+	const disk_activity::disk_counters* drive_activity(const leccore::pc_info::drive_info& drive);
+	std::string read_activity_text(const leccore::pc_info::drive_info& drive);
+	std::string write_activity_text(const leccore::pc_info::drive_info& drive);
+	std::string queue_activity_text(const leccore::pc_info::drive_info& drive);
+	void sample_disk_activity();
+	void read_volume_usage();
+	std::vector<volume_usage::volume_info> drive_volumes(const leccore::pc_info::drive_info& drive);
+	std::string volume_usage_text(const leccore::pc_info::drive_info& drive);
+	static std::string volume_text(const volume_usage::volume_info& volume);
+	bool read_smbios();
+	bool read_monitors();
+	void index_monitor_modes();
+	void read_drive_health();
+	void on_drive_health();
+	std::string drive_health_text(const leccore::pc_info::drive_info& drive);
+	std::string drive_health_trend_text(const leccore::pc_info::drive_info& drive);
+	bool drive_health_ok(const leccore::pc_info::drive_info& drive);
+	lecui::color drive_health_color(const leccore::pc_info::drive_info& drive);
+	void read_battery_wear();
+	void on_battery_wear();
+	void on_battery_sample();
+	void on_thermal_sample();
+	std::string battery_wear_text(const leccore::pc_info::battery_info& battery);
+	lecui::color thermal_color(const thermal::sensor& sensor);
+	void thermal_alert();
+
+	static std::string drive_key(const leccore::pc_info::drive_info& drive);
+	static std::string battery_key(const leccore::pc_info::battery_info& battery);
+	std::vector<lecui::point> cache_latency_curve(float width, float height);
+
+	static std::vector<lecui::point> sparkline(const std::vector<double>& values,
+		float width, float height, bool log_scale);
 
 public:
 	main_form(const std::string& caption, bool restarted);
@@ -30,6 +30,7 @@
 #include <liblec/lecui/widgets/label.h>
 #include <liblec/lecui/widgets/progress_bar.h>
 #include <liblec/lecui/widgets/progress_indicator.h>
+#include <liblec/lecui/widgets/line.h>
 #include <liblec/lecui/utilities/filesystem.h>
 
 // leccore
@@ -40,6 +41,10 @@
 
 // STL
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <cctype>
 
 const float main_form::_margin = 10.f;
 const float main_form::_title_font_size = 12.f;
@@ -92,13 +97,15 @@ void main_form::copy_pc_info() {
 	std::string text;
 	text += pc_details_text();
 	
-	if (!_power.batteries.empty())
+	if (show_power_pane(_power))
 		text += power_details_text();
 
 	text += cpu_details_text();
 	text += graphics_details_text();
 	text += ram_details_text();
 	text += drive_details_text();
+	text += thermal_details_text();
+	text += network_details_text();
 
 	// set the text to the clipboard
 	std::string error;
@@ -113,13 +120,15 @@ void main_form::export_pc_info() {
 	std::string text;
 	text += pc_details_text();
 
-	if (!_power.batteries.empty())
+	if (show_power_pane(_power))
 		text += power_details_text();
 
 	text += cpu_details_text();
 	text += graphics_details_text();
 	text += ram_details_text();
 	text += drive_details_text();
+	text += thermal_details_text();
+	text += network_details_text();
 	text += "\n-------------------------------------------------------------------------------\n";
 	text += "Exported from " + std::string(appname) + " " + std::string(appversion) + " (" + std::string(architecture) + ")";
 
@@ -150,10 +159,22 @@ void main_form::export_pc_info() {
 void main_form::on_start() {
 	start_refresh_timer();
 
+	// re-read drive health every half hour, it was first read on initialization
+	_timer_man.add("drive_health", 30 * 60 * 1000, [this]() { on_drive_health(); });
+
+	// the battery wear history is daily, checking every hour is plenty
+	_timer_man.add("battery_wear", 60 * 60 * 1000, [this]() { on_battery_wear(); });
+
+	// the refresh is skipped while the form is in the tray, the batteries are sampled regardless
+	_timer_man.add("battery_sample", _refresh_interval, [this]() { on_battery_sample(); });
+
+	// likewise temperatures, an alert matters most when nobody is watching
+	_timer_man.add("thermal_sample", _refresh_interval, [this]() { on_thermal_sample(); });
+
 	if (_installed) {
 		std::string error;
-		if (!_tray_icon.add(ico_resource, std::string(appname) + " " +
-			std::string(appversion) + " (" + std::string(architecture) + ")",
+		_tray_text = tray_text();
+		if (!_tray_icon.add(ico_resource, _tray_text,
 			{
 			{ "<strong>Show PC Info</strong>", [this]() {
 				if (minimized())
@@ -175,6 +196,165 @@ void main_form::on_start() {
 	_splash.remove();
 }
 
+bool main_form::read_monitors() {
+	std::string error;
+	std::vector<std::vector<unsigned char>> edids;
+
+	if (!edid::read(edids, error) || edids.empty())
+		return false;
+
+	std::vector<leccore::pc_info::monitor_info> monitors;
+	std::vector<leccore::pc_info::video_mode> highest_modes;
+
+	for (const auto& raw : edids) {
+		// a monitor that has been seen before is served from the cache
+		edid::edid_info info;
+		if (!_edid.decode(raw, info, error))
+			continue;
+
+		leccore::pc_info::monitor_info monitor;
+		monitor.manufacturer = info.manufacturer;
+		monitor.product_code_id = info.product_code;
+
+		for (const auto& mode : info.modes) {
+			leccore::pc_info::video_mode video_mode;
+			video_mode.horizontal_resolution = static_cast<decltype(video_mode.horizontal_resolution)>(mode.horizontal_resolution);
+			video_mode.vertical_resolution = static_cast<decltype(video_mode.vertical_resolution)>(mode.vertical_resolution);
+			video_mode.resolution_name = edid::resolution_name(mode.horizontal_resolution, mode.vertical_resolution);
+			video_mode.refresh_rate = static_cast<decltype(video_mode.refresh_rate)>(mode.refresh_rate);
+			video_mode.pixel_clock_rate = static_cast<decltype(video_mode.pixel_clock_rate)>(mode.pixel_clock_rate);
+			video_mode.physical_size = static_cast<decltype(video_mode.physical_size)>(info.diagonal_inches());
+			monitor.supported_modes.push_back(video_mode);
+		}
+
+		highest_modes.push_back(monitor.supported_modes[info.highest_mode]);
+		monitors.push_back(monitor);
+	}
+
+	if (monitors.empty())
+		return false;
+
+	_monitors = monitors;
+	_monitor_highest_modes = highest_modes;
+	return true;
+}
+
+void main_form::index_monitor_modes() {
+	_monitor_highest_modes.clear();
+
+	for (const auto& monitor : _monitors) {
+		leccore::pc_info::video_mode highest_mode = {};
+
+		for (auto& mode : monitor.supported_modes) {
+			if (highest_mode.horizontal_resolution < mode.horizontal_resolution)
+				highest_mode = mode;
+		}
+
+		_monitor_highest_modes.push_back(highest_mode);
+	}
+}
+
+bool main_form::read_smbios() {
+	std::string error;
+	smbios::smbios_info info;
+
+	if (!smbios::read(_smbios_table, error) || !smbios::parse_raw(_smbios_table, info, error))
+		return false;
+
+	leccore::pc_info::ram_info ram;
+
+	for (const auto& device : info.memory_devices) {
+		// skip empty slots
+		if (device.size == 0)
+			continue;
+
+		decltype(ram.ram_chips)::value_type chip;
+		chip.part_number = std::string(device.part_number);
+		chip.manufacturer = std::string(device.manufacturer);
+		chip.type = smbios::memory_type(device.type);
+		chip.form_factor = smbios::form_factor(device.form_factor);
+		chip.capacity = static_cast<decltype(chip.capacity)>(device.size);
+		chip.speed = static_cast<decltype(chip.speed)>(device.configured_speed > 0 ?
+			device.configured_speed : device.speed);
+
+		ram.size += static_cast<decltype(ram.size)>(chip.capacity);
+		ram.speed = std::max(ram.speed, static_cast<decltype(ram.speed)>(chip.speed));
+		ram.ram_chips.push_back(chip);
+	}
+
+	// a table without memory devices is incomplete, let the management queries have a go
+	if (ram.ram_chips.empty())
+		return false;
+
+	_ram = ram;
+
+	_pc_details.name = smbios::computer_name();
+	_pc_details.manufacturer = std::string(info.system.manufacturer);
+	_pc_details.model = std::string(info.system.product);
+	_pc_details.system_type = smbios::system_type();
+	_pc_details.bios_serial_number = std::string(info.system.serial_number);
+	_pc_details.motherboard_serial_number = std::string(info.board.serial_number);
+	return true;
+}
+
+void main_form::read_drive_health() {
+	std::string error;
+	const long long now = static_cast<long long>(std::time(nullptr));
+
+	for (const auto& drive : _drives) {
+		disk_map::disk disk;
+		if (!disk_map::find(_disks, drive.model, drive.serial_number, drive.size, disk))
+			continue;
+
+		drive_health::health_info health;
+		if (!drive_health::read(disk.path, health, error))
+			continue;
+
+		const std::string key = drive_key(drive);
+		_drive_health[key] = health;
+
+		// keep a compact daily series per drive in the settings
+		std::string setting_key;
+		for (const auto& c : key)
+			if (isalnum(static_cast<unsigned char>(c)))
+				setting_key += c;
+
+		auto& series = _drive_health_series[key];
+
+		if (series.empty()) {
+			std::string value;
+			if (_settings.read_value("drive_health", setting_key, value, error))
+				series = drive_health::deserialize(value);
+		}
+
+		const std::string old_value = drive_health::serialize(series);
+		drive_health::append(series, health, now);
+		const std::string value = drive_health::serialize(series);
+
+		if (value != old_value)
+			if (!_settings.write_value("drive_health", setting_key, value, error)) {}
+	}
+}
+
+void main_form::on_drive_health() {
+	read_drive_health();
+
+	for (size_t drive_number = 0; drive_number < _drives.size(); drive_number++) {
+		const auto& drive = _drives[drive_number];
+		const std::string path = "home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number);
+
+		try {
+			get_label(path + "/health")
+				.text(drive_health_text(drive))
+				.color_text(drive_health_color(drive));
+			get_label(path + "/health_trend").text(drive_health_trend_text(drive));
+		}
+		catch (const std::exception&) {}
+	}
+
+	update();
+}
+
 void main_form::start_refresh_timer() {
 	_timer_man.add("refresh", _refresh_interval, [&]() { on_refresh(); });
 }
@@ -183,6 +363,91 @@ void main_form::stop_refresh_timer() {
 	_timer_man.stop("refresh");
 }
 
+void main_form::read_battery_wear() {
+	std::string error;
+	const long long now = static_cast<long long>(std::time(nullptr));
+
+	for (const auto& battery : _power.batteries) {
+		const std::string key = battery_key(battery);
+
+		// keep a compact daily series per battery in the settings
+		std::string setting_key;
+		for (const auto& c : key)
+			if (isalnum(static_cast<unsigned char>(c)))
+				setting_key += c;
+
+		auto& series = _battery_wear_series[key];
+
+		if (series.empty()) {
+			std::string value;
+			if (_settings.read_value("battery_wear", setting_key, value, error))
+				series = battery_wear::deserialize(value);
+		}
+
+		const std::string old_value = battery_wear::serialize(series);
+		battery_wear::append(series, battery.designed_capacity, battery.fully_charged_capacity, now);
+		const std::string value = battery_wear::serialize(series);
+
+		if (value != old_value)
+			if (!_settings.write_value("battery_wear", setting_key, value, error)) {}
+	}
+}
+
+void main_form::on_battery_wear() {
+	read_battery_wear();
+
+	for (size_t battery_number = 0; battery_number < _power.batteries.size(); battery_number++) {
+		const auto& battery = _power.batteries[battery_number];
+
+		try {
+			get_label("home/power_pane/battery_tab_pane/Battery " + std::to_string(battery_number) + "/wear_projection")
+				.text(battery_wear_text(battery));
+		}
+		catch (const std::exception&) {}
+	}
+
+	update();
+}
+
+void main_form::on_battery_sample() {
+	std::string error;
+	leccore::pc_info::power_info power;
+	if (!_pc_info.power(power, error))
+		return;
+
+	// keep a bounded history of each battery
+	record_battery_telemetry(power);
+
+	// keep the time remaining in the tray tooltip
+	if (_installed && _tray_text != tray_text()) {
+		_tray_text = tray_text();
+		if (!_tray_icon.change(ico_resource, _tray_text, error)) {}
+	}
+
+	if (power.batteries.empty())
+		return;
+
+	double charge_rate = 0.0;
+	for (const auto& battery : power.batteries)
+		charge_rate += battery.current_charge_rate;
+
+	_energy_accounting.add(static_cast<long long>(std::time(nullptr)), power.ac, charge_rate, power.level);
+}
+
+void main_form::on_thermal_sample() {
+	// all temperature sensors in one pass, the thermal and network form shows what is read here
+	std::string error;
+	if (!_thermal.read(_disks, _thermal_info, error)) {}
+
+	thermal_alert();
+
+	// flag critical temperatures in the tray tooltip
+	if (_installed && _tray_text != tray_text()) {
+		_tray_text = tray_text();
+		if (!_tray_icon.change(ico_resource, _tray_text, error)) {}
+	}
+}
+
 void main_form::on_refresh() {
 	if (!visible())
 		return;
@@ -192,7 +457,10 @@ void main_form::on_refresh() {
 
 	std::string error;
 	std::vector<leccore::pc_info::monitor_info> _monitors_old = _monitors;
-	if (!_pc_info.monitor(_monitors, error)) {}
+	if (!read_monitors()) {
+		if (!_pc_info.monitor(_monitors, error)) {}
+		index_monitor_modes();
+	}
 
 	std::vector<leccore::pc_info::drive_info> _drives_old = _drives;
 	if (!_pc_info.drives(_drives, error)) {}
@@ -200,6 +468,49 @@ void main_form::on_refresh() {
 	leccore::pc_info::power_info _power_old = _power;
 	if (!_pc_info.power(_power, error)) {}
 
+	// the wear history is kept on a timer of its own and when batteries change
+	if (_power_old.batteries.size() != _power.batteries.size())
+		read_battery_wear();
+
+	// energy used since the last refresh
+	energy_meter::power_info _energy_info_old = _energy_info;
+	if (!_energy_meter.read(_energy_info, error)) {}
+
+	// sample all cores in one pass
+	cpu_frequency::frequency_info _cpu_frequency_info_old = _cpu_frequency_info;
+	if (!_cpu_frequency.read(_cpu_frequency_info, error)) {}
+
+	// interrupt and dpc counters of all cores in one pass
+	interrupt_activity::activity_info _interrupt_info_old = _interrupt_info;
+	if (!_interrupt_activity.read(_interrupt_info, error)) {}
+
+	// hardware counters, only once they have been started
+	hardware_counters::counters_info _hardware_counters_info_old = _hardware_counters_info;
+	if (_hardware_counters.running())
+		if (!_hardware_counters.read(_hardware_counters_info, error)) {}
+
+	// memory usage changes on every refresh, the history strip with it
+	memory_usage::memory_info _memory_info_old = _memory_info;
+	if (!_memory_usage.read(_memory_info, error)) {}
+
+	// map drives to physical disks again when drives come and go, then sample all disks in one pass
+	if (_drives_old.size() != _drives.size())
+		if (!disk_map::read(_disks, error)) {}
+
+	disk_activity::activity_info _disk_activity_info_old = _disk_activity_info;
+	sample_disk_activity();
+
+	// volumes are only re-measured when they have changed
+	std::vector<volume_usage::volume_info> _volumes_old = _volumes;
+	read_volume_usage();
+
+	// health logs change slowly, they are read on a timer of their own and when drives change
+	if (_drives_old.size() != _drives.size())
+		read_drive_health();
+
+	// all network adapters in one call
+	if (!_network.read(_network_info, error)) {}
+
 	try {
 		// refresh pc details
 		if (_monitors_old.size() != _monitors.size()) {
@@ -247,12 +558,15 @@ void main_form::on_refresh() {
 			refresh_ui = true;
 		}
 
-		if (_power_old.lifetime_remaining != _power.lifetime_remaining) {
+		try {
+			// the smoothed estimate changes even when the os figure doesn't
 			auto& life_remaining = get_label("home/power_pane/life_remaining");
-			life_remaining.text(_power.lifetime_remaining.empty() ? std::string() :
-				(_power.lifetime_remaining + " remaining"));
-			refresh_ui = true;
+			if (life_remaining.text() != time_remaining_text()) {
+				life_remaining.text(time_remaining_text());
+				refresh_ui = true;
+			}
 		}
+		catch (const std::exception) {}
 
 		if (_power_old.batteries.size() != _power.batteries.size()) {
 			auto& cpu_pane = get_pane("home/cpu_pane");
@@ -260,10 +574,13 @@ void main_form::on_refresh() {
 			auto& ram_pane = get_pane("home/ram_pane");
 			auto& drive_pane = get_pane("home/drive_pane");
 
-			if (_power_old.batteries.empty()) {
+			if (!show_power_pane(_power_old)) {
 				add_power_pane();
 				add_battery_pane();
 
+				if (benchmark_running())
+					enable_benchmark_buttons(false);
+
 				auto& power_pane = get_pane("home/power_pane");
 
 				// move panes to accomodate power pane
@@ -273,7 +590,7 @@ void main_form::on_refresh() {
 				drive_pane.rect().move(ram_pane.rect().left(), drive_pane.rect().top());
 			}
 			else {
-				if (_power.batteries.empty()) {
+				if (!show_power_pane(_power)) {
 					_page_man.close("home/power_pane");
 
 					auto& pc_details_pane = get_pane("home/pc_details_pane");
@@ -285,11 +602,13 @@ void main_form::on_refresh() {
 					drive_pane.rect().move(ram_pane.rect().left(), drive_pane.rect().top());
 				}
 				else {
-					// close old battery pane
-					_page_man.close("home/power_pane/battery_tab_pane");
+					// close old battery pane, there is none when the pane is only there for cpu power
+					if (!_power_old.batteries.empty())
+						_page_man.close("home/power_pane/battery_tab_pane");
 
 					// add new battery pane
-					add_battery_pane();
+					if (!_power.batteries.empty())
+						add_battery_pane();
 				}
 			}
 
@@ -367,6 +686,104 @@ void main_form::on_refresh() {
 	}
 	catch (const std::exception) {}
 
+	try {
+		// refresh battery history, a sample is added on every refresh
+		for (size_t battery_number = 0; battery_number < _power.batteries.size(); battery_number++) {
+			const std::string path = "home/power_pane/battery_tab_pane/Battery " + std::to_string(battery_number);
+
+			const std::pair<std::string, battery_telemetry::field> histories[] = {
+				{ "capacity_history", battery_telemetry::field::capacity },
+				{ "level_history", battery_telemetry::field::level },
+				{ "voltage_history", battery_telemetry::field::voltage },
+				{ "rate_history", battery_telemetry::field::charge_rate },
+			};
+
+			for (const auto& history : histories) {
+				auto& line = get_line(path + "/" + history.first);
+				line.points(battery_curve(battery_number, history.second, line.rect().width(), line.rect().height()));
+			}
+
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh cpu power
+		if (_energy_info_old != _energy_info) {
+			get_label("home/power_pane/cpu_power").text(cpu_power_text());
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh battery energy use, it is integrated on every refresh
+		auto& energy_use = get_label("home/power_pane/energy_use");
+		if (energy_use.text() != energy_use_text()) {
+			energy_use.text(energy_use_text());
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh cpu speed
+		if (_cpu_frequency_info_old != _cpu_frequency_info) {
+			for (size_t cpu_number = 0; cpu_number < _cpus.size(); cpu_number++) {
+				auto& current_speed = get_label("home/cpu_pane/cpu_tab_pane/CPU " + std::to_string(cpu_number) + "/current_speed");
+				current_speed
+					.text(current_speed_text())
+					.color_text(_cpu_frequency_info.throttled_cores > 0 ? _not_ok_color : _caption_color);
+			}
+
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh interrupt activity
+		if (_interrupt_info_old != _interrupt_info) {
+			get_label("home/cpu_pane/cpu_tab_pane/Activity/interrupts").text(interrupt_activity::summary(_interrupt_info));
+			get_label("home/cpu_pane/cpu_tab_pane/Activity/interrupt_hot_spots")
+				.text(interrupt_activity::hot_spot_text(_interrupt_info))
+				.color_text(_interrupt_info.hot_spots.empty() ? _caption_color : _not_ok_color);
+
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh hardware counters
+		if (_hardware_counters_info_old != _hardware_counters_info) {
+			auto& counters = get_label("home/cpu_pane/cpu_tab_pane/Activity/counters");
+			counters
+				.text(hardware_counters_text())
+				.tooltip(hardware_counters::core_text(_hardware_counters_info));
+
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
+	try {
+		// refresh memory usage
+		if (_memory_info_old != _memory_info) {
+			get_label("home/ram_pane/ram_tab_pane/Usage/usage").text(memory_usage_text());
+			get_label("home/ram_pane/ram_tab_pane/Usage/paging")
+				.text(memory_paging_text())
+				.color_text(_memory_info.pressure == memory_usage::pressure_level::high ? _not_ok_color : _caption_color);
+
+			auto& usage_history = get_line("home/ram_pane/ram_tab_pane/Usage/usage_history");
+			usage_history.points(memory_usage_curve(usage_history.rect().width(), usage_history.rect().height()));
+
+			refresh_ui = true;
+		}
+	}
+	catch (const std::exception) {}
+
 	try {
 		// to-do: refresh monitor details
 		if (_monitors_old.size() != _monitors.size()) {
@@ -390,6 +807,9 @@ void main_form::on_refresh() {
 			// add new drive tab pane
 			add_drive_tab_pane();
 
+			if (benchmark_running())
+				enable_benchmark_buttons(false);
+
 			refresh_ui = true;
 		}
 		else {
@@ -423,6 +843,26 @@ void main_form::on_refresh() {
 
 					refresh_ui = true;
 				}
+
+				if (_volumes_old != _volumes) {
+					auto& volumes = get_label("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/volumes");
+					volumes.text(volume_usage_text(drive));
+
+					refresh_ui = true;
+				}
+
+				if (_disk_activity_info_old != _disk_activity_info) {
+					auto& read_activity = get_label("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/read_activity");
+					read_activity.text(read_activity_text(drive));
+
+					auto& write_activity = get_label("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/write_activity");
+					write_activity.text(write_activity_text(drive));
+
+					auto& queue_activity = get_label("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/queue_activity");
+					queue_activity.text(queue_activity_text(drive));
+
+					refresh_ui = true;
+				}
 			}
 		}
 	}
@@ -431,101 +871,483 @@ void main_form::on_refresh() {
 	if (refresh_ui)
 		update();
 
+
 	start_refresh_timer();
 }
 
-void main_form::on_update_check() {
-	if (_check_update.checking())
+void main_form::start_memory_benchmark() {
+	if (benchmark_running())
 		return;
 
-	// update status label
-	try {
-		auto& text = get_label("home/update_status").text();
-		const size_t dot_count = std::count(text.begin(), text.end(), '.');
+	enable_benchmark_buttons(false);
 
-		if (dot_count == 0)
-			text = "Checking for updates ...";
-		else
-			if (dot_count < 10)
-				text += ".";
-			else
-				text = "Checking for updates ...";
-		
+	try {
+		get_label("home/ram_pane/benchmark").text("Running benchmark ...");
 		update();
 	}
 	catch (const std::exception&) {}
 
-	// stop the update check timer
-	_timer_man.stop("update_check");
+	// start the benchmark on its worker thread and keep track of its progress
+	_memory_benchmark.start();
+	_timer_man.add("memory_benchmark", 500, [this]() { on_memory_benchmark(); });
+}
 
-	std::string error;
-	if (!_check_update.result(_update_info, error)) {
-		// update status label
+void main_form::on_memory_benchmark() {
+	float progress = 0.f;
+	if (_memory_benchmark.running(progress)) {
+		// update benchmark label
 		try {
-			get_label("home/update_status").text("Error while checking for updates");
+			get_label("home/ram_pane/benchmark").text("Running benchmark ... " +
+				leccore::round_off::to_string(progress, 0) + "%");
 			update();
-			close_update_status();
 		}
 		catch (const std::exception&) {}
-
-		if (!_setting_autocheck_updates || _update_check_initiated_manually)
-			message("An error occurred while checking for updates:\n" + error);
-
 		return;
 	}
-	
-	// update found
-	const std::string current_version(appversion);
-	const int result = leccore::compare_versions(current_version, _update_info.version);
-	if (result == -1) {
-		// newer version available
-		
-		// update status label
-		try {
-			get_label("home/update_status").text("Update available: " + _update_info.version);
-			update();
-		}
-		catch (const std::exception&) {}
 
-		if (!_setting_autodownload_updates) {
-			if (!prompt("<span style = 'font-size: 11.0pt;'>Update Available</span>\n\n"
-				"Your version:\n" + current_version + "\n\n"
-				"New version:\n<span style = 'color: rgb(0, 150, 0);'>" + _update_info.version + "</span>, " + _update_info.date + "\n\n"
-				"<span style = 'font-size: 11.0pt;'>Description</span>\n" +
-				_update_info.description + "\n\n"
-				"Would you like to download the update now? (" +
-				leccore::format_size(_update_info.size, 2) + ")\n\n"))
-				return;
-		}
+	// stop the memory benchmark timer
+	_timer_man.stop("memory_benchmark");
 
-		// create update download folder
-		_update_directory = leccore::user_folder::temp() + "\\" + leccore::hash_string::uuid();
+	std::string error;
+	if (!_memory_benchmark.result(_memory_benchmark_results, error))
+		message("Memory benchmark failed:\n" + error);
 
-		if (!leccore::file::create_directory(_update_directory, error))
-			return;	// to-do: perhaps try again one or two more times? But then again, why would this method fail?
+	try {
+		get_label("home/ram_pane/benchmark").text(memory_benchmark_text());
+	}
+	catch (const std::exception&) {}
 
-		// update status label
-		try {
-			get_label("home/update_status").text("Downloading update ...");
-			update();
-		}
-		catch (const std::exception&) {}
+	enable_benchmark_buttons(true);
+	update();
+}
 
-		// download update
-		_download_update.start(_update_info.download_url, _update_directory);
-		_timer_man.add("update_download", 1000, [&]() { on_update_download(); });
+void main_form::start_cache_latency_probe() {
+	if (benchmark_running())
+		return;
+
+	enable_benchmark_buttons(false);
+
+	try {
+		get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/latency").text("Probing ...");
 	}
-	else {
-		// update status label
+	catch (const std::exception&) {}
+
+	update();
+
+	// start the probe on its worker thread and keep track of its progress
+	_cache_latency_probe.start();
+	_timer_man.add("cache_latency_probe", 250, [this]() { on_cache_latency_probe(); });
+}
+
+void main_form::on_cache_latency_probe() {
+	float progress = 0.f;
+	if (_cache_latency_probe.running(progress)) {
+		// update latency label
 		try {
-			get_label("home/update_status").text("Latest version is already installed");
-			update();
-			close_update_status();
+			get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/latency")
+				.text("Probing ... " + leccore::round_off::to_string(progress, 0) + "%");
 		}
 		catch (const std::exception&) {}
 
-		if (!_setting_autocheck_updates || _update_check_initiated_manually)
-			message("The latest version is already installed.");
+		update();
+		return;
+	}
+
+	// stop the cache latency probe timer
+	_timer_man.stop("cache_latency_probe");
+
+	std::string error;
+	if (!_cache_latency_probe.result(_cache_latency_results, error))
+		message("Cache latency probe failed:\n" + error);
+
+	try {
+		get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/latency").text(cache_latency_text());
+
+		auto& latency_curve = get_line("home/cpu_pane/cpu_tab_pane/Benchmarks/latency_curve");
+		latency_curve.points(cache_latency_curve(latency_curve.rect().width(), latency_curve.rect().height()));
+	}
+	catch (const std::exception&) {}
+
+	enable_benchmark_buttons(true);
+	update();
+}
+
+void main_form::start_cpu_benchmark() {
+	if (benchmark_running())
+		return;
+
+	enable_benchmark_buttons(false);
+
+	try {
+		get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/throughput")
+			.text("Running ...")
+			.color_text(_caption_color);
+	}
+	catch (const std::exception&) {}
+
+	update();
+
+	// start the benchmark on its worker thread and keep track of its progress
+	_cpu_benchmark.start();
+	_timer_man.add("cpu_benchmark", 250, [this]() { on_cpu_benchmark(); });
+}
+
+void main_form::on_cpu_benchmark() {
+	float progress = 0.f;
+	if (_cpu_benchmark.running(progress)) {
+		// update throughput label
+		try {
+			get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/throughput")
+				.text("Running ... " + leccore::round_off::to_string(progress, 0) + "%");
+		}
+		catch (const std::exception&) {}
+
+		update();
+		return;
+	}
+
+	// stop the cpu benchmark timer
+	_timer_man.stop("cpu_benchmark");
+
+	std::string error;
+	if (!_cpu_benchmark.result(_cpu_benchmark_results, error))
+		message("CPU benchmark failed:\n" + error);
+
+	try {
+		get_label("home/cpu_pane/cpu_tab_pane/Benchmarks/throughput")
+			.text(cpu_benchmark_text())
+			.color_text(cpu_benchmark::poor_scaling(_cpu_benchmark_results) ? _not_ok_color : _caption_color);
+	}
+	catch (const std::exception&) {}
+
+	enable_benchmark_buttons(true);
+	update();
+}
+
+void main_form::start_hardware_counters() {
+	if (_hardware_counters.running())
+		return;
+
+	const bool started = _hardware_counters.start(_hardware_counters_error);
+
+	// once started the sampler runs until the app closes; after a failure the user can retry,
+	// e.g. once the other instance has closed
+	if (started) {
+		std::string error;
+		_widget_man.disable("home/cpu_pane/cpu_tab_pane/Activity/counters_button", error);
+	}
+
+	try {
+		get_label("home/cpu_pane/cpu_tab_pane/Activity/counters")
+			.text(hardware_counters_text())
+			.color_text(started ? _caption_color : _not_ok_color);
+	}
+	catch (const std::exception&) {}
+
+	update();
+}
+
+void main_form::start_storage_benchmark(int drive_number) {
+	if (benchmark_running())
+		return;
+
+	if (drive_number < 0 || drive_number >= static_cast<int>(_drives.size()))
+		return;
+
+	const auto& drive = _drives[drive_number];
+
+	// find the volumes on this drive so there is somewhere to put the temporary file
+	std::string error;
+	std::vector<disk_map::disk> disks;
+	disk_map::disk disk;
+
+	if (!disk_map::read(disks, error)) {
+		message("Storage benchmark failed:\n" + error);
+		return;
+	}
+
+	if (!disk_map::find(disks, drive.model, drive.serial_number, drive.size, disk)) {
+		message("Storage benchmark failed:\nThe drive could not be matched to a physical disk");
+		return;
+	}
+
+	const std::string directory = storage_benchmark::choose_directory(disk.volumes);
+
+	if (directory.empty()) {
+		message("Storage benchmark failed:\nThe drive has no volume to run the benchmark on");
+		return;
+	}
+
+	if (!prompt("The benchmark will write a temporary 1GB file to " + directory + ". Continue?"))
+		return;
+
+	_storage_benchmark_drive = drive_key(drive);
+
+	enable_benchmark_buttons(false);
+
+	try {
+		get_label("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/benchmark")
+			.text("Running benchmark ...");
+	}
+	catch (const std::exception&) {}
+
+	update();
+
+	// start the benchmark on its worker thread and keep track of its progress
+	_storage_benchmark.directory(directory);
+	_storage_benchmark.start();
+	_timer_man.add("storage_benchmark", 500, [this]() { on_storage_benchmark(); });
+}
+
+void main_form::start_power_capture() {
+	if (benchmark_running())
+		return;
+
+	enable_benchmark_buttons(false);
+
+	try {
+		get_label("home/power_pane/power_capture").text("Capturing ...");
+	}
+	catch (const std::exception&) {}
+
+	update();
+
+	// sample on the worker thread and keep track of its progress
+	_power_capture.configure(20, 30);
+	_power_capture.start();
+	_timer_man.add("power_capture", 500, [this]() { on_power_capture(); });
+}
+
+void main_form::on_power_capture() {
+	float progress = 0.f;
+
+	if (_power_capture.running(progress)) {
+		try {
+			get_label("home/power_pane/power_capture")
+				.text("Capturing ... " + leccore::round_off::to_string(progress, 0) + "%");
+		}
+		catch (const std::exception&) {}
+
+		update();
+		return;
+	}
+
+	// stop the power capture timer
+	_timer_man.stop("power_capture");
+
+	std::string error;
+	power_capture::capture_results results;
+	const bool captured = _power_capture.result(results, error);
+
+	if (captured)
+		_power_capture_results = results;
+	else
+		message("Power capture failed:\n" + error);
+
+	try {
+		get_label("home/power_pane/power_capture").text(power_capture_text());
+
+		auto& power_capture_plot = get_line("home/power_pane/power_capture_plot");
+		power_capture_plot.points(sparkline(power_capture::plot_values(_power_capture_results),
+			power_capture_plot.rect().width(), power_capture_plot.rect().height(), false));
+	}
+	catch (const std::exception&) {}
+
+	enable_benchmark_buttons(true);
+	update();
+
+	if (captured)
+		save_power_capture();
+}
+
+bool main_form::benchmark_running() {
+	// the benchmarks would skew each other's results, so only one runs at a time
+	return _memory_benchmark.running() || _timer_man.running("memory_benchmark") ||
+		_cache_latency_probe.running() || _timer_man.running("cache_latency_probe") ||
+		_cpu_benchmark.running() || _timer_man.running("cpu_benchmark") ||
+		_storage_benchmark.running() || _timer_man.running("storage_benchmark") ||
+		_power_capture.running() || _timer_man.running("power_capture");
+}
+
+void main_form::enable_benchmark_buttons(bool enable) {
+	std::vector<std::string> paths = {
+		"home/ram_pane/benchmark_button",
+		"home/cpu_pane/cpu_tab_pane/Benchmarks/latency_button",
+		"home/cpu_pane/cpu_tab_pane/Benchmarks/throughput_button"
+	};
+
+	for (size_t drive_number = 0; drive_number < _drives.size(); drive_number++)
+		paths.push_back("home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number) + "/benchmark_button");
+
+	// there is no power pane on systems without batteries
+	if (show_power_pane(_power))
+		paths.push_back("home/power_pane/power_capture_button");
+
+	std::string error;
+	for (const auto& path : paths) {
+		if (enable)
+			_widget_man.enable(path, error);
+		else
+			_widget_man.disable(path, error);
+	}
+}
+
+void main_form::save_power_capture() {
+	lecui::filesystem _file_system(*this);
+
+	lecui::save_file_params params;
+	params
+		.title(std::string(appname) + " - Save power capture")
+		.include_all_files(false)
+		.file_types({ { "csv", "CSV File" } });
+
+	// get the full path to the file (prompt user)
+	const auto full_path = _file_system.save_file("power capture - " + _pc_details.name + ".csv", params);
+
+	if (!full_path.empty()) {
+		std::string error;
+		if (!leccore::file::write(full_path, power_capture::to_csv(_power_capture_results), error))
+			message(error);
+	}
+}
+
+void main_form::on_storage_benchmark() {
+	float progress = 0.f;
+	const bool running = _storage_benchmark.running(progress);
+
+	if (!running) {
+		// stop the storage benchmark timer
+		_timer_man.stop("storage_benchmark");
+
+		std::string error;
+		storage_benchmark::benchmark_results results;
+
+		if (_storage_benchmark.result(results, error))
+			_storage_benchmark_results[_storage_benchmark_drive] = results;
+		else
+			message("Storage benchmark failed:\n" + error);
+	}
+
+	// the drive tabs may have been rebuilt since the benchmark started, so find the drive by key
+	for (size_t drive_number = 0; drive_number < _drives.size(); drive_number++) {
+		const std::string path = "home/drive_pane/drive_tab_pane/Drive " + std::to_string(drive_number);
+
+		if (running) {
+			if (drive_key(_drives[drive_number]) != _storage_benchmark_drive)
+				continue;
+
+			try {
+				get_label(path + "/benchmark")
+					.text("Running benchmark ... " + leccore::round_off::to_string(progress, 0) + "%");
+			}
+			catch (const std::exception&) {}
+		}
+		else {
+			try {
+				get_label(path + "/benchmark").text(storage_benchmark_text(_drives[drive_number]));
+			}
+			catch (const std::exception&) {}
+		}
+	}
+
+	if (!running)
+		enable_benchmark_buttons(true);
+
+	update();
+}
+
+void main_form::on_update_check() {
+	if (_check_update.checking())
+		return;
+
+	// update status label
+	try {
+		auto& text = get_label("home/update_status").text();
+		const size_t dot_count = std::count(text.begin(), text.end(), '.');
+
+		if (dot_count == 0)
+			text = "Checking for updates ...";
+		else
+			if (dot_count < 10)
+				text += ".";
+			else
+				text = "Checking for updates ...";
+		
+		update();
+	}
+	catch (const std::exception&) {}
+
+	// stop the update check timer
+	_timer_man.stop("update_check");
+
+	std::string error;
+	if (!_check_update.result(_update_info, error)) {
+		// update status label
+		try {
+			get_label("home/update_status").text("Error while checking for updates");
+			update();
+			close_update_status();
+		}
+		catch (const std::exception&) {}
+
+		if (!_setting_autocheck_updates || _update_check_initiated_manually)
+			message("An error occurred while checking for updates:\n" + error);
+
+		return;
+	}
+	
+	// update found
+	const std::string current_version(appversion);
+	const int result = leccore::compare_versions(current_version, _update_info.version);
+	if (result == -1) {
+		// newer version available
+		
+		// update status label
+		try {
+			get_label("home/update_status").text("Update available: " + _update_info.version);
+			update();
+		}
+		catch (const std::exception&) {}
+
+		if (!_setting_autodownload_updates) {
+			if (!prompt("<span style = 'font-size: 11.0pt;'>Update Available</span>\n\n"
+				"Your version:\n" + current_version + "\n\n"
+				"New version:\n<span style = 'color: rgb(0, 150, 0);'>" + _update_info.version + "</span>, " + _update_info.date + "\n\n"
+				"<span style = 'font-size: 11.0pt;'>Description</span>\n" +
+				_update_info.description + "\n\n"
+				"Would you like to download the update now? (" +
+				leccore::format_size(_update_info.size, 2) + ")\n\n"))
+				return;
+		}
+
+		// create update download folder
+		_update_directory = leccore::user_folder::temp() + "\\" + leccore::hash_string::uuid();
+
+		if (!leccore::file::create_directory(_update_directory, error))
+			return;	// to-do: perhaps try again one or two more times? But then again, why would this method fail?
+
+		// update status label
+		try {
+			get_label("home/update_status").text("Downloading update ...");
+			update();
+		}
+		catch (const std::exception&) {}
+
+		// download update
+		_download_update.start(_update_info.download_url, _update_directory);
+		_timer_man.add("update_download", 1000, [&]() { on_update_download(); });
+	}
+	else {
+		// update status label
+		try {
+			get_label("home/update_status").text("Latest version is already installed");
+			update();
+			close_update_status();
+		}
+		catch (const std::exception&) {}
+
+		if (!_setting_autocheck_updates || _update_check_initiated_manually)
+			message("The latest version is already installed.");
 	}
 }
 
@@ -811,7 +1633,24 @@ std::string main_form::power_details_text() {
 	text += std::string(_power.ac ? "On AC" : "On Battery") + ", " + _pc_info.to_string(_power.status) + "\n";
 	text += "Level:\t\t\t\t" + (_power.level != -1 ?
 		(std::to_string(_power.level) + "% ") : "Unknown ") + "overall power level\n";
-	text += "Time remaining:\t\t\t" + (_power.lifetime_remaining.empty() ? std::string() : (_power.lifetime_remaining + " remaining")) + "\n";
+	text += "Time remaining:\t\t\t" + time_remaining_text() + "\n";
+	text += "CPU Power:\t\t\t" + cpu_power_text() + "\n";
+
+	if (!_power.batteries.empty()) {
+		const auto energy = _energy_accounting.get();
+		text += "Energy Used:\t\t\t" + energy_use_text() + "\n";
+		text += "Energy Charged:\t\t\t" + leccore::round_off::to_string(energy.session_charged / 1000.0, 1) + "Wh\n";
+		text += "Since Full Charge:\t\t" + (energy.full_charge_seen ?
+			(leccore::round_off::to_string(energy.since_full_discharged / 1000.0, 1) + "Wh used") :
+			std::string("No full charge this session")) + "\n";
+		text += "AC Plug Events:\t\t\t" + std::to_string(energy.plugged) + " connected, " +
+			std::to_string(energy.unplugged) + " disconnected\n";
+	}
+
+	text += "Power Capture:\t\t\t" + power_capture_text() + "\n";
+
+	if (!_power_capture_results.samples.empty())
+		text += "Capture Overhead:\t\t" + power_capture::overhead(_power_capture_results) + "\n";
 
 	int battery_number = 0;
 	for (const auto& battery : _power.batteries) {
@@ -824,6 +1663,8 @@ std::string main_form::power_details_text() {
 		text += battery.manufacturer + "\n";
 		text += "Battery Health:\t\t\t";
 		text += leccore::round_off::to_string(battery.health, 0) + "%\n";
+		text += "Wear Projection:\t\t";
+		text += battery_wear_text(battery) + "\n";
 		text += "Designed Capacity:\t\t";
 		text += (_setting_milliunits ?
 			std::to_string(battery.designed_capacity) + "mWh" :
@@ -875,17 +1716,132 @@ std::string main_form::cpu_details_text() {
 		text += cpu.status + "\n";
 		text += "Base Speed:\t\t\t";
 		text += leccore::round_off::to_string(cpu.base_speed, 2) + "GHz" + "\n";
-		text += "Cores:\t\t\t\t";
-		text += (std::to_string(cpu.cores) +
+		text += "Current Speed:\t\t\t";
+		text += current_speed_text() + "\n";
+		text += "Core Speeds:\t\t\t";
+
+		std::string core_speeds;
+		for (const auto& core : _cpu_frequency_info.cores) {
+			if (!core_speeds.empty())
+				core_speeds += ", ";
+
+			core_speeds += std::to_string(core.current_mhz) + "MHz";
+
+			if (core.throttled)
+				core_speeds += " (throttled)";
+		}
+
+		text += core_speeds + "\n";
+		text += "Cores:\t\t\t\t";
+		text += (std::to_string(cpu.cores) +
 			std::string(cpu.cores == 1 ? " core" : " cores") + ", " +
 			std::to_string(cpu.logical_processors) +
 			std::string(cpu.cores == 1 ? " logical processor" : " logical processors")) + "\n";
+		text += "Cache:\t\t\t\t";
+		text += cpu_topology::cache_summary(_cpu_topology_info, cpu_number) + "\n";
+		text += "Topology:\t\t\t";
+		text += cpu_topology::layout_summary(_cpu_topology_info, cpu_number) + "\n";
+		text += "Effective Limit:\t\t";
+		text += resource_limits::cpu_summary(_resource_limits) + "\n";
+		text += "Interrupts:\t\t\t";
+		text += interrupt_activity::summary(_interrupt_info) + "\n";
+		text += "Interrupt Hot Spots:\t\t";
+		text += interrupt_activity::hot_spot_text(_interrupt_info) + "\n";
+		text += "Core Interrupts:\t\t";
+		text += interrupt_activity::distribution_text(_interrupt_info) + "\n";
+
+		if (_hardware_counters.running()) {
+			text += "Performance Counters:\t\t";
+			text += hardware_counters::summary(_hardware_counters_info) + "\n";
+			text += "Core Counters:\t\t\t";
+			text += hardware_counters::core_text(_hardware_counters_info) + "\n";
+		}
+
+		for (const auto& cache : cpu_topology::package_caches(_cpu_topology_info, cpu_number)) {
+			text += "L" + std::to_string(cache.level) + " " + cache.type + ":\t\t\t";
+			text += leccore::format_size(cache.size) + ", " +
+				std::to_string(cache.line_size) + "B line, " +
+				(cache.associativity == 0xFF ? std::string("fully associative") : std::to_string(cache.associativity) + "-way") +
+				", processors " + cpu_topology::to_ranges(cache.shared_by) + "\n";
+		}
+
+		std::string smt_siblings;
+		for (const auto& core : _cpu_topology_info.cores) {
+			if (static_cast<int>(core.package) != cpu_number)
+				continue;
+
+			if (!smt_siblings.empty())
+				smt_siblings += "; ";
+
+			smt_siblings += cpu_topology::to_ranges(core.logical_processors);
+		}
+
+		text += "SMT Siblings:\t\t\t";
+		text += smt_siblings + "\n";
+		text += "Instruction Sets:\t\t";
+		text += cpu_features::summary(_cpu_features_info) + "\n";
+		text += "Features:\t\t\t";
+		text += cpu_features::to_string(_cpu_features_info.features) + "\n";
+		text += "Feature Bits:\t\t\t";
+		text += cpu_features::to_hex(_cpu_features_info.features) + "\n";
 
 		cpu_number++;
 	}
 
+	for (const auto& node : _cpu_topology_info.numa_nodes) {
+		text += "\nNUMA Node " + std::to_string(node.number) + ":\t\t\t";
+		text += "processors " + cpu_topology::to_ranges(node.logical_processors);
+	}
+
 	text += "\n";
 
+	if (!_cache_latency_results.curve.empty()) {
+		text += "\nCache Latency:\t\t\t";
+		text += cache_latency_text() + "\n";
+
+		for (const auto& point : _cache_latency_results.curve) {
+			text += "Working Set " + leccore::format_size(point.size, 0) + ":\t\t";
+			text += leccore::round_off::to_string(point.latency, 2) + "ns\n";
+		}
+
+		std::string core_latency;
+		for (const auto& core : _cache_latency_results.cores) {
+			if (!core_latency.empty())
+				core_latency += ", ";
+
+			core_latency += std::to_string(core.processor) + ": " +
+				leccore::round_off::to_string(core.latency, 2) + "ns";
+
+			if (core.slow)
+				core_latency += " (slow)";
+		}
+
+		text += "Core Latency:\t\t\t";
+		text += core_latency + "\n";
+	}
+
+	if (cpu_benchmark::score(_cpu_benchmark_results, false) > 0.0) {
+		const auto& results = _cpu_benchmark_results;
+
+		auto rate = [](const cpu_benchmark::throughput& throughput) {
+			return leccore::round_off::to_string(throughput.single / 1.e9, 2) + " / " +
+				leccore::round_off::to_string(throughput.all / 1.e9, 2) + " Gops/s";
+		};
+
+		text += "\nThroughput:\t\t\t";
+		text += cpu_benchmark_text() + "\n";
+		text += "Integer:\t\t\t";
+		text += rate(results.integer) + "\n";
+		text += "Floating-point:\t\t\t";
+		text += rate(results.floating_point) + "\n";
+		text += "SIMD (" + results.simd_kernel + "):\t\t\t";
+		text += rate(results.simd) + "\n";
+		text += "Scaling Efficiency:\t\t";
+		text += leccore::round_off::to_string(cpu_benchmark::efficiency(results), 1) + "% per core";
+		text += std::string(cpu_benchmark::poor_scaling(results) ? " (poor)" : "") + ", ";
+		text += leccore::round_off::to_string(cpu_benchmark::thread_efficiency(results), 1) + "% per thread\n";
+	}
+
 	return text;
 }
 
@@ -921,13 +1877,8 @@ std::string main_form::graphics_details_text() {
 		text += "\nMONITOR " + std::to_string(monitor_number);
 		text += "\n-----------\n";
 
-		// get highest supported mode
-		leccore::pc_info::video_mode highest_mode = {};
-
-		for (auto& mode : monitor.supported_modes) {
-			if (highest_mode.horizontal_resolution < mode.horizontal_resolution)
-				highest_mode = mode;
-		}
+		const leccore::pc_info::video_mode highest_mode = monitor_number < static_cast<int>(_monitor_highest_modes.size()) ?
+			_monitor_highest_modes[monitor_number] : leccore::pc_info::video_mode{};
 
 		text += "Name:\t\t\t\t";
 		text += (monitor.manufacturer + monitor.product_code_id) + "\n";
@@ -958,6 +1909,46 @@ std::string main_form::ram_details_text() {
 	text += leccore::format_size(_ram.size) + "\n";
 	text += "Speed:\t\t\t\t";
 	text += std::to_string(_ram.speed) + "MHz" + "\n";
+	text += "Effective Limit:\t\t";
+	text += resource_limits::memory_summary(_resource_limits, _ram.size) + "\n";
+
+	if (_memory_info.total > 0) {
+		text += "In Use:\t\t\t\t";
+		text += leccore::format_size(_memory_info.used) + "\n";
+		text += "Available:\t\t\t";
+		text += leccore::format_size(_memory_info.available) + "\n";
+		text += "Cached:\t\t\t\t";
+		text += leccore::format_size(_memory_info.cached) + "\n";
+		text += "Committed:\t\t\t";
+		text += leccore::format_size(_memory_info.commit_total) + " of " + leccore::format_size(_memory_info.commit_limit) + "\n";
+		text += "Page File:\t\t\t";
+		text += leccore::format_size(_memory_info.page_file_used) + " of " + leccore::format_size(_memory_info.page_file_total) + "\n";
+		text += "Page Faults:\t\t\t";
+		text += leccore::round_off::to_string(_memory_info.page_faults, 0) + "/s (" +
+			leccore::round_off::to_string(_memory_info.page_reads, 0) + "/s hard)\n";
+		text += "Memory Pressure:\t\t";
+		text += memory_usage::to_string(_memory_info.pressure) + "\n";
+	}
+
+	if (_memory_benchmark_results.triad > 0.0) {
+		auto bandwidth = [](double bytes_per_second) {
+			return leccore::round_off::to_string(bytes_per_second / 1.e9, 1) + "GB/s";
+		};
+
+		text += "Copy Bandwidth:\t\t\t";
+		text += bandwidth(_memory_benchmark_results.copy) + "\n";
+		text += "Scale Bandwidth:\t\t";
+		text += bandwidth(_memory_benchmark_results.scale) + "\n";
+		text += "Add Bandwidth:\t\t\t";
+		text += bandwidth(_memory_benchmark_results.add) + "\n";
+		text += "Triad Bandwidth:\t\t";
+		text += bandwidth(_memory_benchmark_results.triad) + "\n";
+		text += "Latency:\t\t\t";
+		text += leccore::round_off::to_string(_memory_benchmark_results.latency, 1) + "ns\n";
+		text += "Benchmark:\t\t\t";
+		text += _memory_benchmark_results.kernel + ", " + std::to_string(_memory_benchmark_results.threads) +
+			std::string(_memory_benchmark_results.threads == 1 ? " thread" : " threads") + "\n";
+	}
 
 	int ram_number = 0;
 	for (const auto& ram : _ram.ram_chips) {
@@ -1013,6 +2004,43 @@ std::string main_form::drive_details_text() {
 		text += "Media Type:\t\t\t";
 		text += drive.media_type + "\n";
 
+		text += "Health:\t\t\t\t";
+		text += drive_health_text(drive) + "\n";
+		text += "Health Trend:\t\t\t";
+		text += drive_health_trend_text(drive) + "\n";
+
+		for (const auto& volume : drive_volumes(drive)) {
+			text += "Volume " + volume.root.substr(0, 2) + "\t\t\t";
+			text += volume_text(volume) + "\n";
+		}
+
+		if (drive_activity(drive)) {
+			text += "Read Activity:\t\t\t";
+			text += read_activity_text(drive) + "\n";
+			text += "Write Activity:\t\t\t";
+			text += write_activity_text(drive) + "\n";
+			text += "Queue:\t\t\t\t";
+			text += queue_activity_text(drive) + "\n";
+		}
+
+		const auto it = _storage_benchmark_results.find(drive_key(drive));
+		if (it != _storage_benchmark_results.end()) {
+			const auto& results = it->second;
+
+			text += "Sequential Read:\t\t";
+			text += leccore::format_size(static_cast<unsigned long long>(results.sequential_read)) + "/s\n";
+			text += "Sequential Write:\t\t";
+			text += leccore::format_size(static_cast<unsigned long long>(results.sequential_write)) + "/s\n";
+			text += "Random 4K Read:\t\t\t";
+			text += leccore::format_size(static_cast<unsigned long long>(results.random_read)) + "/s\n";
+			text += "Random 4K Write:\t\t";
+			text += leccore::format_size(static_cast<unsigned long long>(results.random_write)) + "/s\n";
+			text += "Read Latency:\t\t\t";
+			text += storage_benchmark::to_string(results.read_latency) + "\n";
+			text += "Write Latency:\t\t\t";
+			text += storage_benchmark::to_string(results.write_latency) + "\n";
+		}
+
 		drive_number++;
 	}
 
@@ -1021,6 +2049,539 @@ std::string main_form::drive_details_text() {
 	return text;
 }
 
+std::string main_form::cpu_power_text() {
+	if (_energy_info.channels.empty())
+		return "Not available on this PC";
+
+	return energy_meter::summary(_energy_info);
+}
+
+std::string main_form::power_capture_text() {
+	if (_power_capture_results.samples.empty())
+		return "Not run";
+
+	return power_capture::summary(_power_capture_results);
+}
+
+std::string main_form::energy_use_text() {
+	if (_power.batteries.empty())
+		return "No batteries";
+
+	return energy_accounting::summary(_energy_accounting.get());
+}
+
+bool main_form::show_power_pane(const leccore::pc_info::power_info& power) {
+	// desktops have no batteries but may still report cpu power
+	return !power.batteries.empty() || !_energy_info.channels.empty();
+}
+
+std::string main_form::thermal_details_text() {
+	std::string text;
+	text += "-------------------------------------------------------------------------------\n";
+	text += "THERMAL DETAILS\n";
+	text += "-------------------------------------------------------------------------------\n";
+	text += "Summary:\t\t\t";
+	text += thermal::summary(_thermal_info) + "\n";
+
+	// sensor names vary in length, pad them to the same column as the other labels
+	auto label = [](const std::string& name) {
+		std::string text = name + ":";
+		size_t column = text.size();
+
+		do {
+			text += "\t";
+			column = (column / 8 + 1) * 8;
+		} while (column < 32);
+
+		return text;
+	};
+
+	for (const auto group : { thermal::sensor_group::cpu, thermal::sensor_group::drive, thermal::sensor_group::board }) {
+		bool first = true;
+
+		for (const auto& sensor : _thermal_info.sensors) {
+			if (sensor.group != group)
+				continue;
+
+			if (first) {
+				text += "\n" + thermal::to_string(group);
+				text += "\n-----------\n";
+				first = false;
+			}
+
+			text += label(sensor.name);
+			text += thermal::to_string(sensor) + "\n";
+		}
+	}
+
+	text += "\n";
+
+	return text;
+}
+
+std::string main_form::network_details_text() {
+	std::string text;
+	text += "-------------------------------------------------------------------------------\n";
+	text += "NETWORK DETAILS\n";
+	text += "-------------------------------------------------------------------------------\n";
+	text += "Summary:\t\t\t";
+	text += network::summary(_network_info) + "\n";
+
+	int adapter_number = 0;
+	for (const auto& adapter : _network_info.adapters) {
+		text += "\nAdapter " + std::to_string(adapter_number);
+		text += "\n-----------\n";
+
+		text += "Name:\t\t\t\t";
+		text += adapter.name + "\n";
+		text += "Adapter:\t\t\t";
+		text += adapter.description + "\n";
+		text += "Type:\t\t\t\t";
+		text += adapter.type + "\n";
+		text += "Status:\t\t\t\t";
+		text += std::string(adapter.connected ? "Connected" : "Not connected") + "\n";
+		text += "Link Speed:\t\t\t";
+		text += network::speed_text(adapter.receive_speed);
+
+		if (adapter.transmit_speed != adapter.receive_speed)
+			text += " receive, " + network::speed_text(adapter.transmit_speed) + " transmit";
+
+		text += "\n";
+		text += "MAC Address:\t\t\t";
+		text += adapter.mac + "\n";
+
+		for (const auto& address : adapter.addresses)
+			text += "Address:\t\t\t" + address + "\n";
+
+		text += "Receive:\t\t\t";
+		text += network_traffic_text(adapter.receive_bytes, adapter.receive_packets) + ", " +
+			leccore::format_size(adapter.total_received) + " in total\n";
+		text += "Send:\t\t\t\t";
+		text += network_traffic_text(adapter.send_bytes, adapter.send_packets) + ", " +
+			leccore::format_size(adapter.total_sent) + " in total\n";
+
+		adapter_number++;
+	}
+
+	text += "\n";
+
+	return text;
+}
+
+std::string main_form::network_traffic_text(double bytes, double packets) {
+	return leccore::format_size(static_cast<unsigned long long>(bytes)) + "/s, " +
+		leccore::round_off::to_string(packets, 0) + " packets/s";
+}
+
+std::string main_form::network_addresses_text(const network::adapter_info& adapter) {
+	if (adapter.addresses.empty())
+		return "None";
+
+	std::string text;
+	for (const auto& address : adapter.addresses)
+		text += (text.empty() ? "" : ", ") + address;
+
+	return text;
+}
+
+std::string main_form::current_speed_text() {
+	if (_cpu_frequency_info.cores.empty())
+		return std::string();
+
+	// averaged over every logical processor in the system, not just this package
+	std::string text = leccore::round_off::to_string(_cpu_frequency_info.average_mhz / 1000.0, 2) + "GHz now system-wide";
+
+	if (_cpu_frequency_info.throttled_cores > 0)
+		text += ", " + std::to_string(_cpu_frequency_info.throttled_cores) + " of " +
+		std::to_string(_cpu_frequency_info.cores.size()) +
+		std::string(_cpu_frequency_info.cores.size() == 1 ? " core throttled" : " cores throttled");
+	else
+		text += ", not throttled";
+
+	return text;
+}
+
+std::string main_form::memory_benchmark_text() {
+	if (_memory_benchmark_results.triad <= 0.0)
+		return "Measure actual bandwidth and latency";
+
+	return leccore::round_off::to_string(_memory_benchmark_results.triad / 1.e9, 1) + "GB/s triad, " +
+		leccore::round_off::to_string(_memory_benchmark_results.copy / 1.e9, 1) + "GB/s copy, " +
+		leccore::round_off::to_string(_memory_benchmark_results.latency, 0) + "ns latency";
+}
+
+std::string main_form::cache_latency_text() {
+	if (_cache_latency_results.levels.empty())
+		return "Measure L1/L2/L3/DRAM latency";
+
+	return cache_latency_probe::summary(_cache_latency_results);
+}
+
+std::string main_form::cpu_benchmark_text() {
+	if (cpu_benchmark::score(_cpu_benchmark_results, false) <= 0.0)
+		return "Measure single and all-thread throughput";
+
+	return cpu_benchmark::summary(_cpu_benchmark_results);
+}
+
+std::string main_form::hardware_counters_text() {
+	if (_hardware_counters.running())
+		return hardware_counters::summary(_hardware_counters_info);
+
+	if (!_hardware_counters_error.empty())
+		return _hardware_counters_error;
+
+	std::string reason;
+	if (!hardware_counters::permitted(reason))
+		return reason;
+
+	return "Measure instructions per cycle, cache and branch misses";
+}
+
+std::string main_form::storage_benchmark_text(const leccore::pc_info::drive_info& drive) {
+	const auto it = _storage_benchmark_results.find(drive_key(drive));
+
+	if (it == _storage_benchmark_results.end())
+		return "Measure read and write throughput and latency";
+
+	return storage_benchmark::summary(it->second) + ", p99 " +
+		leccore::round_off::to_string(it->second.read_latency.p99, 0) + "us";
+}
+
+void main_form::sample_disk_activity() {
+	std::vector<unsigned long> disk_numbers;
+	for (const auto& disk : _disks)
+		disk_numbers.push_back(disk.number);
+
+	std::string error;
+	if (!_disk_activity.read(disk_numbers, _disk_activity_info, error)) {}
+}
+
+std::string main_form::drive_health_text(const leccore::pc_info::drive_info& drive) {
+	const auto it = _drive_health.find(drive_key(drive));
+
+	if (it == _drive_health.end())
+		return "Not available";
+
+	return drive_health::summary(it->second);
+}
+
+std::string main_form::drive_health_trend_text(const leccore::pc_info::drive_info& drive) {
+	const auto it = _drive_health_series.find(drive_key(drive));
+
+	if (it == _drive_health_series.end())
+		return std::string();
+
+	return drive_health::trend(it->second);
+}
+
+std::string main_form::battery_wear_text(const leccore::pc_info::battery_info& battery) {
+	const auto it = _battery_wear_series.find(battery_key(battery));
+
+	if (it == _battery_wear_series.end())
+		return std::string();
+
+	const long long now = static_cast<long long>(std::time(nullptr));
+	return battery_wear::to_string(battery_wear::project(it->second, now), now);
+}
+
+lecui::color main_form::drive_health_color(const leccore::pc_info::drive_info& drive) {
+	if (!drive_health_ok(drive))
+		return _not_ok_color;
+
+	return _drive_health.count(drive_key(drive)) ? _ok_color : _caption_color;
+}
+
+lecui::color main_form::thermal_color(const thermal::sensor& sensor) {
+	if (sensor.critical_reached())
+		return _not_ok_color;
+
+	return sensor.critical > 0.0 ? _ok_color : _caption_color;
+}
+
+void main_form::thermal_alert() {
+	std::string sensors;
+
+	for (const auto& sensor : _thermal_info.sensors) {
+		const auto alerted = std::find(_thermal_alerts.begin(), _thermal_alerts.end(), sensor.name);
+
+		if (sensor.critical_reached()) {
+			// alert once per crossing, not on every refresh
+			if (alerted == _thermal_alerts.end()) {
+				_thermal_alerts.push_back(sensor.name);
+
+				if (!sensors.empty())
+					sensors += "\n";
+
+				sensors += sensor.name + ": " + thermal::to_string(sensor);
+			}
+		}
+		else if (alerted != _thermal_alerts.end() && sensor.temperature < sensor.critical - 5.0)
+			_thermal_alerts.erase(alerted);
+	}
+
+	if (!sensors.empty())
+		thermal::alert(appname, "Critical temperature reached\n\n" + sensors);
+}
+
+bool main_form::drive_health_ok(const leccore::pc_info::drive_info& drive) {
+	const auto health = _drive_health.find(drive_key(drive));
+	if (health != _drive_health.end() && health->second.critical_warning)
+		return false;
+
+	const auto series = _drive_health_series.find(drive_key(drive));
+	if (series != _drive_health_series.end() && drive_health::degrading(series->second))
+		return false;
+
+	return true;
+}
+
+void main_form::read_volume_usage() {
+	std::string error;
+	if (!_volume_usage.read(_disks, _volumes, error)) {}
+}
+
+std::vector<volume_usage::volume_info> main_form::drive_volumes(const leccore::pc_info::drive_info& drive) {
+	std::vector<volume_usage::volume_info> volumes;
+
+	disk_map::disk disk;
+	if (!disk_map::find(_disks, drive.model, drive.serial_number, drive.size, disk))
+		return volumes;
+
+	for (const auto& volume : _volumes)
+		for (const auto& root : disk.volumes)
+			if (volume.root == root)
+				volumes.push_back(volume);
+
+	return volumes;
+}
+
+std::string main_form::volume_usage_text(const leccore::pc_info::drive_info& drive) {
+	std::string text;
+
+	for (const auto& volume : drive_volumes(drive)) {
+		if (!text.empty())
+			text += "\n";
+
+		text += volume.root.substr(0, 2) + " " + volume_text(volume);
+	}
+
+	return text.empty() ? "No volumes" : text;
+}
+
+std::string main_form::volume_text(const volume_usage::volume_info& volume) {
+	std::string text = leccore::format_size(volume.free) + " free of " + leccore::format_size(volume.total);
+
+	if (volume.time_to_full > 0.0)
+		text += ", full in about " + volume_usage::to_string(volume.time_to_full);
+
+	return text;
+}
+
+const disk_activity::disk_counters* main_form::drive_activity(const leccore::pc_info::drive_info& drive) {
+	disk_map::disk disk;
+	if (!disk_map::find(_disks, drive.model, drive.serial_number, drive.size, disk))
+		return nullptr;
+
+	return _disk_activity_info.find(disk.number);
+}
+
+std::string main_form::read_activity_text(const leccore::pc_info::drive_info& drive) {
+	const auto counters = drive_activity(drive);
+	if (!counters)
+		return "N/A";
+
+	return leccore::format_size(static_cast<unsigned long long>(counters->read_bytes)) + "/s, " +
+		leccore::round_off::to_string(counters->read_iops, 0) + " IOPS";
+}
+
+std::string main_form::write_activity_text(const leccore::pc_info::drive_info& drive) {
+	const auto counters = drive_activity(drive);
+	if (!counters)
+		return "N/A";
+
+	return leccore::format_size(static_cast<unsigned long long>(counters->write_bytes)) + "/s, " +
+		leccore::round_off::to_string(counters->write_iops, 0) + " IOPS";
+}
+
+std::string main_form::queue_activity_text(const leccore::pc_info::drive_info& drive) {
+	const auto counters = drive_activity(drive);
+	if (!counters)
+		return "N/A";
+
+	return std::to_string(counters->queue_depth) + ", " +
+		leccore::round_off::to_string(counters->busy, 0) + "% busy";
+}
+
+std::string main_form::drive_key(const leccore::pc_info::drive_info& drive) {
+	// drive numbers change when drives come and go, model and serial number do not
+	return drive.model + "|" + drive.serial_number;
+}
+
+std::string main_form::battery_key(const leccore::pc_info::battery_info& battery) {
+	// there is no battery serial number, the designed capacity tells same-named batteries apart
+	return battery.manufacturer + "|" + battery.name + "|" + std::to_string(battery.designed_capacity);
+}
+
+std::string main_form::memory_usage_text() {
+	if (_memory_info.total == 0)
+		return "Memory usage not available";
+
+	return leccore::format_size(_memory_info.used) + " in use, " +
+		leccore::format_size(_memory_info.available) + " available, " +
+		leccore::format_size(_memory_info.cached) + " cached";
+}
+
+std::string main_form::memory_paging_text() {
+	if (_memory_info.total == 0)
+		return std::string();
+
+	std::string text;
+
+	if (_memory_info.page_file_total > 0)
+		text += "Page file " + leccore::format_size(_memory_info.page_file_used) + " of " +
+		leccore::format_size(_memory_info.page_file_total) + ", ";
+
+	text += leccore::round_off::to_string(_memory_info.page_faults, 0) + " faults/s (" +
+		leccore::round_off::to_string(_memory_info.page_reads, 0) + " hard), " +
+		memory_usage::to_string(_memory_info.pressure) + " pressure";
+
+	return text;
+}
+
+std::vector<lecui::point> main_form::memory_usage_curve(float width, float height) {
+	const auto& history = _memory_usage.history();
+	std::vector<lecui::point> points;
+
+	// plot against the full 0 - 100% range so a steady machine shows a steady line
+	for (size_t i = 0; i < history.size(); i++) {
+		const float x = width * static_cast<float>(i) / static_cast<float>(memory_usage::history_size - 1);
+		const float y = height - height * static_cast<float>(history[i] / 100.0);
+		points.push_back({ x, y });
+	}
+
+	if (points.size() < 2) {
+		points.clear();
+		points.push_back({ 0.f, height });
+		points.push_back({ width, height });
+	}
+
+	return points;
+}
+
+void main_form::record_battery_telemetry(const leccore::pc_info::power_info& power) {
+	// batteries are identified by position, start afresh when they come and go
+	if (_battery_telemetry.size() != power.batteries.size()) {
+		_battery_telemetry.assign(power.batteries.size(), battery_telemetry());
+		_battery_estimator.reset();
+	}
+
+	const long long now = static_cast<long long>(std::time(nullptr));
+
+	// the estimator works on all the batteries together
+	double capacity = 0.0, full_capacity = 0.0, charge_rate = 0.0;
+	bool capacity_known = !power.batteries.empty();
+
+	for (size_t battery_number = 0; battery_number < power.batteries.size(); battery_number++) {
+		const auto& battery = power.batteries[battery_number];
+
+		// unknown readings are reported as -1
+		battery_telemetry::sample sample;
+		sample.time = now;
+		sample.level = battery.level;
+		sample.charge_rate = battery.current_charge_rate;
+		sample.voltage = battery.current_voltage == -1 ? 0.0 : battery.current_voltage;
+		sample.capacity = battery.current_capacity == -1 ? 0.0 : battery.current_capacity;
+		_battery_telemetry[battery_number].add(sample);
+
+		if (battery.current_capacity == -1 || battery.fully_charged_capacity == -1)
+			capacity_known = false;
+
+		capacity += battery.current_capacity;
+		full_capacity += battery.fully_charged_capacity;
+		charge_rate += battery.current_charge_rate;
+	}
+
+	if (capacity_known)
+		_battery_estimator.add(now, capacity, full_capacity, charge_rate);
+}
+
+std::string main_form::time_remaining_text() {
+	// prefer the smoothed estimate, the figure from the OS jumps around
+	const auto estimate = _battery_estimator.get();
+
+	if (estimate.valid)
+		return battery_estimator::to_string(estimate);
+
+	return _power.lifetime_remaining.empty() ? std::string() : (_power.lifetime_remaining + " remaining");
+}
+
+std::string main_form::tray_text() {
+	std::string text = std::string(appname) + " " +
+		std::string(appversion) + " (" + std::string(architecture) + ")";
+
+	const auto estimate = _battery_estimator.get();
+
+	if (estimate.valid)
+		text += "\n" + battery_estimator::to_string(estimate);
+
+	const auto critical = _thermal_info.critical_sensors();
+	if (critical > 0)
+		text += "\nCritical temperature on " + std::to_string(critical) + (critical == 1 ? " sensor" : " sensors");
+
+	return text;
+}
+
+std::vector<lecui::point> main_form::battery_curve(size_t battery_number,
+	battery_telemetry::field which, float width, float height) {
+	if (battery_number >= _battery_telemetry.size())
+		return sparkline({}, width, height, false);
+
+	return sparkline(battery_telemetry::values(_battery_telemetry[battery_number].series(), which),
+		width, height, false);
+}
+
+std::vector<lecui::point> main_form::cache_latency_curve(float width, float height) {
+	std::vector<double> latencies;
+	for (const auto& point : _cache_latency_results.curve)
+		latencies.push_back(point.latency);
+
+	// latencies span two orders of magnitude, plot them on a log scale
+	return sparkline(latencies, width, height, true);
+}
+
+std::vector<lecui::point> main_form::sparkline(const std::vector<double>& values,
+	float width, float height, bool log_scale) {
+	std::vector<lecui::point> points;
+
+	if (values.size() < 2) {
+		// flat baseline until there is something to plot
+		points.push_back({ 0.f, height });
+		points.push_back({ width, height });
+		return points;
+	}
+
+	auto scale = [&](double value) {
+		return log_scale ? std::log10(std::max(value, 1.e-9)) : value;
+	};
+
+	double lowest = scale(values.front()), highest = lowest;
+	for (const auto& value : values) {
+		lowest = std::min(lowest, scale(value));
+		highest = std::max(highest, scale(value));
+	}
+
+	const double range = highest > lowest ? highest - lowest : 1.0;
+
+	for (size_t i = 0; i < values.size(); i++) {
+		const float x = width * static_cast<float>(i) / static_cast<float>(values.size() - 1);
+		const float y = height - height * static_cast<float>((scale(values[i]) - lowest) / range);
+		points.push_back({ x, y });
+	}
+
+	return points;
+}
+
 main_form::main_form(const std::string& caption, bool restarted) :
 	_cleanup_mode(restarted ? false : leccore::commandline_arguments::contains("/cleanup")),
 	_update_mode(restarted ? false : leccore::commandline_arguments::contains("/update")),
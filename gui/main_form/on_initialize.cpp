@@ -321,15 +321,52 @@ bool main_form::on_initialize(std::string& error) {
 		if (!reg.do_delete("Software\\Microsoft\\Windows\\CurrentVersion\\Run", "pc_info", error)) {}
 	}
 
-	// read pc, power, cpu, gpu, memory and drive info
-	_pc_info.pc(_pc_details, error);
+	// read pc and memory details from the smbios table, falling back to the management queries
+	if (!read_smbios()) {
+		_pc_info.pc(_pc_details, error);
+		_pc_info.ram(_ram, error);
+	}
+
+	// read power, cpu, gpu, monitor and drive info
 	_pc_info.power(_power, error);
 	_pc_info.cpu(_cpus, error);
 	_pc_info.gpu(_gpus, error);
-	_pc_info.monitor(_monitors, error);
-	_pc_info.ram(_ram, error);
+	if (!read_monitors()) {
+		_pc_info.monitor(_monitors, error);
+		index_monitor_modes();
+	}
 	_pc_info.drives(_drives, error);
 
+	// read cpu topology, instruction-set features and current cpu frequency
+	_cpu_topology.read(_cpu_topology_info, error);
+	_cpu_features.read(_cpu_features_info, error);
+	_cpu_frequency.read(_cpu_frequency_info, error);
+
+	// read the cpu and memory limits of the job or container this process runs in
+	resource_limits::read(_resource_limits, error);
+
+	// start the battery telemetry history and add today's sample to the wear history
+	record_battery_telemetry(_power);
+	read_battery_wear();
+
+	// find the hardware energy meters and prime their counters
+	_energy_meter.read(_energy_info, error);
+
+	// read current memory usage, this also primes the paging rates
+	_memory_usage.read(_memory_info, error);
+
+	// map drives to physical disks, prime the disk activity counters, read volume usage and drive health
+	disk_map::read(_disks, error);
+	sample_disk_activity();
+	read_volume_usage();
+	read_drive_health();
+
+	// read all temperature sensors, including the drives just mapped
+	_thermal.read(_disks, _thermal_info, error);
+
+	// list the network adapters and prime their traffic counters
+	_network.read(_network_info, error);
+
 	// set colors that are theme dependent
 	_caption_color = lecui::defaults::color(_setting_darktheme ?
 		lecui::themes::dark : lecui::themes::light, lecui::element::icon_description_text);
@@ -346,7 +383,7 @@ bool main_form::on_initialize(std::string& error) {
 
 	float form_width = 1120.f;
 
-	if (_power.batteries.empty())
+	if (!show_power_pane(_power))
 		form_width -= (270.f + _margin);
 
 	_dim.set_size(lecui::size().width(form_width).height(600.f));
@@ -355,6 +392,8 @@ bool main_form::on_initialize(std::string& error) {
 	_form_menu.add("  ", "Settings and more", {
 		{ "Copy all info", [this]() { copy_pc_info(); } },
 		{ "Export all info", [this]() { export_pc_info(); } },
+		{ "Top processes", [this]() { processes(); } },
+		{ "Thermal and network", [this]() { sensors(); } },
 		{ "" },
 		{ "Settings", [this]() { settings(); } },
 		{ "Updates", [this]() { updates(); } },
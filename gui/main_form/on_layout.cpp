@@ -30,6 +30,7 @@
 #include <liblec/lecui/containers/tab_pane.h>
 
 #include <liblec/lecui/widgets/label.h>
+#include <liblec/lecui/widgets/button.h>
 #include <liblec/lecui/widgets/progress_bar.h>
 #include <liblec/lecui/widgets/progress_indicator.h>
 #include <liblec/lecui/widgets/line.h>
@@ -54,9 +55,11 @@ bool main_form::on_layout(std::string& error) {
 	add_pc_details_pane();
 
 	// 2. Add power details
-	if (!_power.batteries.empty()) {
+	if (show_power_pane(_power)) {
 		add_power_pane();
-		add_battery_pane();
+
+		if (!_power.batteries.empty())
+			add_battery_pane();
 	}
 
 	// 3. Add cpu details
@@ -360,12 +363,80 @@ void main_form::add_power_pane() {
 	// add life remaining label
 	auto& life_remaining = lecui::widgets::label::add(power_pane, "life_remaining");
 	life_remaining
-		.text(_power.lifetime_remaining.empty() ? std::string() : (_power.lifetime_remaining + " remaining"))
+		.text(time_remaining_text())
 		.color_text(_caption_color)
 		.font_size(_caption_font_size)
 		.rect(level_bar.rect())
 		.rect().height(caption_height).snap_to(level_bar.rect(), snap_type::bottom, _margin / 2.f);
 
+	// add cpu power from the hardware energy counters
+	auto& cpu_power_caption = lecui::widgets::label::add(power_pane);
+	cpu_power_caption
+		.text("CPU Power")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(life_remaining.rect())
+		.rect().snap_to(life_remaining.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& cpu_power = lecui::widgets::label::add(power_pane, "cpu_power");
+	cpu_power
+		.text(cpu_power_text())
+		.font_size(_caption_font_size)
+		.rect(cpu_power_caption.rect())
+		.rect().snap_to(cpu_power_caption.rect(), snap_type::bottom, 0.f);
+
+	// add battery energy used this session
+	auto& energy_use_caption = lecui::widgets::label::add(power_pane);
+	energy_use_caption
+		.text("Battery Energy This Session")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(cpu_power.rect())
+		.rect().snap_to(cpu_power.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& energy_use = lecui::widgets::label::add(power_pane, "energy_use");
+	energy_use
+		.text(energy_use_text())
+		.font_size(_caption_font_size)
+		.rect(energy_use_caption.rect())
+		.rect().snap_to(energy_use_caption.rect(), snap_type::bottom, 0.f);
+
+	// add high frequency power capture
+	auto& power_capture_caption = lecui::widgets::label::add(power_pane);
+	power_capture_caption
+		.text("Power Capture")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(energy_use.rect())
+		.rect().snap_to(energy_use.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& power_capture_button = lecui::widgets::button::add(power_pane, "power_capture_button");
+	power_capture_button
+		.text("Run")
+		.tooltip("Sample battery and CPU package power every 20ms for 30 seconds, then save the samples")
+		.rect(power_capture_caption.rect())
+		.rect().width(60.f).height(20.f).snap_to(power_capture_caption.rect(), snap_type::bottom_left, 0.f);
+	power_capture_button.events().action = [this]() { start_power_capture(); };
+
+	auto& power_capture_summary = lecui::widgets::label::add(power_pane, "power_capture");
+	power_capture_summary
+		.text(power_capture_text())
+		.font_size(_caption_font_size)
+		.paragraph_alignment(lecui::paragraph_alignment::middle)
+		.rect(power_capture_button.rect())
+		.rect().width(power_capture_caption.rect().width() - power_capture_button.rect().width() - _margin)
+		.snap_to(power_capture_button.rect(), snap_type::right, _margin);
+
+	auto& power_capture_plot = lecui::widgets::line::add(power_pane, "power_capture_plot");
+	power_capture_plot
+		.rect(power_capture_caption.rect())
+		.rect().height(20.f).snap_to(power_capture_button.rect(), snap_type::bottom_left, _margin / 2.f);
+	power_capture_plot
+		.points(sparkline(power_capture::plot_values(_power_capture_results),
+			power_capture_plot.rect().width(), power_capture_plot.rect().height(), false))
+		.tooltip("Power over the last capture, package power if available, else battery discharge")
+		.thickness(1.f);
+
 	// add copy details icon
 	auto& copy = lecui::widgets::image_view::add(power_pane, "copy");
 	copy
@@ -406,13 +477,13 @@ void main_form::add_power_pane() {
 
 void main_form::add_battery_pane() {
 	auto& power_pane = get_pane("home/power_pane");
-	auto& life_remaining = get_label("home/power_pane/life_remaining");
+	auto& power_capture_plot = get_line("home/power_pane/power_capture_plot");
 
 	// add pane for battery details
 	auto& battery_tab_pane = lecui::containers::tab_pane::add(power_pane, "battery_tab_pane");
 	battery_tab_pane
 		.tab_side(lecui::containers::tab_pane::side::top)
-		.rect({ 0.f, power_pane.size().get_width(), life_remaining.rect().bottom(), power_pane.size().get_height() });
+		.rect({ 0.f, power_pane.size().get_width(), power_capture_plot.rect().bottom(), power_pane.size().get_height() });
 	battery_tab_pane.color_tabs().alpha(0);
 	battery_tab_pane.color_tabs_border().alpha(0);
 
@@ -477,8 +548,18 @@ void main_form::add_battery_pane() {
 			.percentage(static_cast<float>(battery.health))
 			.rect().snap_to(health_caption.rect(), snap_type::bottom, _margin);
 
+		// add when the battery is projected to need replacement
+		auto& wear_projection = lecui::widgets::label::add(battery_pane, "wear_projection");
+		wear_projection
+			.text(battery_wear_text(battery))
+			.alignment(lecui::text_alignment::center)
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(health_caption.rect())
+			.rect().snap_to(health.rect(), snap_type::bottom, _margin / 2.f);
+
 		lecui::rect ref = seperator_1.rect();
-		ref.snap_to(health.rect(), snap_type::bottom, 0.f);
+		ref.snap_to(wear_projection.rect(), snap_type::bottom, 0.f);
 
 		// add battery designed capacity
 		auto& designed_capacity_caption = lecui::widgets::label::add(battery_pane);
@@ -545,6 +626,15 @@ void main_form::add_battery_pane() {
 			.rect(current_capacity_caption.rect())
 			.rect().height(detail_height).snap_to(current_capacity_caption.rect(), snap_type::bottom, 0.f);
 
+		auto& capacity_history = lecui::widgets::line::add(battery_pane, "capacity_history");
+		capacity_history
+			.rect(current_capacity.rect())
+			.rect().height(16.f).width(current_capacity.rect().width() - _margin).snap_to(current_capacity.rect(), snap_type::bottom_left, 0.f);
+		capacity_history
+			.points(battery_curve(battery_number, battery_telemetry::field::capacity, capacity_history.rect().width(), capacity_history.rect().height()))
+			.tooltip("Capacity history, older data at lower resolution")
+			.thickness(1.f);
+
 		// add battery fully charged capacity
 		auto& charge_level_caption = lecui::widgets::label::add(battery_pane);
 		charge_level_caption
@@ -561,6 +651,15 @@ void main_form::add_battery_pane() {
 			.rect(charge_level_caption.rect())
 			.rect().height(detail_height).snap_to(charge_level_caption.rect(), snap_type::bottom, 0.f);
 
+		auto& level_history = lecui::widgets::line::add(battery_pane, "level_history");
+		level_history
+			.rect(capacity_history.rect())
+			.rect().snap_to(charge_level.rect(), snap_type::bottom_left, 0.f);
+		level_history
+			.points(battery_curve(battery_number, battery_telemetry::field::level, level_history.rect().width(), level_history.rect().height()))
+			.tooltip("Charge level history, older data at lower resolution")
+			.thickness(1.f);
+
 		// add battery current voltage
 		auto& current_voltage_caption = lecui::widgets::label::add(battery_pane);
 		current_voltage_caption
@@ -568,7 +667,7 @@ void main_form::add_battery_pane() {
 			.color_text(_caption_color)
 			.font_size(_caption_font_size)
 			.rect(battery_name_caption.rect())
-			.rect().width(battery_pane.size().get_width() / 2.f).snap_to(current_capacity.rect(), snap_type::bottom_left, _margin);
+			.rect().width(battery_pane.size().get_width() / 2.f).snap_to(capacity_history.rect(), snap_type::bottom_left, _margin);
 
 		auto& current_voltage = lecui::widgets::label::add(battery_pane, "current_voltage");
 		current_voltage
@@ -581,6 +680,15 @@ void main_form::add_battery_pane() {
 			.rect().height(detail_height)
 			.snap_to(current_voltage_caption.rect(), snap_type::bottom, 0.f);
 
+		auto& voltage_history = lecui::widgets::line::add(battery_pane, "voltage_history");
+		voltage_history
+			.rect(capacity_history.rect())
+			.rect().snap_to(current_voltage.rect(), snap_type::bottom_left, 0.f);
+		voltage_history
+			.points(battery_curve(battery_number, battery_telemetry::field::voltage, voltage_history.rect().width(), voltage_history.rect().height()))
+			.tooltip("Voltage history, older data at lower resolution")
+			.thickness(1.f);
+
 		// add battery current charge rate
 		auto& charge_rate_caption = lecui::widgets::label::add(battery_pane);
 		charge_rate_caption
@@ -599,6 +707,15 @@ void main_form::add_battery_pane() {
 			.rect(charge_rate_caption.rect())
 			.rect().height(detail_height).snap_to(charge_rate_caption.rect(), snap_type::bottom, 0.f);
 
+		auto& rate_history = lecui::widgets::line::add(battery_pane, "rate_history");
+		rate_history
+			.rect(capacity_history.rect())
+			.rect().snap_to(charge_rate.rect(), snap_type::bottom_left, 0.f);
+		rate_history
+			.points(battery_curve(battery_number, battery_telemetry::field::charge_rate, rate_history.rect().width(), rate_history.rect().height()))
+			.tooltip("Charge rate history, older data at lower resolution")
+			.thickness(1.f);
+
 		// add battery status
 		auto& status_caption = lecui::widgets::label::add(battery_pane);
 		status_caption
@@ -606,7 +723,7 @@ void main_form::add_battery_pane() {
 			.color_text(_caption_color)
 			.font_size(_caption_font_size)
 			.rect(battery_name_caption.rect())
-			.rect().width(battery_pane.size().get_width()).snap_to(current_voltage.rect(), snap_type::bottom, _margin);
+			.rect().width(battery_pane.size().get_width()).snap_to(voltage_history.rect(), snap_type::bottom_left, _margin);
 
 		auto& status = lecui::widgets::label::add(battery_pane, "status");
 		status
@@ -708,7 +825,7 @@ void main_form::add_cpu_tab_pane() {
 	auto& cpu_pane = get_pane("home/cpu_pane");
 	auto& cpu_title = get_label("home/cpu_pane/cpu_title");
 
-	auto& cpu_tab_pane = lecui::containers::tab_pane::add(cpu_pane);
+	auto& cpu_tab_pane = lecui::containers::tab_pane::add(cpu_pane, "cpu_tab_pane");
 	cpu_tab_pane.tab_side(lecui::containers::tab_pane::side::top);
 	cpu_tab_pane.rect()
 		.left(0.f)
@@ -765,6 +882,16 @@ void main_form::add_cpu_tab_pane() {
 			.rect(status.rect())
 			.rect().width(3.f * cpu_pane.size().get_width() / 4.f).height(highlight_height).snap_to(status.rect(), snap_type::right_bottom, 0.f);
 
+		// add current speed
+		auto& current_speed = lecui::widgets::label::add(cpu_pane, "current_speed");
+		current_speed
+			.text(current_speed_text())
+			.tooltip("Effective clock speed averaged over all logical processors in the system")
+			.color_text(_cpu_frequency_info.throttled_cores > 0 ? _not_ok_color : _caption_color)
+			.font_size(_caption_font_size)
+			.rect(base_speed.rect())
+			.rect().height(caption_height).snap_to(base_speed.rect(), snap_type::bottom, 0.f);
+
 		// add cpu cores
 		auto& cores = lecui::widgets::label::add(cpu_pane);
 		cores
@@ -776,11 +903,208 @@ void main_form::add_cpu_tab_pane() {
 				"<span style = 'font-size: 8.0pt;'>" +
 				std::string(cpu.cores == 1 ? " logical processor" : " logical processors") + "</span>")
 			.rect(cpu_name_caption.rect())
-			.rect().height(highlight_height).snap_to(status.rect(), snap_type::bottom_right, _margin);
+			.rect().height(highlight_height).snap_to(current_speed.rect(), snap_type::bottom_right, _margin);
 
 		cpu_number++;
 	}
 
+	// packages on the same board match, so the first is shown and every package is in the tooltip
+	auto package_text = [&](std::string(*summary)(const cpu_topology::topology_info&, size_t)) {
+		std::string text;
+		for (size_t package = 0; package < _cpus.size(); package++) {
+			if (!text.empty())
+				text += "\n";
+			text += "CPU " + std::to_string(package) + ": " + summary(_cpu_topology_info, package);
+		}
+		return text;
+	};
+
+	// add cpu details
+	auto& details_pane = lecui::containers::tab::add(cpu_tab_pane, "Details");
+
+	auto& cache_caption = lecui::widgets::label::add(details_pane);
+	cache_caption
+		.text("Cache")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect({ 0.f, details_pane.size().get_width(), 0.f, caption_height });
+
+	auto& cache = lecui::widgets::label::add(details_pane);
+	cache
+		.text(cpu_topology::cache_summary(_cpu_topology_info, 0))
+		.font_size(_caption_font_size)
+		.rect(cache_caption.rect())
+		.rect().snap_to(cache_caption.rect(), snap_type::bottom, 0.f);
+
+	if (_cpus.size() > 1)
+		cache.tooltip(package_text(cpu_topology::cache_summary));
+
+	// add topology
+	auto& topology_caption = lecui::widgets::label::add(details_pane);
+	topology_caption
+		.text("Topology")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(cache_caption.rect())
+		.rect().snap_to(cache.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& topology = lecui::widgets::label::add(details_pane);
+	topology
+		.text(cpu_topology::layout_summary(_cpu_topology_info, 0))
+		.font_size(_caption_font_size)
+		.rect(topology_caption.rect())
+		.rect().snap_to(topology_caption.rect(), snap_type::bottom, 0.f);
+
+	if (_cpus.size() > 1)
+		topology.tooltip(package_text(cpu_topology::layout_summary));
+
+	// add effective limit, the share of the hardware this process can actually use
+	auto& limit_caption = lecui::widgets::label::add(details_pane);
+	limit_caption
+		.text("Effective Limit")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(topology_caption.rect())
+		.rect().snap_to(topology.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& limit = lecui::widgets::label::add(details_pane);
+	limit
+		.text(resource_limits::cpu_summary(_resource_limits))
+		.font_size(_caption_font_size)
+		.rect(limit_caption.rect())
+		.rect().snap_to(limit_caption.rect(), snap_type::bottom, 0.f);
+
+	// add instruction-set features
+	auto& features_caption = lecui::widgets::label::add(details_pane);
+	features_caption
+		.text("Instruction Sets")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(limit_caption.rect())
+		.rect().snap_to(limit.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& features = lecui::widgets::label::add(details_pane);
+	features
+		.text(cpu_features::summary(_cpu_features_info))
+		.tooltip(cpu_features::to_string(_cpu_features_info.features))
+		.font_size(_caption_font_size)
+		.rect(features_caption.rect())
+		.rect().snap_to(features_caption.rect(), snap_type::bottom, 0.f);
+
+	// add cpu benchmarks
+	auto& benchmarks_pane = lecui::containers::tab::add(cpu_tab_pane, "Benchmarks");
+
+	// add cache latency probe
+	auto& latency_caption = lecui::widgets::label::add(benchmarks_pane);
+	latency_caption
+		.text("Cache Latency")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect({ 0.f, benchmarks_pane.size().get_width(), 0.f, caption_height });
+
+	auto& latency_button = lecui::widgets::button::add(benchmarks_pane, "latency_button");
+	latency_button
+		.text("Probe")
+		.tooltip("Measure the effective latency of each cache level")
+		.rect(latency_caption.rect())
+		.rect().width(60.f).height(20.f).snap_to(latency_caption.rect(), snap_type::bottom_left, 0.f);
+	latency_button.events().action = [this]() { start_cache_latency_probe(); };
+
+	auto& latency = lecui::widgets::label::add(benchmarks_pane, "latency");
+	latency
+		.text(cache_latency_text())
+		.font_size(_caption_font_size)
+		.paragraph_alignment(lecui::paragraph_alignment::middle)
+		.rect(latency_button.rect())
+		.rect().width(benchmarks_pane.size().get_width() - latency_button.rect().width() - _margin)
+		.snap_to(latency_button.rect(), snap_type::right, _margin);
+
+	auto& latency_curve = lecui::widgets::line::add(benchmarks_pane, "latency_curve");
+	latency_curve
+		.rect(latency_caption.rect())
+		.rect().height(40.f).snap_to(latency_button.rect(), snap_type::bottom_left, _margin / 2.f);
+	latency_curve
+		.points(cache_latency_curve(latency_curve.rect().width(), latency_curve.rect().height()))
+		.tooltip("Latency vs working set size, 4KB to 128MB")
+		.thickness(1.f);
+
+	// add cpu throughput benchmark
+	auto& throughput_caption = lecui::widgets::label::add(benchmarks_pane);
+	throughput_caption
+		.text("Throughput")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(latency_caption.rect())
+		.rect().snap_to(latency_curve.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& throughput_button = lecui::widgets::button::add(benchmarks_pane, "throughput_button");
+	throughput_button
+		.text("Run")
+		.tooltip("Measure integer, floating-point and SIMD throughput on one and on all threads")
+		.rect(latency_button.rect())
+		.rect().snap_to(throughput_caption.rect(), snap_type::bottom_left, 0.f);
+	throughput_button.events().action = [this]() { start_cpu_benchmark(); };
+
+	auto& throughput = lecui::widgets::label::add(benchmarks_pane, "throughput");
+	throughput
+		.text(cpu_benchmark_text())
+		.font_size(_caption_font_size)
+		.paragraph_alignment(lecui::paragraph_alignment::middle)
+		.rect(latency.rect())
+		.rect().snap_to(throughput_button.rect(), snap_type::right, _margin);
+
+	// add cpu activity
+	auto& activity_pane = lecui::containers::tab::add(cpu_tab_pane, "Activity");
+
+	// add interrupt and dpc activity, and the cores taking more than their share of it
+	auto& interrupts_caption = lecui::widgets::label::add(activity_pane);
+	interrupts_caption
+		.text("Interrupts")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect({ 0.f, activity_pane.size().get_width(), 0.f, caption_height });
+
+	auto& interrupts = lecui::widgets::label::add(activity_pane, "interrupts");
+	interrupts
+		.text(interrupt_activity::summary(_interrupt_info))
+		.font_size(_caption_font_size)
+		.rect(interrupts_caption.rect())
+		.rect().snap_to(interrupts_caption.rect(), snap_type::bottom, 0.f);
+
+	auto& interrupt_hot_spots = lecui::widgets::label::add(activity_pane, "interrupt_hot_spots");
+	interrupt_hot_spots
+		.text(interrupt_activity::hot_spot_text(_interrupt_info))
+		.color_text(_interrupt_info.hot_spots.empty() ? _caption_color : _not_ok_color)
+		.font_size(_caption_font_size)
+		.rect(interrupts.rect())
+		.rect().snap_to(interrupts.rect(), snap_type::bottom, 0.f);
+
+	// add hardware performance counters
+	auto& counters_caption = lecui::widgets::label::add(activity_pane);
+	counters_caption
+		.text("Performance Counters")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(interrupts_caption.rect())
+		.rect().snap_to(interrupt_hot_spots.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& counters_button = lecui::widgets::button::add(activity_pane, "counters_button");
+	counters_button
+		.text("Start")
+		.tooltip("Sample instructions per cycle, cache misses and branch mispredictions on every core until the app is closed")
+		.rect(latency_button.rect())
+		.rect().snap_to(counters_caption.rect(), snap_type::bottom_left, 0.f);
+	counters_button.events().action = [this]() { start_hardware_counters(); };
+
+	auto& counters = lecui::widgets::label::add(activity_pane, "counters");
+	counters
+		.text(hardware_counters_text())
+		.tooltip(hardware_counters::core_text(_hardware_counters_info))
+		.font_size(_caption_font_size)
+		.paragraph_alignment(lecui::paragraph_alignment::middle)
+		.rect(latency.rect())
+		.rect().snap_to(counters_button.rect(), snap_type::right, _margin);
+
 	cpu_tab_pane.selected("CPU 0");
 }
 
@@ -994,13 +1318,9 @@ void main_form::add_monitor_tab_pane() {
 			.rect(monitor_name_caption.rect())
 			.rect().height(detail_height).snap_to(monitor_name_caption.rect(), snap_type::bottom, 0.f);
 
-		// get highest supported mode
-		leccore::pc_info::video_mode highest_mode = {};
-
-		for (auto& mode : monitor.supported_modes) {
-			if (highest_mode.horizontal_resolution < mode.horizontal_resolution)
-				highest_mode = mode;
-		}
+		// highest supported mode, indexed when the monitors were read
+		const leccore::pc_info::video_mode highest_mode = monitor_number < static_cast<int>(_monitor_highest_modes.size()) ?
+			_monitor_highest_modes[monitor_number] : leccore::pc_info::video_mode{};
 
 		// add screen size
 		auto& size_caption = lecui::widgets::label::add(monitor_pane);
@@ -1115,6 +1435,25 @@ void main_form::add_ram_pane() {
 		.rect(ram_title.rect())
 		.rect().snap_to(ram_title.rect(), snap_type::bottom, _margin).height(highlight_height);
 
+	// add memory benchmark
+	auto& benchmark_button = lecui::widgets::button::add(ram_pane, "benchmark_button");
+	benchmark_button
+		.text("Benchmark")
+		.tooltip("Measure the actual memory bandwidth and latency")
+		.rect(ram_summary.rect())
+		.rect().width(80.f).height(20.f).snap_to(ram_summary.rect(), snap_type::bottom_left, _margin / 2.f);
+	benchmark_button.events().action = [this]() { start_memory_benchmark(); };
+
+	auto& benchmark = lecui::widgets::label::add(ram_pane, "benchmark");
+	benchmark
+		.text(memory_benchmark_text())
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.paragraph_alignment(lecui::paragraph_alignment::middle)
+		.rect(benchmark_button.rect())
+		.rect().width(ram_pane.size().get_width() - benchmark_button.rect().width() - _margin)
+		.snap_to(benchmark_button.rect(), snap_type::right, _margin);
+
 	// add copy details icon
 	auto& copy = lecui::widgets::image_view::add(ram_pane, "copy");
 	copy
@@ -1155,18 +1494,75 @@ void main_form::add_ram_pane() {
 
 void main_form::add_ram_tab_pane() {
 	auto& ram_pane = get_pane("home/ram_pane");
-	auto& ram_summary = get_label("home/ram_pane/ram_summary");
+	auto& benchmark = get_label("home/ram_pane/benchmark");
 
-	auto& ram_tab_pane = lecui::containers::tab_pane::add(ram_pane);
+	auto& ram_tab_pane = lecui::containers::tab_pane::add(ram_pane, "ram_tab_pane");
 	ram_tab_pane.tab_side(lecui::containers::tab_pane::side::top);
 	ram_tab_pane.rect()
 		.left(0.f)
 		.right(ram_pane.size().get_width())
-		.top(ram_summary.rect().bottom() + _margin)
+		.top(benchmark.rect().bottom() + _margin / 2.f)
 		.bottom(ram_pane.size().get_height());
 	ram_tab_pane.color_tabs().alpha(0);
 	ram_tab_pane.color_tabs_border().alpha(0);
 
+	// add live memory usage as the first tab
+	auto& usage_pane = lecui::containers::tab::add(ram_tab_pane, "Usage");
+
+	auto& usage_caption = lecui::widgets::label::add(usage_pane);
+	usage_caption
+		.text("In Use")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect({ 0.f, usage_pane.size().get_width(), 0.f, caption_height });
+
+	auto& usage = lecui::widgets::label::add(usage_pane, "usage");
+	usage
+		.text(memory_usage_text())
+		.font_size(_caption_font_size)
+		.rect(usage_caption.rect())
+		.rect().snap_to(usage_caption.rect(), snap_type::bottom, 0.f);
+
+	auto& usage_history = lecui::widgets::line::add(usage_pane, "usage_history");
+	usage_history
+		.rect(usage.rect())
+		.rect().height(24.f).snap_to(usage.rect(), snap_type::bottom, _margin / 2.f);
+	usage_history
+		.points(memory_usage_curve(usage_history.rect().width(), usage_history.rect().height()))
+		.tooltip("Physical memory in use over the last five minutes, 0 to 100%")
+		.thickness(1.f);
+
+	auto& paging_caption = lecui::widgets::label::add(usage_pane);
+	paging_caption
+		.text("Paging and Pressure")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(usage_caption.rect())
+		.rect().snap_to(usage_history.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& paging = lecui::widgets::label::add(usage_pane, "paging");
+	paging
+		.text(memory_paging_text())
+		.color_text(_memory_info.pressure == memory_usage::pressure_level::high ? _not_ok_color : _caption_color)
+		.font_size(_caption_font_size)
+		.rect(paging_caption.rect())
+		.rect().snap_to(paging_caption.rect(), snap_type::bottom, 0.f);
+
+	auto& limit_caption = lecui::widgets::label::add(usage_pane);
+	limit_caption
+		.text("Effective Limit")
+		.color_text(_caption_color)
+		.font_size(_caption_font_size)
+		.rect(paging_caption.rect())
+		.rect().snap_to(paging.rect(), snap_type::bottom, _margin / 2.f);
+
+	auto& limit = lecui::widgets::label::add(usage_pane);
+	limit
+		.text(resource_limits::memory_summary(_resource_limits, _ram.size))
+		.font_size(_caption_font_size)
+		.rect(limit_caption.rect())
+		.rect().snap_to(limit_caption.rect(), snap_type::bottom, 0.f);
+
 	// add as many tab panes as there are rams
 	int ram_number = 0;
 	for (const auto& ram : _ram.ram_chips) {
@@ -1269,7 +1665,7 @@ void main_form::add_ram_tab_pane() {
 		ram_number++;
 	}
 
-	ram_tab_pane.selected("RAM 0");
+	ram_tab_pane.selected("Usage");
 }
 
 void main_form::add_drive_pane() {
@@ -1450,13 +1846,123 @@ void main_form::add_drive_tab_pane() {
 			.rect(serial_number.rect())
 			.rect().height(highlight_height).snap_to(serial_number.rect(), snap_type::bottom, _margin);
 
+		// add volume usage, one line per volume
+		const auto volume_count = drive_volumes(drive).size();
+
+		auto& volumes = lecui::widgets::label::add(drive_pane, "volumes");
+		volumes
+			.text(volume_usage_text(drive))
+			.font_size(_caption_font_size)
+			.rect(capacity.rect())
+			.rect().height(caption_height * (volume_count > 0 ? volume_count : 1))
+			.snap_to(capacity.rect(), snap_type::bottom, 0.f);
+
 		// add media type
 		auto& additional = lecui::widgets::label::add(drive_pane);
 		additional
 			.text(drive.media_type)
 			.font_size(_caption_font_size)
 			.rect(capacity.rect())
-			.rect().height(caption_height).snap_to(capacity.rect(), snap_type::bottom, 0.f);
+			.rect().height(caption_height).snap_to(volumes.rect(), snap_type::bottom, 0.f);
+
+		// add drive health and its trend
+		auto& health_caption = lecui::widgets::label::add(drive_pane);
+		health_caption
+			.text("Health")
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(drive_model_caption.rect())
+			.rect().snap_to(additional.rect(), snap_type::bottom, _margin);
+
+		auto& health = lecui::widgets::label::add(drive_pane, "health");
+		health
+			.text(drive_health_text(drive))
+			.color_text(drive_health_color(drive))
+			.font_size(_caption_font_size)
+			.rect(health_caption.rect())
+			.rect().snap_to(health_caption.rect(), snap_type::bottom, 0.f);
+
+		auto& health_trend = lecui::widgets::label::add(drive_pane, "health_trend");
+		health_trend
+			.text(drive_health_trend_text(drive))
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(health.rect())
+			.rect().snap_to(health.rect(), snap_type::bottom, 0.f);
+
+		// add storage benchmark
+		auto& benchmark_caption = lecui::widgets::label::add(drive_pane);
+		benchmark_caption
+			.text("Performance")
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(drive_model_caption.rect())
+			.rect().snap_to(health_trend.rect(), snap_type::bottom, _margin);
+
+		auto& benchmark_button = lecui::widgets::button::add(drive_pane, "benchmark_button");
+		benchmark_button
+			.text("Run")
+			.tooltip("Measure sequential and random 4K throughput and latency using a temporary 1GB file")
+			.rect(benchmark_caption.rect())
+			.rect().width(60.f).height(20.f).snap_to(benchmark_caption.rect(), snap_type::bottom_left, 0.f);
+		benchmark_button.events().action = [this, drive_number]() { start_storage_benchmark(drive_number); };
+
+		auto& benchmark = lecui::widgets::label::add(drive_pane, "benchmark");
+		benchmark
+			.text(storage_benchmark_text(drive))
+			.font_size(_caption_font_size)
+			.paragraph_alignment(lecui::paragraph_alignment::middle)
+			.rect(benchmark_button.rect())
+			.rect().width(drive_pane.size().get_width() - benchmark_button.rect().width() - _margin)
+			.snap_to(benchmark_button.rect(), snap_type::right, _margin);
+
+		// add live read activity
+		auto& read_activity_caption = lecui::widgets::label::add(drive_pane);
+		read_activity_caption
+			.text("Read")
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(status_caption.rect())
+			.rect().snap_to(benchmark_button.rect(), snap_type::bottom_left, _margin);
+
+		auto& read_activity = lecui::widgets::label::add(drive_pane, "read_activity");
+		read_activity
+			.text(read_activity_text(drive))
+			.font_size(_caption_font_size)
+			.rect(read_activity_caption.rect())
+			.rect().snap_to(read_activity_caption.rect(), snap_type::bottom, 0.f);
+
+		// add live write activity
+		auto& write_activity_caption = lecui::widgets::label::add(drive_pane);
+		write_activity_caption
+			.text("Write")
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(read_activity_caption.rect())
+			.rect().snap_to(read_activity_caption.rect(), snap_type::right, 0.f);
+
+		auto& write_activity = lecui::widgets::label::add(drive_pane, "write_activity");
+		write_activity
+			.text(write_activity_text(drive))
+			.font_size(_caption_font_size)
+			.rect(read_activity.rect())
+			.rect().snap_to(read_activity.rect(), snap_type::right, 0.f);
+
+		// add live queue depth and utilization
+		auto& queue_activity_caption = lecui::widgets::label::add(drive_pane);
+		queue_activity_caption
+			.text("Queue")
+			.color_text(_caption_color)
+			.font_size(_caption_font_size)
+			.rect(write_activity_caption.rect())
+			.rect().snap_to(write_activity_caption.rect(), snap_type::right, 0.f);
+
+		auto& queue_activity = lecui::widgets::label::add(drive_pane, "queue_activity");
+		queue_activity
+			.text(queue_activity_text(drive))
+			.font_size(_caption_font_size)
+			.rect(write_activity.rect())
+			.rect().snap_to(write_activity.rect(), snap_type::right, 0.f);
 
 		drive_number++;
 	}
@@ -0,0 +1,211 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "../../gui.h"
+#include "../../collectors/process_scanner.h"
+
+// lecui
+#include <liblec/lecui/widgets/label.h>
+
+// leccore
+#include <liblec/leccore/system.h>
+
+void main_form::processes() {
+	if (minimized())
+		restore();
+	else
+		show();
+
+	if (_processes_open)
+		return;
+
+	manage_async_access _a(_processes_open);
+
+	class processes_form : public form {
+		lecui::controls _ctrls{ *this };
+		lecui::page_manager _page_man{ *this };
+		lecui::widget_manager _widget_man{ *this };
+		lecui::appearance _apprnc{ *this };
+		lecui::dimensions _dim{ *this };
+		lecui::timer_manager _timer_man{ *this };
+
+		const bool& _setting_darktheme_parent;
+		const lecui::color& _caption_color;
+
+		process_scanner _scanner;
+		process_scanner::scan_info _scan;
+
+		// how many processes to list in each column
+		const size_t _top = 12;
+
+		std::string summary_text() {
+			return std::to_string(_scan.processes) + " processes, " +
+				std::to_string(_scan.threads) + " threads, scanned in " +
+				leccore::round_off::to_string(_scan.scan_time, 2) + "ms";
+		}
+
+		bool on_initialize(std::string& error) {
+			// the first scan only primes the cpu times
+			if (!_scanner.scan(_top, _scan, error))
+				return false;
+
+			// size and stuff
+			_ctrls
+				.allow_resize(false)
+				.allow_minimize(false);
+
+			_apprnc
+				.main_icon(ico_resource)
+				.mini_icon(ico_resource)
+				.caption_icon(get_dpi_scale() < 2.f ? icon_png_32 : icon_png_64)
+				.theme(_setting_darktheme_parent ? lecui::themes::dark : lecui::themes::light);
+			_dim.set_size(lecui::size().width(520.f).height(420.f));
+
+			return true;
+		}
+
+		bool on_layout(std::string& error) {
+			// add home page
+			auto& home = _page_man.add("home");
+
+			const auto right = home.size().get_width();
+			const float column_width = (right - 3.f * _margin) / 2.f;
+			const float value_width = 70.f;
+
+			// add page title
+			auto& title = lecui::widgets::label::add(home);
+			title
+				.text("<strong>TOP PROCESSES</strong>")
+				.rect(lecui::rect()
+					.left(_margin)
+					.right(right - _margin)
+					.top(_margin)
+					.height(25.f));
+
+			auto& summary = lecui::widgets::label::add(home, "summary");
+			summary
+				.text(summary_text())
+				.color_text(_caption_color)
+				.font_size(_caption_font_size)
+				.rect().width(title.rect().width()).height(15.f).snap_to(title.rect(), snap_type::bottom, 0.f);
+
+			// add a column of processes, a name and a value on each row
+			auto add_column = [&](const std::string& caption_text, const std::string& prefix, float left) {
+				auto& caption = lecui::widgets::label::add(home);
+				caption
+					.text("<strong>" + caption_text + "</strong>")
+					.rect({ left, left + column_width, summary.rect().bottom() + _margin, summary.rect().bottom() + _margin + 20.f });
+
+				lecui::rect previous = caption.rect();
+
+				for (size_t row = 0; row < _top; row++) {
+					auto& name = lecui::widgets::label::add(home, prefix + "_name " + std::to_string(row));
+					name
+						.font_size(_caption_font_size)
+						.rect({ left, left + column_width - value_width, previous.bottom(), previous.bottom() + 20.f });
+
+					auto& value = lecui::widgets::label::add(home, prefix + "_value " + std::to_string(row));
+					value
+						.font_size(_caption_font_size)
+						.alignment(lecui::text_alignment::right)
+						.rect({ name.rect().right(), left + column_width, name.rect().top(), name.rect().bottom() });
+
+					previous = name.rect();
+				}
+			};
+
+			add_column("By CPU", "cpu", _margin);
+			add_column("By Memory", "memory", _margin + column_width + _margin);
+
+			fill();
+
+			_page_man.show("home");
+			return true;
+		}
+
+		void on_start() {
+			_timer_man.add("refresh", 2000, [this]() { refresh(); });
+		}
+
+		void fill() {
+			for (size_t row = 0; row < _top; row++) {
+				try {
+					const bool cpu = row < _scan.top_cpu.size();
+					get_label("home/cpu_name " + std::to_string(row)).text(cpu ? _scan.top_cpu[row].name : std::string());
+					get_label("home/cpu_value " + std::to_string(row)).text(cpu ?
+						leccore::round_off::to_string(_scan.top_cpu[row].cpu, 1) + "%" : std::string());
+
+					const bool memory = row < _scan.top_memory.size();
+					get_label("home/memory_name " + std::to_string(row)).text(memory ? _scan.top_memory[row].name : std::string());
+					get_label("home/memory_value " + std::to_string(row)).text(memory ?
+						leccore::format_size(_scan.top_memory[row].working_set) : std::string());
+				}
+				catch (const std::exception&) {}
+			}
+		}
+
+		void refresh() {
+			std::string error;
+			if (!_scanner.scan(_top, _scan, error))
+				return;
+
+			try {
+				get_label("home/summary").text(summary_text());
+			}
+			catch (const std::exception&) {}
+
+			fill();
+			update();
+		}
+
+	public:
+		processes_form(const std::string& caption,
+			form& parent,
+			bool& setting_darktheme_parent,
+			const lecui::color& caption_color) :
+			form(caption, parent),
+			_setting_darktheme_parent(setting_darktheme_parent),
+			_caption_color(caption_color) {
+			// initialize event
+			events().initialize = [this](std::string& error) {
+				return on_initialize(error);
+			};
+
+			// layout event
+			events().layout = [this](std::string& error) {
+				return on_layout(error);
+			};
+
+			// start event
+			events().start = [this]() {
+				return on_start();
+			};
+		}
+	};
+
+	processes_form fm(std::string(appname) + " - Processes", *this, _setting_darktheme, _caption_color);
+	std::string error;
+	if (!fm.create(error))
+		message(error);
+}
@@ -0,0 +1,612 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "../../gui.h"
+
+// lecui
+#include <liblec/lecui/containers/pane.h>
+#include <liblec/lecui/containers/tab_pane.h>
+#include <liblec/lecui/widgets/label.h>
+#include <liblec/lecui/widgets/image_view.h>
+
+// leccore
+#include <liblec/leccore/system.h>
+
+void main_form::sensors() {
+	if (minimized())
+		restore();
+	else
+		show();
+
+	if (_sensors_open)
+		return;
+
+	manage_async_access _a(_sensors_open);
+
+	// the main form keeps reading the sensors for alerts and exports, this form only shows them
+	class sensors_form : public form {
+		lecui::controls _ctrls{ *this };
+		lecui::page_manager _page_man{ *this };
+		lecui::appearance _apprnc{ *this };
+		lecui::dimensions _dim{ *this };
+		lecui::timer_manager _timer_man{ *this };
+
+		main_form& _main;
+		const lecui::color& _caption_color;
+
+		// what is on display, compared against the main form's readings on every refresh
+		thermal::thermal_info _thermal_info;
+		network::network_info _network_info;
+
+		bool on_initialize(std::string& error) {
+			_thermal_info = _main._thermal_info;
+			_network_info = _main._network_info;
+
+			// size and stuff
+			_ctrls
+				.allow_resize(false)
+				.allow_minimize(false);
+
+			_apprnc
+				.main_icon(ico_resource)
+				.mini_icon(ico_resource)
+				.caption_icon(get_dpi_scale() < 2.f ? icon_png_32 : icon_png_64)
+				.theme(_main._setting_darktheme ? lecui::themes::dark : lecui::themes::light);
+			_dim.set_size(lecui::size().width(630.f).height(400.f));
+
+			return true;
+		}
+
+		bool on_layout(std::string& error) {
+			// add home page
+			_page_man.add("home");
+
+			add_thermal_pane();
+			add_thermal_tab_pane();
+
+			add_network_pane();
+			add_network_tab_pane();
+
+			_page_man.show("home");
+			return true;
+		}
+
+		void on_start() {
+			_timer_man.add("refresh", _refresh_interval, [this]() { refresh(); });
+		}
+
+		void add_thermal_pane() {
+			auto& home = get_page("home");
+
+			auto& thermal_pane = lecui::containers::pane::add(home, "thermal_pane");
+			thermal_pane.rect()
+				.left(_margin).width(300.f)
+				.top(_margin).bottom(home.size().get_height() - _margin);
+
+			thermal_pane.events().mouse_enter = [&]() {
+				try {
+					auto& copy = get_image_view("home/thermal_pane/copy");
+					copy.opacity(50.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			thermal_pane.events().mouse_leave = [&]() {
+				try {
+					auto& copy = get_image_view("home/thermal_pane/copy");
+					copy.opacity(0.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			// add thermal title
+			auto& thermal_title = lecui::widgets::label::add(thermal_pane, "thermal_title");
+			thermal_title.text("<strong>THERMAL DETAILS</strong>")
+				.font_size(_title_font_size)
+				.rect({ 0.f, thermal_pane.size().get_width(), 0.f, _main.title_height });
+
+			// add thermal summary
+			auto& thermal_summary = lecui::widgets::label::add(thermal_pane, "thermal_summary");
+			thermal_summary
+				.text(thermal::summary(_thermal_info))
+				.color_text(_thermal_info.critical_sensors() > 0 ? _not_ok_color : _caption_color)
+				.font_size(_caption_font_size)
+				.rect(thermal_title.rect())
+				.rect().height(_main.caption_height).snap_to(thermal_title.rect(), snap_type::bottom, 0.f);
+
+			// add copy details icon
+			auto& copy = lecui::widgets::image_view::add(thermal_pane, "copy");
+			copy
+				.png_resource(get_dpi_scale() < 2.f ? png_copy_32 : png_copy_64)
+				.tooltip("Copy Thermal Details")
+				.rect()
+				.left(thermal_pane.size().get_width() - 24.f).width(24.f)
+				.height(24.f);
+
+			copy
+				.opacity(0.f)	// invisible by default
+				.color_hot().alpha(0);
+
+			copy
+				.color_selected().alpha(0);
+
+			copy.events().mouse_enter = [&]() {
+				try {
+					auto& copy = get_image_view("home/thermal_pane/copy");
+					copy.opacity(100.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			copy.events().mouse_leave = [&]() {
+				try {
+					auto& copy = get_image_view("home/thermal_pane/copy");
+					copy.opacity(50.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			copy.events().action = [&]() {
+				std::string error;
+				if (!leccore::clipboard::set_text(_main.thermal_details_text(), error))
+					message(error);
+				else
+					message("Thermal details copied to the clipboard.");
+			};
+		}
+
+		void add_thermal_tab_pane() {
+			auto& thermal_pane = get_pane("home/thermal_pane");
+			auto& thermal_summary = get_label("home/thermal_pane/thermal_summary");
+
+			auto& thermal_tab_pane = lecui::containers::tab_pane::add(thermal_pane, "thermal_tab_pane");
+			thermal_tab_pane
+				.rect({ 0.f, thermal_pane.size().get_width(), thermal_summary.rect().bottom() + _margin / 2.f, thermal_pane.size().get_height() })
+				.tab_side(lecui::containers::tab_pane::side::top);
+			thermal_tab_pane.color_tabs().alpha(0);
+			thermal_tab_pane.color_tabs_border().alpha(0);
+
+			// add a tab for each group that has sensors, sensors are sorted by group
+			std::string first_tab;
+			for (const auto group : { thermal::sensor_group::cpu, thermal::sensor_group::drive, thermal::sensor_group::board }) {
+				const std::string tab_name = thermal::to_string(group);
+				lecui::containers::tab* group_pane = nullptr;
+				lecui::rect previous = {};
+
+				for (size_t sensor_number = 0; sensor_number < _thermal_info.sensors.size(); sensor_number++) {
+					const auto& sensor = _thermal_info.sensors[sensor_number];
+					if (sensor.group != group)
+						continue;
+
+					if (!group_pane) {
+						group_pane = &lecui::containers::tab::add(thermal_tab_pane, tab_name);
+
+						if (first_tab.empty())
+							first_tab = tab_name;
+					}
+
+					// add sensor name and reading
+					auto& sensor_caption = lecui::widgets::label::add(*group_pane);
+					sensor_caption
+						.text(sensor.name)
+						.color_text(_caption_color)
+						.font_size(_caption_font_size)
+						.rect({ 0.f, group_pane->size().get_width(), 0.f, _main.caption_height });
+
+					if (previous.height() > 0.f)
+						sensor_caption.rect().snap_to(previous, snap_type::bottom, _margin / 2.f);
+
+					auto& reading = lecui::widgets::label::add(*group_pane, "sensor " + std::to_string(sensor_number));
+					reading
+						.text(thermal::to_string(sensor))
+						.color_text(_main.thermal_color(sensor))
+						.font_size(_detail_font_size)
+						.rect(sensor_caption.rect())
+						.rect().height(_main.detail_height).snap_to(sensor_caption.rect(), snap_type::bottom, 0.f);
+
+					previous = reading.rect();
+				}
+			}
+
+			if (first_tab.empty()) {
+				first_tab = "Sensors";
+				auto& sensors_pane = lecui::containers::tab::add(thermal_tab_pane, first_tab);
+
+				auto& no_sensors = lecui::widgets::label::add(sensors_pane);
+				no_sensors
+					.text("No temperature sensors are exposed on this PC")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect({ 0.f, sensors_pane.size().get_width(), 0.f, _main.caption_height });
+			}
+
+			thermal_tab_pane.selected(first_tab);
+		}
+
+		void add_network_pane() {
+			auto& home = get_page("home");
+			auto& thermal_pane = get_pane("home/thermal_pane");
+
+			// next to the thermal pane
+			auto& network_pane = lecui::containers::pane::add(home, "network_pane");
+			network_pane
+				.rect(thermal_pane.rect())
+				.rect().snap_to(thermal_pane.rect(), snap_type::right_top, _margin);
+
+			network_pane.events().mouse_enter = [&]() {
+				try {
+					auto& copy = get_image_view("home/network_pane/copy");
+					copy.opacity(50.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			network_pane.events().mouse_leave = [&]() {
+				try {
+					auto& copy = get_image_view("home/network_pane/copy");
+					copy.opacity(0.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			// add network title
+			auto& network_title = lecui::widgets::label::add(network_pane, "network_title");
+			network_title.text("<strong>NETWORK DETAILS</strong>")
+				.font_size(_title_font_size)
+				.rect({ 0.f, network_pane.size().get_width(), 0.f, _main.title_height });
+
+			// add network summary
+			auto& network_summary = lecui::widgets::label::add(network_pane, "network_summary");
+			network_summary
+				.text(network::summary(_network_info))
+				.color_text(_caption_color)
+				.font_size(_caption_font_size)
+				.rect(network_title.rect())
+				.rect().height(_main.caption_height).snap_to(network_title.rect(), snap_type::bottom, 0.f);
+
+			// add copy details icon
+			auto& copy = lecui::widgets::image_view::add(network_pane, "copy");
+			copy
+				.png_resource(get_dpi_scale() < 2.f ? png_copy_32 : png_copy_64)
+				.tooltip("Copy Network Details")
+				.rect()
+				.left(network_pane.size().get_width() - 24.f).width(24.f)
+				.height(24.f);
+
+			copy
+				.opacity(0.f)	// invisible by default
+				.color_hot().alpha(0);
+
+			copy
+				.color_selected().alpha(0);
+
+			copy.events().mouse_enter = [&]() {
+				try {
+					auto& copy = get_image_view("home/network_pane/copy");
+					copy.opacity(100.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			copy.events().mouse_leave = [&]() {
+				try {
+					auto& copy = get_image_view("home/network_pane/copy");
+					copy.opacity(50.f);
+				}
+				catch (const std::exception&) {}
+			};
+
+			copy.events().action = [&]() {
+				std::string error;
+				if (!leccore::clipboard::set_text(_main.network_details_text(), error))
+					message(error);
+				else
+					message("Network details copied to the clipboard.");
+			};
+		}
+
+		void add_network_tab_pane() {
+			auto& network_pane = get_pane("home/network_pane");
+			auto& network_summary = get_label("home/network_pane/network_summary");
+
+			auto& network_tab_pane = lecui::containers::tab_pane::add(network_pane, "network_tab_pane");
+			network_tab_pane
+				.rect({ 0.f, network_pane.size().get_width(), network_summary.rect().bottom() + _margin / 2.f, network_pane.size().get_height() })
+				.tab_side(lecui::containers::tab_pane::side::top);
+			network_tab_pane.color_tabs().alpha(0);
+			network_tab_pane.color_tabs_border().alpha(0);
+
+			// add as many tab panes as there are adapters
+			int adapter_number = 0;
+			for (const auto& adapter : _network_info.adapters) {
+				auto& adapter_pane = lecui::containers::tab::add(network_tab_pane, "Adapter " + std::to_string(adapter_number));
+
+				// add connection name
+				auto& name_caption = lecui::widgets::label::add(adapter_pane);
+				name_caption
+					.text("Name")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect({ 0.f, adapter_pane.size().get_width(), 0.f, _main.caption_height });
+
+				auto& name = lecui::widgets::label::add(adapter_pane);
+				name
+					.text(adapter.name + " <span style = 'font-size: 8.0pt;'>" + adapter.type + "</span>")
+					.font_size(_detail_font_size)
+					.rect(name_caption.rect())
+					.rect().height(_main.detail_height).snap_to(name_caption.rect(), snap_type::bottom, 0.f);
+
+				// add adapter description
+				auto& description_caption = lecui::widgets::label::add(adapter_pane);
+				description_caption
+					.text("Adapter")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(name_caption.rect())
+					.rect().snap_to(name.rect(), snap_type::bottom, _margin / 2.f);
+
+				auto& description = lecui::widgets::label::add(adapter_pane);
+				description
+					.text(adapter.description)
+					.font_size(_caption_font_size)
+					.rect(description_caption.rect())
+					.rect().snap_to(description_caption.rect(), snap_type::bottom, 0.f);
+
+				// add status
+				auto& status_caption = lecui::widgets::label::add(adapter_pane);
+				status_caption
+					.text("Status")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(description.rect())
+					.rect().width(adapter_pane.size().get_width() / 2.f).snap_to(description.rect(), snap_type::bottom_left, _margin / 2.f);
+
+				auto& status = lecui::widgets::label::add(adapter_pane, "status");
+				status
+					.text(adapter.connected ? "Connected" : "Not connected")
+					.color_text(adapter.connected ? _ok_color : _caption_color)
+					.font_size(_caption_font_size)
+					.rect(status_caption.rect())
+					.rect().snap_to(status_caption.rect(), snap_type::bottom, 0.f);
+
+				// add link speed
+				auto& link_speed_caption = lecui::widgets::label::add(adapter_pane);
+				link_speed_caption
+					.text("Link Speed")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(status_caption.rect())
+					.rect().snap_to(status_caption.rect(), snap_type::right, 0.f);
+
+				auto& link_speed = lecui::widgets::label::add(adapter_pane, "link_speed");
+				link_speed
+					.text(network::speed_text(adapter.receive_speed))
+					.font_size(_caption_font_size)
+					.rect(link_speed_caption.rect())
+					.rect().snap_to(link_speed_caption.rect(), snap_type::bottom, 0.f);
+
+				// add mac address
+				auto& mac_caption = lecui::widgets::label::add(adapter_pane);
+				mac_caption
+					.text("MAC Address")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(description.rect())
+					.rect().snap_to(status.rect(), snap_type::bottom_left, _margin / 2.f);
+
+				auto& mac = lecui::widgets::label::add(adapter_pane);
+				mac
+					.text(adapter.mac)
+					.font_size(_caption_font_size)
+					.rect(mac_caption.rect())
+					.rect().snap_to(mac_caption.rect(), snap_type::bottom, 0.f);
+
+				// add addresses, there can be a few so allow for two lines
+				auto& addresses_caption = lecui::widgets::label::add(adapter_pane);
+				addresses_caption
+					.text("Addresses")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(mac_caption.rect())
+					.rect().snap_to(mac.rect(), snap_type::bottom, _margin / 2.f);
+
+				auto& addresses = lecui::widgets::label::add(adapter_pane, "addresses");
+				addresses
+					.text(network_addresses_text(adapter))
+					.font_size(_caption_font_size)
+					.rect(addresses_caption.rect())
+					.rect().height(2.f * _main.caption_height).snap_to(addresses_caption.rect(), snap_type::bottom, 0.f);
+
+				// add live receive traffic
+				auto& receive_caption = lecui::widgets::label::add(adapter_pane);
+				receive_caption
+					.text("Receive")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(status_caption.rect())
+					.rect().snap_to(addresses.rect(), snap_type::bottom_left, _margin / 2.f);
+
+				auto& receive = lecui::widgets::label::add(adapter_pane, "receive");
+				receive
+					.text(network_traffic_text(adapter.receive_bytes, adapter.receive_packets))
+					.font_size(_caption_font_size)
+					.rect(receive_caption.rect())
+					.rect().snap_to(receive_caption.rect(), snap_type::bottom, 0.f);
+
+				// add live send traffic
+				auto& send_caption = lecui::widgets::label::add(adapter_pane);
+				send_caption
+					.text("Send")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect(receive_caption.rect())
+					.rect().snap_to(receive_caption.rect(), snap_type::right, 0.f);
+
+				auto& send = lecui::widgets::label::add(adapter_pane, "send");
+				send
+					.text(network_traffic_text(adapter.send_bytes, adapter.send_packets))
+					.font_size(_caption_font_size)
+					.rect(send_caption.rect())
+					.rect().snap_to(send_caption.rect(), snap_type::bottom, 0.f);
+
+				adapter_number++;
+			}
+
+			if (_network_info.adapters.empty()) {
+				auto& adapters_pane = lecui::containers::tab::add(network_tab_pane, "Adapters");
+
+				auto& no_adapters = lecui::widgets::label::add(adapters_pane);
+				no_adapters
+					.text("No network adapters found")
+					.color_text(_caption_color)
+					.font_size(_caption_font_size)
+					.rect({ 0.f, adapters_pane.size().get_width(), 0.f, _main.caption_height });
+
+				network_tab_pane.selected("Adapters");
+			}
+			else
+				network_tab_pane.selected("Adapter 0");
+		}
+
+		void refresh() {
+			bool refresh_ui = false;
+
+			try {
+				// refresh thermal details
+				if (_thermal_info != _main._thermal_info) {
+					const thermal::thermal_info thermal_info_old = _thermal_info;
+					_thermal_info = _main._thermal_info;
+
+					get_label("home/thermal_pane/thermal_summary")
+						.text(thermal::summary(_thermal_info))
+						.color_text(_thermal_info.critical_sensors() > 0 ? _not_ok_color : _caption_color);
+
+					// sensors come and go with drives, rebuild the tabs when they do
+					bool same_sensors = thermal_info_old.sensors.size() == _thermal_info.sensors.size();
+					for (size_t i = 0; same_sensors && i < _thermal_info.sensors.size(); i++)
+						same_sensors = thermal_info_old.sensors[i].name == _thermal_info.sensors[i].name &&
+						thermal_info_old.sensors[i].group == _thermal_info.sensors[i].group;
+
+					if (same_sensors) {
+						for (size_t sensor_number = 0; sensor_number < _thermal_info.sensors.size(); sensor_number++) {
+							const auto& sensor = _thermal_info.sensors[sensor_number];
+
+							if (sensor == thermal_info_old.sensors[sensor_number])
+								continue;
+
+							get_label("home/thermal_pane/thermal_tab_pane/" + thermal::to_string(sensor.group) +
+								"/sensor " + std::to_string(sensor_number))
+								.text(thermal::to_string(sensor))
+								.color_text(_main.thermal_color(sensor));
+						}
+					}
+					else {
+						// close old thermal tab pane
+						_page_man.close("home/thermal_pane/thermal_tab_pane");
+
+						// add new thermal tab pane
+						add_thermal_tab_pane();
+					}
+
+					refresh_ui = true;
+				}
+			}
+			catch (const std::exception) {}
+
+			try {
+				// refresh network details
+				if (_network_info != _main._network_info) {
+					const network::network_info network_info_old = _network_info;
+					_network_info = _main._network_info;
+
+					get_label("home/network_pane/network_summary").text(network::summary(_network_info));
+
+					// adapters come and go, e.g. usb and vpn adapters, rebuild the tabs when they do
+					if (network::same_adapters(network_info_old, _network_info)) {
+						for (size_t adapter_number = 0; adapter_number < _network_info.adapters.size(); adapter_number++) {
+							const auto& adapter = _network_info.adapters[adapter_number];
+							const auto& adapter_old = network_info_old.adapters[adapter_number];
+							const std::string path = "home/network_pane/network_tab_pane/Adapter " + std::to_string(adapter_number);
+
+							if (adapter_old.connected != adapter.connected)
+								get_label(path + "/status")
+									.text(adapter.connected ? "Connected" : "Not connected")
+									.color_text(adapter.connected ? _ok_color : _caption_color);
+
+							if (adapter_old.receive_speed != adapter.receive_speed)
+								get_label(path + "/link_speed").text(network::speed_text(adapter.receive_speed));
+
+							if (adapter_old.addresses != adapter.addresses)
+								get_label(path + "/addresses").text(network_addresses_text(adapter));
+
+							get_label(path + "/receive").text(network_traffic_text(adapter.receive_bytes, adapter.receive_packets));
+							get_label(path + "/send").text(network_traffic_text(adapter.send_bytes, adapter.send_packets));
+						}
+					}
+					else {
+						// close old network tab pane
+						_page_man.close("home/network_pane/network_tab_pane");
+
+						// add new network tab pane
+						add_network_tab_pane();
+					}
+
+					refresh_ui = true;
+				}
+			}
+			catch (const std::exception) {}
+
+			if (refresh_ui)
+				update();
+		}
+
+	public:
+		sensors_form(const std::string& caption,
+			main_form& main,
+			const lecui::color& caption_color) :
+			form(caption, main),
+			_main(main),
+			_caption_color(caption_color) {
+			// initialize event
+			events().initialize = [this](std::string& error) {
+				return on_initialize(error);
+			};
+
+			// layout event
+			events().layout = [this](std::string& error) {
+				return on_layout(error);
+			};
+
+			// start event
+			events().start = [this]() {
+				return on_start();
+			};
+		}
+	};
+
+	sensors_form fm(std::string(appname) + " - Thermal and Network", *this, _caption_color);
+	std::string error;
+	if (!fm.create(error))
+		message(error);
+}
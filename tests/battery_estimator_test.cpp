@@ -0,0 +1,97 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/battery_estimator.h"
+#include "../collectors/battery_estimator.h"
+
+namespace {
+	const size_t trace_size = sizeof(fixtures::battery_trace) / sizeof(fixtures::battery_trace[0]);
+
+	void replay(battery_estimator& estimator, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			const auto& sample = fixtures::battery_trace[i];
+			estimator.add(sample.time, sample.capacity, sample.full_capacity, sample.charge_rate);
+		}
+	}
+
+	// the rate over a stretch of the trace, from the capacity the gauge reported
+	double measured_rate(size_t first, size_t last) {
+		const auto& start = fixtures::battery_trace[first];
+		const auto& end = fixtures::battery_trace[last];
+		return (end.capacity - start.capacity) * 3600.0 / static_cast<double>(end.time - start.time);
+	}
+}
+
+TEST_CASE(battery_estimator_warm_up) {
+	battery_estimator estimator;
+	replay(estimator, 0, 3);
+	CHECK(!estimator.get().valid);
+	CHECK(battery_estimator::to_string(estimator.get()).empty());
+}
+
+TEST_CASE(battery_estimator_discharge) {
+	battery_estimator estimator;
+	replay(estimator, 0, fixtures::battery_trace_plugged);
+
+	const auto estimate = estimator.get();
+	CHECK(estimate.valid);
+	CHECK(!estimate.charging);
+
+	// the time the battery would actually last at the rate it drained over the whole trace
+	const size_t last = fixtures::battery_trace_plugged - 1;
+	const double actual = fixtures::battery_trace[last].capacity * 3600.0 / -measured_rate(0, last);
+
+	CHECK(estimate.low_seconds <= estimate.seconds && estimate.seconds <= estimate.high_seconds);
+	CHECK(estimate.low_seconds <= actual && actual <= estimate.high_seconds);
+	CHECK_NEAR(estimate.seconds / actual, 1.0, 0.2);
+}
+
+TEST_CASE(battery_estimator_plugged_in) {
+	battery_estimator estimator;
+	replay(estimator, 0, trace_size);
+
+	// switching to charging starts afresh instead of averaging in the discharge
+	const auto estimate = estimator.get();
+	CHECK(estimate.valid);
+	CHECK(estimate.charging);
+
+	const auto& last = fixtures::battery_trace[trace_size - 1];
+	const double actual = (last.full_capacity - last.capacity) * 3600.0 /
+		measured_rate(fixtures::battery_trace_plugged, trace_size - 1);
+
+	// a steady charge gives a narrow range, tighter than the coarse capacity steps can confirm
+	CHECK_NEAR(estimate.seconds / actual, 1.0, 0.1);
+}
+
+TEST_CASE(battery_estimator_stale_samples) {
+	battery_estimator estimator;
+	replay(estimator, 0, 20);
+	const auto before = estimator.get();
+
+	// repeated and out of order samples are ignored
+	const auto& sample = fixtures::battery_trace[10];
+	estimator.add(sample.time, sample.capacity, sample.full_capacity, sample.charge_rate);
+	CHECK(estimator.get().seconds == before.seconds);
+}
@@ -0,0 +1,147 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "../collectors/cpu_features.h"
+
+namespace {
+	using feature = cpu_features::feature;
+
+	bool has(const cpu_features::feature_set& features, feature f) {
+		return features.test(static_cast<size_t>(f));
+	}
+
+	// register dumps taken on Windows 10, where xcr0 is what the os enabled
+	cpu_features::cpuid_registers core_i7_8700k() {
+		cpu_features::cpuid_registers r;
+		r.max_leaf = 0x16;
+		r.max_extended_leaf = 0x80000008;
+		r.leaf_1_ecx = 0x7ffafbff;
+		r.leaf_1_edx = 0xbfebfbff;
+		r.leaf_7_ebx = 0x029c67af;
+		r.leaf_7_ecx = 0x00000000;
+		r.leaf_7_edx = 0x9c000400;
+		r.extended_1_ecx = 0x00000121;
+		r.extended_1_edx = 0x2c100800;
+		r.xcr0 = 0x1f;
+		return r;
+	}
+
+	cpu_features::cpuid_registers ryzen_7_5800x() {
+		cpu_features::cpuid_registers r;
+		r.max_leaf = 0x10;
+		r.max_extended_leaf = 0x80000020;
+		r.leaf_1_ecx = 0x7ed8320b;
+		r.leaf_1_edx = 0x178bfbff;
+		r.leaf_7_ebx = 0x219c97a9;
+		r.leaf_7_ecx = 0x0040068c;
+		r.leaf_7_edx = 0x00000010;
+		r.extended_1_ecx = 0x75c237ff;
+		r.extended_1_edx = 0x2fd3fbff;
+		r.xcr0 = 0x207;
+		return r;
+	}
+
+	cpu_features::cpuid_registers core_i7_1065g7() {
+		cpu_features::cpuid_registers r;
+		r.max_leaf = 0x1b;
+		r.max_extended_leaf = 0x80000008;
+		r.leaf_1_ecx = 0x7ffafbbf;
+		r.leaf_1_edx = 0xbfebfbff;
+		r.leaf_7_ebx = 0xf2bf27ef;
+		r.leaf_7_ecx = 0x40405f4e;
+		r.leaf_7_edx = 0xbc000410;
+		r.extended_1_ecx = 0x00000121;
+		r.extended_1_edx = 0x2c100800;
+		r.xcr0 = 0xe7;
+		return r;
+	}
+}
+
+TEST_CASE(cpu_features_coffee_lake) {
+	const auto features = cpu_features::decode(core_i7_8700k());
+
+	CHECK(has(features, feature::avx2));
+	CHECK(has(features, feature::fma));
+	CHECK(has(features, feature::bmi2));
+	CHECK(has(features, feature::lzcnt));
+	CHECK(!has(features, feature::sha));
+	CHECK(!has(features, feature::avx512f));
+	CHECK(cpu_features::level(features) == 3);
+}
+
+TEST_CASE(cpu_features_zen_3) {
+	const auto features = cpu_features::decode(ryzen_7_5800x());
+
+	CHECK(has(features, feature::avx2));
+	CHECK(has(features, feature::sha));
+	CHECK(has(features, feature::vaes));
+	CHECK(has(features, feature::vpclmulqdq));
+	CHECK(!has(features, feature::gfni));
+	CHECK(!has(features, feature::avx512f));
+	CHECK(cpu_features::level(features) == 3);
+}
+
+TEST_CASE(cpu_features_ice_lake) {
+	const auto features = cpu_features::decode(core_i7_1065g7());
+
+	CHECK(has(features, feature::avx512f));
+	CHECK(has(features, feature::avx512vl));
+	CHECK(has(features, feature::avx512vbmi2));
+	CHECK(has(features, feature::avx512vpopcntdq));
+	CHECK(has(features, feature::gfni));
+	CHECK(!has(features, feature::avx512fp16));
+	CHECK(cpu_features::level(features) == 4);
+}
+
+TEST_CASE(cpu_features_os_disabled_avx512) {
+	// the same Ice Lake with the os leaving the opmask and zmm state off
+	auto registers = core_i7_1065g7();
+	registers.xcr0 = 0x7;
+	const auto features = cpu_features::decode(registers);
+
+	CHECK(has(features, feature::avx2));
+	CHECK(!has(features, feature::avx512f));
+	CHECK(cpu_features::level(features) == 3);
+}
+
+TEST_CASE(cpu_features_os_disabled_avx) {
+	// no ymm state, e.g. an older hypervisor; avx2 and up must not be reported
+	auto registers = core_i7_8700k();
+	registers.xcr0 = 0x3;
+	const auto features = cpu_features::decode(registers);
+
+	CHECK(has(features, feature::sse4_2));
+	CHECK(!has(features, feature::avx));
+	CHECK(!has(features, feature::avx2));
+	CHECK(cpu_features::level(features) == 2);
+}
+
+TEST_CASE(cpu_features_round_trip) {
+	const auto features = cpu_features::decode(ryzen_7_5800x());
+
+	cpu_features::feature_set parsed;
+	CHECK(cpu_features::from_hex(cpu_features::to_hex(features), parsed));
+	CHECK(parsed == features);
+}
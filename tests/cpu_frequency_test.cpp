@@ -0,0 +1,53 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "../collectors/cpu_frequency.h"
+
+TEST_CASE(cpu_frequency_idle_core) {
+	// an idle core parked at 800MHz with nothing capping it is power management, not throttling,
+	// so only the base speed and the limit are looked at
+	CHECK(!cpu_frequency::is_throttled(2800, 2800));
+
+	// nor is a turbo limit above base speed
+	CHECK(!cpu_frequency::is_throttled(2800, 4700));
+}
+
+TEST_CASE(cpu_frequency_capped_core) {
+	// a thermal or power cap well below base speed
+	CHECK(cpu_frequency::is_throttled(2800, 1400));
+	CHECK(cpu_frequency::is_throttled(3600, 2800));
+
+	// a cap just under base speed is within the threshold
+	CHECK(!cpu_frequency::is_throttled(3600, 3000));
+	CHECK(!cpu_frequency::is_throttled(2500, 2000));
+	CHECK(cpu_frequency::is_throttled(2500, 1999));
+}
+
+TEST_CASE(cpu_frequency_unknown) {
+	// missing speeds are never flagged
+	CHECK(!cpu_frequency::is_throttled(0, 1400));
+	CHECK(!cpu_frequency::is_throttled(2800, 0));
+	CHECK(!cpu_frequency::is_throttled(0, 0));
+}
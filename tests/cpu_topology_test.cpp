@@ -0,0 +1,50 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "../collectors/cpu_topology.h"
+
+TEST_CASE(cpu_topology_single_group) {
+	// up to 64 processors the number is the bit
+	const std::vector<unsigned long long> masks = { 0xFFull };
+	CHECK(cpu_topology::processor_number(masks, 0, 0) == 0);
+	CHECK(cpu_topology::processor_number(masks, 0, 7) == 7);
+}
+
+TEST_CASE(cpu_topology_two_groups) {
+	// two groups of 48, the second group runs on from 48 rather than starting at 64
+	const std::vector<unsigned long long> masks = { 0xFFFFFFFFFFFFull, 0xFFFFFFFFFFFFull };
+	CHECK(cpu_topology::processor_number(masks, 0, 47) == 47);
+	CHECK(cpu_topology::processor_number(masks, 1, 0) == 48);
+	CHECK(cpu_topology::processor_number(masks, 1, 47) == 95);
+	CHECK(cpu_topology::to_ranges({ 46, 47, 48, 49 }) == "46-49");
+}
+
+TEST_CASE(cpu_topology_full_groups) {
+	// two full groups of 64 number the same either way
+	const std::vector<unsigned long long> masks = { ~0ull, ~0ull };
+	CHECK(cpu_topology::processor_number(masks, 0, 63) == 63);
+	CHECK(cpu_topology::processor_number(masks, 1, 0) == 64);
+	CHECK(cpu_topology::processor_number(masks, 1, 63) == 127);
+}
@@ -0,0 +1,160 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/drive_health.h"
+#include "../collectors/drive_health.h"
+
+TEST_CASE(drive_health_nvme) {
+	drive_health::health_info info;
+	std::string error;
+	CHECK(drive_health::parse_nvme_health_log(fixtures::nvme_health_log, sizeof(fixtures::nvme_health_log), info, error));
+
+	CHECK(info.protocol == "NVMe");
+	CHECK(!info.critical_warning);
+	CHECK(info.temperature == 40);
+	CHECK(info.available_spare == 100);
+	CHECK(info.percentage_used == 3);
+	CHECK(info.power_cycles == 1187);
+	CHECK(info.power_on_hours == 5342);
+	CHECK(info.unsafe_shutdowns == 68);
+	CHECK(info.media_errors == 0);
+}
+
+TEST_CASE(drive_health_nvme_warning) {
+	drive_health::health_info info;
+	std::string error;
+	CHECK(drive_health::parse_nvme_health_log(fixtures::nvme_warning_log, sizeof(fixtures::nvme_warning_log), info, error));
+
+	CHECK(info.critical_warning);
+	CHECK(info.temperature == drive_health::unknown);
+	CHECK(info.available_spare == 8);
+	CHECK(info.percentage_used == 104);
+	CHECK(info.media_errors == 212);
+}
+
+TEST_CASE(drive_health_ata_ssd) {
+	drive_health::health_info info;
+	std::string error;
+	CHECK(drive_health::parse_ata_smart_attributes(fixtures::ata_ssd_attributes, sizeof(fixtures::ata_ssd_attributes), info, error));
+
+	CHECK(info.protocol == "ATA");
+	CHECK(!info.critical_warning);
+	CHECK(info.percentage_used == 4);
+	CHECK(info.power_on_hours == 12873);
+	CHECK(info.power_cycles == 2110);
+	CHECK(info.media_errors == 0);
+
+	// the airflow temperature (190) is not the drive temperature (194)
+	CHECK(info.temperature == drive_health::unknown);
+	CHECK(info.unsafe_shutdowns == drive_health::unknown);
+}
+
+TEST_CASE(drive_health_ata_failing_disk) {
+	drive_health::health_info info;
+	std::string error;
+	CHECK(drive_health::parse_ata_smart_attributes(fixtures::ata_failing_disk_attributes, sizeof(fixtures::ata_failing_disk_attributes), info, error));
+
+	// reallocated, reported uncorrectable and offline uncorrectable sectors, not pending ones
+	CHECK(info.media_errors == 24 + 3 + 2);
+
+	// the minimum and maximum are packed above the current temperature
+	CHECK(info.temperature == 36);
+	CHECK(info.power_on_hours == 25601);
+	CHECK(info.power_cycles == 2466);
+	CHECK(info.unsafe_shutdowns == 301);
+	CHECK(info.percentage_used == drive_health::unknown);
+}
+
+TEST_CASE(drive_health_short_page) {
+	drive_health::health_info info;
+	std::string error;
+	CHECK(!drive_health::parse_nvme_health_log(fixtures::nvme_health_log, 256, info, error));
+	CHECK(!error.empty());
+
+	error.clear();
+	CHECK(!drive_health::parse_ata_smart_attributes(fixtures::ata_ssd_attributes, 256, info, error));
+	CHECK(!error.empty());
+}
+
+namespace {
+	const long long start = 1700000000;
+	const long long day = 86400;
+
+	// a daily series with the given wear on each day, no media errors
+	std::vector<drive_health::health_sample> wear_series(const std::vector<long long>& wear) {
+		std::vector<drive_health::health_sample> series;
+
+		for (size_t i = 0; i < wear.size(); i++) {
+			drive_health::health_info info;
+			info.percentage_used = wear[i];
+			info.media_errors = 0;
+			drive_health::append(series, info, start + static_cast<long long>(i) * day);
+		}
+
+		return series;
+	}
+}
+
+TEST_CASE(drive_health_single_tick) {
+	// wear ticks over from 3% to 4% a day after the history starts
+	auto series = wear_series({ 3, 4 });
+	CHECK(!drive_health::degrading(series));
+	CHECK(drive_health::trend(series) == "+1% wear in 1 day");
+
+	// and then holds for two months
+	series = wear_series(std::vector<long long>(61, 4));
+	series.front().percentage_used = 3;
+	CHECK(!drive_health::degrading(series));
+	CHECK(drive_health::trend(series) == "+1% wear in 60 days");
+}
+
+TEST_CASE(drive_health_wearing) {
+	// two percent a month for three months
+	std::vector<long long> wear;
+	for (long long i = 0; i <= 90; i++)
+		wear.push_back(10 + i / 15);
+
+	auto series = wear_series(wear);
+	CHECK(drive_health::degrading(series));
+	CHECK(drive_health::trend(series) == "+6% wear in 90 days");
+
+	// the same rate is not enough history before 30 days
+	series.resize(29);
+	CHECK(!drive_health::degrading(series));
+}
+
+TEST_CASE(drive_health_media_errors) {
+	auto series = wear_series({ 5, 5, 5 });
+	CHECK(!drive_health::degrading(series));
+	CHECK(drive_health::trend(series) == "Stable in 2 days");
+
+	// any new media error counts, however short the history
+	series.back().media_errors = 2;
+	CHECK(drive_health::degrading(series));
+
+	// drives that do not report wear
+	series = wear_series(std::vector<long long>(60, drive_health::unknown));
+	CHECK(!drive_health::degrading(series));
+}
@@ -0,0 +1,118 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/edid.h"
+#include "../collectors/edid.h"
+
+namespace {
+	bool has_mode(const edid::edid_info& info, unsigned long horizontal, unsigned long vertical, double refresh_rate) {
+		for (const auto& mode : info.modes)
+			if (mode.horizontal_resolution == horizontal && mode.vertical_resolution == vertical &&
+				mode.refresh_rate > refresh_rate - 0.5 && mode.refresh_rate < refresh_rate + 0.5)
+				return true;
+
+		return false;
+	}
+}
+
+TEST_CASE(edid_desktop_monitor) {
+	edid::edid_info info;
+	std::string error;
+	CHECK(edid::parse(fixtures::dell_u2415, sizeof(fixtures::dell_u2415), info, error));
+
+	CHECK(info.manufacturer == "DEL");
+	CHECK(info.product_code == "A0BA");
+	CHECK(info.name == "DELL U2415");
+	CHECK(info.serial_number == "7MT0185S0LZL");
+
+	// the detailed timing size is in mm, the base block only has it in cm
+	CHECK(info.width_mm == 518);
+	CHECK(info.height_mm == 324);
+	CHECK_NEAR(info.diagonal_inches(), 24.1, 0.05);
+
+	// standard timings, and the TV timings from the extension
+	CHECK(has_mode(info, 1680, 1050, 60.0));
+	CHECK(has_mode(info, 1600, 900, 60.0));
+	CHECK(has_mode(info, 1280, 1024, 60.0));
+	CHECK(has_mode(info, 1152, 864, 75.0));
+	CHECK(has_mode(info, 1920, 1080, 60.0));
+	CHECK(has_mode(info, 1280, 720, 60.0));
+
+	// the native mode is listed as a standard timing too, the detailed one is kept
+	size_t native = 0;
+	for (const auto& mode : info.modes)
+		if (mode.horizontal_resolution == 1920 && mode.vertical_resolution == 1200)
+			native++;
+
+	CHECK(native == 1);
+
+	const auto& highest = info.modes[info.highest_mode];
+	CHECK(highest.horizontal_resolution == 1920);
+	CHECK(highest.vertical_resolution == 1200);
+	CHECK(highest.pixel_clock_rate == 154000000);
+	CHECK_NEAR(highest.refresh_rate, 59.95, 0.01);
+}
+
+TEST_CASE(edid_laptop_panel) {
+	edid::edid_info info;
+	std::string error;
+	CHECK(edid::parse(fixtures::laptop_panel, sizeof(fixtures::laptop_panel), info, error));
+
+	CHECK(info.manufacturer == "BOE");
+	CHECK(info.name.empty());
+	CHECK(info.modes.size() == 2);
+	CHECK_NEAR(info.diagonal_inches(), 16.0, 0.05);
+
+	// the same resolution at two rates, the faster one is the highest mode
+	const auto& highest = info.modes[info.highest_mode];
+	CHECK(highest.horizontal_resolution == 2560);
+	CHECK(highest.vertical_resolution == 1600);
+	CHECK_NEAR(highest.refresh_rate, 120.0, 0.01);
+	CHECK(has_mode(info, 2560, 1600, 60.0));
+}
+
+TEST_CASE(edid_decode_cache) {
+	const std::vector<unsigned char> raw(fixtures::dell_u2415, fixtures::dell_u2415 + sizeof(fixtures::dell_u2415));
+
+	edid decoder;
+	edid::edid_info first, second;
+	std::string error;
+	CHECK(decoder.decode(raw, first, error));
+	CHECK(decoder.decode(raw, second, error));
+	CHECK(first.name == second.name);
+	CHECK(first.modes.size() == second.modes.size());
+}
+
+TEST_CASE(edid_invalid) {
+	edid::edid_info info;
+	std::string error;
+
+	// too short for a base block
+	CHECK(!edid::parse(fixtures::dell_u2415, 100, info, error));
+
+	// not starting with the header
+	CHECK(!edid::parse(fixtures::dell_u2415 + 128, 128, info, error));
+	CHECK(!error.empty());
+}
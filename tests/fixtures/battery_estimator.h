@@ -0,0 +1,225 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace fixtures {
+	struct battery_sample {
+		long long time;
+		double capacity;
+		double full_capacity;
+		double charge_rate;
+	};
+
+	// a laptop battery polled every 10 seconds: 20 minutes of browsing on battery, with the
+	// occasional burst of load, then plugged in. The gauge only updates the capacity every
+	// 20 seconds or so. Capacities in mWh, rates in mW.
+	const battery_sample battery_trace[] = {
+		{ 0, 41240, 57020, -10093 },
+		{ 10, 41240, 57020, -10325 },
+		{ 20, 41180, 57020, -9339 },
+		{ 30, 41180, 57020, -9681 },
+		{ 40, 41130, 57020, -9256 },
+		{ 50, 41130, 57020, -9608 },
+		{ 60, 41080, 57020, -9667 },
+		{ 70, 41080, 57020, -9181 },
+		{ 80, 41020, 57020, -10369 },
+		{ 90, 41020, 57020, -13756 },
+		{ 100, 40940, 57020, -16768 },
+		{ 110, 40940, 57020, -14194 },
+		{ 120, 40860, 57020, -13890 },
+		{ 130, 40860, 57020, -15464 },
+		{ 140, 40780, 57020, -12663 },
+		{ 150, 40780, 57020, -13504 },
+		{ 160, 40700, 57020, -14641 },
+		{ 170, 40700, 57020, -13689 },
+		{ 180, 40640, 57020, -8954 },
+		{ 190, 40640, 57020, -9767 },
+		{ 200, 40590, 57020, -9117 },
+		{ 210, 40590, 57020, -10685 },
+		{ 220, 40530, 57020, -8737 },
+		{ 230, 40530, 57020, -9115 },
+		{ 240, 40480, 57020, -9037 },
+		{ 250, 40480, 57020, -11405 },
+		{ 260, 40420, 57020, -9518 },
+		{ 270, 40420, 57020, -9098 },
+		{ 280, 40370, 57020, -8915 },
+		{ 290, 40370, 57020, -8463 },
+		{ 300, 40330, 57020, -9079 },
+		{ 310, 40330, 57020, -10494 },
+		{ 320, 40270, 57020, -8210 },
+		{ 330, 40270, 57020, -9864 },
+		{ 340, 40220, 57020, -9373 },
+		{ 350, 40220, 57020, -9288 },
+		{ 360, 40160, 57020, -10799 },
+		{ 370, 40160, 57020, -9444 },
+		{ 380, 40110, 57020, -9427 },
+		{ 390, 40110, 57020, -9370 },
+		{ 400, 40060, 57020, -9681 },
+		{ 410, 40060, 57020, -9664 },
+		{ 420, 40010, 57020, -9510 },
+		{ 430, 40010, 57020, -10197 },
+		{ 440, 39950, 57020, -8661 },
+		{ 450, 39950, 57020, -15498 },
+		{ 460, 39870, 57020, -15438 },
+		{ 470, 39870, 57020, -13670 },
+		{ 480, 39790, 57020, -15276 },
+		{ 490, 39790, 57020, -12291 },
+		{ 500, 39710, 57020, -13581 },
+		{ 510, 39710, 57020, -14771 },
+		{ 520, 39630, 57020, -14509 },
+		{ 530, 39630, 57020, -14169 },
+		{ 540, 39570, 57020, -7917 },
+		{ 550, 39570, 57020, -8799 },
+		{ 560, 39520, 57020, -8723 },
+		{ 570, 39520, 57020, -8792 },
+		{ 580, 39470, 57020, -9767 },
+		{ 590, 39470, 57020, -8099 },
+		{ 600, 39420, 57020, -9236 },
+		{ 610, 39420, 57020, -9694 },
+		{ 620, 39370, 57020, -9937 },
+		{ 630, 39370, 57020, -9697 },
+		{ 640, 39320, 57020, -9514 },
+		{ 650, 39320, 57020, -9505 },
+		{ 660, 39260, 57020, -9396 },
+		{ 670, 39260, 57020, -9620 },
+		{ 680, 39210, 57020, -9818 },
+		{ 690, 39210, 57020, -9929 },
+		{ 700, 39150, 57020, -10475 },
+		{ 710, 39150, 57020, -10449 },
+		{ 720, 39100, 57020, -9205 },
+		{ 730, 39100, 57020, -9530 },
+		{ 740, 39050, 57020, -9378 },
+		{ 750, 39050, 57020, -10810 },
+		{ 760, 38990, 57020, -10318 },
+		{ 770, 38990, 57020, -9240 },
+		{ 780, 38930, 57020, -10346 },
+		{ 790, 38930, 57020, -9645 },
+		{ 800, 38880, 57020, -9319 },
+		{ 810, 38880, 57020, -13466 },
+		{ 820, 38800, 57020, -13620 },
+		{ 830, 38800, 57020, -14115 },
+		{ 840, 38730, 57020, -14107 },
+		{ 850, 38730, 57020, -16724 },
+		{ 860, 38640, 57020, -15592 },
+		{ 870, 38640, 57020, -13662 },
+		{ 880, 38560, 57020, -12992 },
+		{ 890, 38560, 57020, -13097 },
+		{ 900, 38500, 57020, -9400 },
+		{ 910, 38500, 57020, -10033 },
+		{ 920, 38450, 57020, -7944 },
+		{ 930, 38450, 57020, -10036 },
+		{ 940, 38400, 57020, -9174 },
+		{ 950, 38400, 57020, -9871 },
+		{ 960, 38340, 57020, -9777 },
+		{ 970, 38340, 57020, -10439 },
+		{ 980, 38290, 57020, -8490 },
+		{ 990, 38290, 57020, -9631 },
+		{ 1000, 38240, 57020, -8682 },
+		{ 1010, 38240, 57020, -8201 },
+		{ 1020, 38190, 57020, -9065 },
+		{ 1030, 38190, 57020, -9560 },
+		{ 1040, 38140, 57020, -10087 },
+		{ 1050, 38140, 57020, -7726 },
+		{ 1060, 38090, 57020, -10562 },
+		{ 1070, 38090, 57020, -9131 },
+		{ 1080, 38030, 57020, -10384 },
+		{ 1090, 38030, 57020, -10735 },
+		{ 1100, 37970, 57020, -10407 },
+		{ 1110, 37970, 57020, -7761 },
+		{ 1120, 37930, 57020, -9146 },
+		{ 1130, 37930, 57020, -9388 },
+		{ 1140, 37870, 57020, -8995 },
+		{ 1150, 37870, 57020, -8808 },
+		{ 1160, 37820, 57020, -10407 },
+		{ 1170, 37820, 57020, -12662 },
+		{ 1180, 37750, 57020, -13566 },
+		{ 1190, 37750, 57020, -15008 },
+		{ 1200, 37820, 57020, 40975 },
+		{ 1210, 37820, 57020, 41401 },
+		{ 1220, 38050, 57020, 41567 },
+		{ 1230, 38050, 57020, 41599 },
+		{ 1240, 38280, 57020, 40671 },
+		{ 1250, 38280, 57020, 41277 },
+		{ 1260, 38510, 57020, 40160 },
+		{ 1270, 38510, 57020, 40462 },
+		{ 1280, 38730, 57020, 40095 },
+		{ 1290, 38730, 57020, 41293 },
+		{ 1300, 38960, 57020, 40357 },
+		{ 1310, 38960, 57020, 40830 },
+		{ 1320, 39180, 57020, 40743 },
+		{ 1330, 39180, 57020, 40794 },
+		{ 1340, 39410, 57020, 40553 },
+		{ 1350, 39410, 57020, 40868 },
+		{ 1360, 39640, 57020, 41477 },
+		{ 1370, 39640, 57020, 40763 },
+		{ 1380, 39860, 57020, 40942 },
+		{ 1390, 39860, 57020, 41115 },
+		{ 1400, 40090, 57020, 40621 },
+		{ 1410, 40090, 57020, 40181 },
+		{ 1420, 40320, 57020, 40448 },
+		{ 1430, 40320, 57020, 41084 },
+		{ 1440, 40540, 57020, 39982 },
+		{ 1450, 40540, 57020, 40386 },
+		{ 1460, 40770, 57020, 41013 },
+		{ 1470, 40770, 57020, 40912 },
+		{ 1480, 40990, 57020, 40583 },
+		{ 1490, 40990, 57020, 40887 },
+		{ 1500, 41220, 57020, 40616 },
+		{ 1510, 41220, 57020, 40063 },
+		{ 1520, 41440, 57020, 39894 },
+		{ 1530, 41440, 57020, 40249 },
+		{ 1540, 41670, 57020, 40859 },
+		{ 1550, 41670, 57020, 40249 },
+		{ 1560, 41890, 57020, 40099 },
+		{ 1570, 41890, 57020, 40137 },
+		{ 1580, 42110, 57020, 39817 },
+		{ 1590, 42110, 57020, 40368 },
+		{ 1600, 42340, 57020, 39928 },
+		{ 1610, 42340, 57020, 40531 },
+		{ 1620, 42560, 57020, 39426 },
+		{ 1630, 42560, 57020, 40486 },
+		{ 1640, 42780, 57020, 40083 },
+		{ 1650, 42780, 57020, 39548 },
+		{ 1660, 43000, 57020, 40600 },
+		{ 1670, 43000, 57020, 40185 },
+		{ 1680, 43220, 57020, 39388 },
+		{ 1690, 43220, 57020, 39915 },
+		{ 1700, 43450, 57020, 40366 },
+		{ 1710, 43450, 57020, 40052 },
+		{ 1720, 43670, 57020, 40532 },
+		{ 1730, 43670, 57020, 40504 },
+		{ 1740, 43900, 57020, 40456 },
+		{ 1750, 43900, 57020, 40306 },
+		{ 1760, 44120, 57020, 40693 },
+		{ 1770, 44120, 57020, 40409 },
+		{ 1780, 44350, 57020, 40310 },
+		{ 1790, 44350, 57020, 39281 },
+	};
+
+	// the sample the adapter was plugged in at
+	const size_t battery_trace_plugged = 120;
+}
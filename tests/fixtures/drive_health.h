@@ -0,0 +1,92 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+// health pages as returned by the drives, see drive_health
+namespace fixtures {
+	// NVMe health log page of a 1 TB drive with 5342 power on hours
+	const unsigned char nvme_health_log[512] = {
+		0x00, 0x39, 0x01, 0x64, 0x0a, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x3f, 0x92, 0xe0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xca, 0x55, 0xaf, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x01, 0xc0, 0x68, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xed, 0xdd, 0x44, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x6d, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xa3, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xf3, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x01, 0x45, 0x01,
+	};
+
+	// the same drive worn out: spare below threshold, critical warning set, no temperature reported
+	const unsigned char nvme_warning_log[512] = {
+		0x01, 0x00, 0x00, 0x08, 0x0a, 0x68, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x3f, 0x92, 0xe0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xca, 0x55, 0xaf, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x01, 0xc0, 0x68, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xed, 0xdd, 0x44, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x6d, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xa3, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xd4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xf3, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x01, 0x45, 0x01,
+	};
+
+	// SMART attributes of a SATA SSD, wear from attribute 177
+	const unsigned char ata_ssd_attributes[512] = {
+		0x10, 0x00, 0x05, 0x33, 0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x32,
+		0x00, 0x61, 0x61, 0x49, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x32, 0x00, 0x62, 0x62, 0x3e,
+		0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb1, 0x13, 0x00, 0x60, 0x60, 0x29, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0xb3, 0x13, 0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x32,
+		0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb6, 0x32, 0x00, 0x64, 0x64, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb7, 0x13, 0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0xbb, 0x32, 0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x32,
+		0x00, 0x41, 0x34, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc3, 0x1a, 0x00, 0xc8, 0xc8, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc7, 0x3e, 0x00, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0xeb, 0x12, 0x00, 0x63, 0x63, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf1, 0x32,
+		0x00, 0x63, 0x63, 0x5c, 0xf8, 0x60, 0xe9, 0x08,
+	};
+
+	// SMART attributes of a hard disk with reallocated and pending sectors
+	const unsigned char ata_failing_disk_attributes[512] = {
+		0x10, 0x00, 0x01, 0x2f, 0x00, 0x75, 0x63, 0xa1, 0xb7, 0x09, 0x00, 0x00, 0x00, 0x00, 0x03, 0x27,
+		0x00, 0x61, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x32, 0x00, 0x62, 0x62, 0x71,
+		0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x33, 0x00, 0x63, 0x63, 0x18, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x07, 0x2f, 0x00, 0x50, 0x3c, 0x1b, 0x2f, 0x3e, 0x6a, 0x00, 0x00, 0x00, 0x09, 0x32,
+		0x00, 0x47, 0x47, 0x01, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x33, 0x00, 0x64, 0x64, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x32, 0x00, 0x62, 0x62, 0xa2, 0x09, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0xbb, 0x32, 0x00, 0x61, 0x61, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x32,
+		0x00, 0x64, 0x64, 0x2d, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc2, 0x22, 0x00, 0x24, 0x33, 0x24,
+		0x00, 0x0c, 0x00, 0x14, 0x00, 0x00, 0xc5, 0x12, 0x00, 0x64, 0x64, 0x08, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0xc6, 0x10, 0x00, 0x64, 0x64, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc7, 0x3e,
+		0x00, 0xc8, 0xc8,
+	};
+}
@@ -0,0 +1,60 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+// raw EDIDs as Windows keeps them in the monitor's hardware key
+namespace fixtures {
+	// Dell U2415: base block and a CTA-861 extension with TV timings
+	const unsigned char dell_u2415[256] = {
+		0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x10, 0xac, 0xba, 0xa0, 0x30, 0x4d, 0x5a, 0x4c,
+		0x14, 0x1c, 0x01, 0x04, 0xa5, 0x34, 0x20, 0x78, 0x3a, 0xfd, 0x25, 0xa3, 0x54, 0x4c, 0x99, 0x26,
+		0x0f, 0x50, 0x54, 0xa5, 0x4b, 0x00, 0xd1, 0x00, 0xb3, 0x00, 0xa9, 0xc0, 0x81, 0x00, 0x81, 0x80,
+		0x71, 0x4f, 0x01, 0x01, 0x01, 0x01, 0x28, 0x3c, 0x80, 0xa0, 0x70, 0xb0, 0x23, 0x40, 0x30, 0x20,
+		0x36, 0x00, 0x06, 0x44, 0x21, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x00, 0xff, 0x00, 0x37, 0x4d, 0x54,
+		0x30, 0x31, 0x38, 0x35, 0x53, 0x30, 0x4c, 0x5a, 0x4c, 0x0a, 0x00, 0x00, 0x00, 0xfc, 0x00, 0x44,
+		0x45, 0x4c, 0x4c, 0x20, 0x55, 0x32, 0x34, 0x31, 0x35, 0x0a, 0x20, 0x20, 0x00, 0x00, 0x00, 0xfd,
+		0x00, 0x38, 0x4c, 0x1e, 0x53, 0x11, 0x00, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x01, 0x47,
+		0x02, 0x03, 0x13, 0xf1, 0x44, 0x90, 0x04, 0x02, 0x1f, 0x23, 0x09, 0x07, 0x07, 0x65, 0x03, 0x0c,
+		0x00, 0x10, 0x00, 0x02, 0x3a, 0x80, 0x18, 0x71, 0x38, 0x2d, 0x40, 0x58, 0x2c, 0x45, 0x00, 0x06,
+		0x44, 0x21, 0x00, 0x00, 0x1a, 0x01, 0x1d, 0x00, 0x72, 0x51, 0xd0, 0x1e, 0x20, 0x6e, 0x28, 0x55,
+		0x00, 0x06, 0x44, 0x21, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa9,
+	};
+
+	// 16 inch 2560x1600 laptop panel: 120 Hz and 60 Hz detailed timings, no extensions
+	const unsigned char laptop_panel[128] = {
+		0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x09, 0xe5, 0x8b, 0x0a, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x1f, 0x01, 0x03, 0x80, 0x22, 0x16, 0x78, 0x3a, 0xfd, 0x25, 0xa3, 0x54, 0x4c, 0x99, 0x26,
+		0x0f, 0x50, 0x54, 0xa5, 0x4b, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xdd, 0xd1, 0x00, 0xa0, 0xa0, 0x40, 0x2e, 0x60, 0x30, 0x20,
+		0x36, 0x00, 0x59, 0xd7, 0x10, 0x00, 0x00, 0x1a, 0xef, 0x68, 0x00, 0xa0, 0xa0, 0x40, 0x2e, 0x60,
+		0x30, 0x20, 0x36, 0x00, 0x59, 0xd7, 0x10, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x42,
+		0x4f, 0x45, 0x20, 0x43, 0x51, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0xfe,
+		0x00, 0x4e, 0x45, 0x31, 0x36, 0x30, 0x51, 0x44, 0x4d, 0x2d, 0x4e, 0x59, 0x31, 0x0a, 0x00, 0xd3,
+	};
+}
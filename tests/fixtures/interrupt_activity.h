@@ -0,0 +1,108 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+
+namespace fixtures {
+	// the layouts the kernel returns, see interrupt_activity.cpp
+	struct processor_performance_information {
+		LARGE_INTEGER IdleTime;
+		LARGE_INTEGER KernelTime;
+		LARGE_INTEGER UserTime;
+		LARGE_INTEGER DpcTime;
+		LARGE_INTEGER InterruptTime;
+		ULONG InterruptCount;
+	};
+
+	struct system_interrupt_information {
+		ULONG ContextSwitches;
+		ULONG DpcCount;
+		ULONG DpcRate;
+		ULONG TimeIncrement;
+		ULONG DpcBypassCount;
+		ULONG ApcBypassCount;
+	};
+
+	struct interrupt_counters {
+		std::vector<processor_performance_information> performance;
+		std::vector<system_interrupt_information> interrupts;
+	};
+
+	/// <summary>
+	/// The counters of a 256 processor server, a given number of seconds in. The network card's
+	/// interrupts all land on cores 0 and 64, the first of each NUMA node, every other core only
+	/// takes the clock and the odd IPI. Core 0's interrupt count is about to wrap.
+	/// </summary>
+	inline interrupt_counters server_256(unsigned long seconds) {
+		const size_t processors = 256;
+		interrupt_counters counters;
+		counters.performance.resize(processors);
+		counters.interrupts.resize(processors);
+
+		for (size_t p = 0; p < processors; p++) {
+			auto& performance = counters.performance[p];
+			auto& interrupts = counters.interrupts[p];
+
+			// counters carried over from before the first snapshot
+			const LONGLONG uptime = 36000LL * 10000000LL;
+			ULONG interrupt_count = static_cast<ULONG>(p * 104729);
+			ULONG dpc_count = static_cast<ULONG>(p * 7919);
+
+			// per second: interrupts, DPCs, and the time in each in 100ns units
+			ULONG interrupt_rate = 120, dpc_rate = 60;
+			LONGLONG interrupt_time = 2000, dpc_time = 1000;
+
+			if (p == 0) {
+				interrupt_count = 0xfffff000;
+				interrupt_rate = 40000;
+				dpc_rate = 25000;
+				interrupt_time = 600000;
+				dpc_time = 300000;
+			}
+			else if (p == 64) {
+				interrupt_rate = 28000;
+				dpc_rate = 18000;
+				interrupt_time = 400000;
+				dpc_time = 200000;
+			}
+
+			// the kernel time includes the idle, interrupt and DPC time
+			performance.KernelTime.QuadPart = uptime * 9 / 10 + 9000000LL * seconds;
+			performance.UserTime.QuadPart = uptime / 10 + 1000000LL * seconds;
+			performance.IdleTime.QuadPart = performance.KernelTime.QuadPart / 2;
+			performance.InterruptTime.QuadPart = uptime / 1000 + interrupt_time * seconds;
+			performance.DpcTime.QuadPart = uptime / 2000 + dpc_time * seconds;
+			performance.InterruptCount = interrupt_count + interrupt_rate * seconds;
+
+			interrupts.ContextSwitches = static_cast<ULONG>(p * 31 + 5000 * seconds);
+			interrupts.DpcCount = dpc_count + dpc_rate * seconds;
+			interrupts.TimeIncrement = 156250;
+		}
+
+		return counters;
+	}
+}
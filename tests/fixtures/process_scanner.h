@@ -0,0 +1,130 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <winternl.h>
+#include <string>
+#include <vector>
+
+namespace fixtures {
+	// the full layout of SYSTEM_PROCESS_INFORMATION, see process_scanner.cpp
+	struct system_process_information {
+		ULONG NextEntryOffset;
+		ULONG NumberOfThreads;
+		LARGE_INTEGER WorkingSetPrivateSize;
+		ULONG HardFaultCount;
+		ULONG NumberOfThreadsHighWatermark;
+		ULONGLONG CycleTime;
+		LARGE_INTEGER CreateTime;
+		LARGE_INTEGER UserTime;
+		LARGE_INTEGER KernelTime;
+		UNICODE_STRING ImageName;
+		LONG BasePriority;
+		HANDLE UniqueProcessId;
+		HANDLE InheritedFromUniqueProcessId;
+		ULONG HandleCount;
+		ULONG SessionId;
+		ULONG_PTR UniqueProcessKey;
+		SIZE_T PeakVirtualSize;
+		SIZE_T VirtualSize;
+		ULONG PageFaultCount;
+		SIZE_T PeakWorkingSetSize;
+		SIZE_T WorkingSetSize;
+		SIZE_T QuotaPeakPagedPoolUsage;
+		SIZE_T QuotaPagedPoolUsage;
+		SIZE_T QuotaPeakNonPagedPoolUsage;
+		SIZE_T QuotaNonPagedPoolUsage;
+		SIZE_T PagefileUsage;
+		SIZE_T PeakPagefileUsage;
+		SIZE_T PrivatePageCount;
+		LARGE_INTEGER IoCounters[6];
+	};
+
+	struct process {
+		unsigned long pid;
+		std::string name;
+		long long create_time;
+		long long cpu_time;	// 100ns units
+		unsigned long long working_set;
+		unsigned long threads;
+	};
+
+	/// <summary>
+	/// Lay out a process table as the kernel returns it, each entry followed by its name. The
+	/// names point into the table, so it must not be copied, only moved.
+	/// </summary>
+	inline std::vector<unsigned char> process_table(const std::vector<process>& processes) {
+		const size_t name_size = 64;
+		const size_t entry_size = (sizeof(system_process_information) + name_size * sizeof(WCHAR) + 7) & ~static_cast<size_t>(7);
+		std::vector<unsigned char> table(entry_size * processes.size());
+
+		for (size_t i = 0; i < processes.size(); i++) {
+			const auto& process = processes[i];
+			auto entry = reinterpret_cast<system_process_information*>(table.data() + i * entry_size);
+			auto name = reinterpret_cast<WCHAR*>(table.data() + i * entry_size + sizeof(system_process_information));
+
+			for (size_t c = 0; c < process.name.size() && c < name_size; c++)
+				name[c] = static_cast<WCHAR>(process.name[c]);
+
+			entry->NextEntryOffset = i + 1 < processes.size() ? static_cast<ULONG>(entry_size) : 0;
+			entry->NumberOfThreads = process.threads;
+			entry->CreateTime.QuadPart = process.create_time;
+			entry->KernelTime.QuadPart = process.cpu_time / 4;
+			entry->UserTime.QuadPart = process.cpu_time - process.cpu_time / 4;
+			entry->ImageName.Buffer = process.name.empty() ? nullptr : name;
+			entry->ImageName.Length = static_cast<USHORT>(process.name.size() * sizeof(WCHAR));
+			entry->ImageName.MaximumLength = entry->ImageName.Length;
+			entry->UniqueProcessId = reinterpret_cast<HANDLE>(static_cast<ULONG_PTR>(process.pid));
+			entry->WorkingSetSize = static_cast<SIZE_T>(process.working_set);
+			entry->PrivatePageCount = static_cast<SIZE_T>(process.working_set / 2);
+		}
+
+		return table;
+	}
+
+	/// <summary>
+	/// A desktop a given number of seconds in: the idle process, the system, a browser with a
+	/// busy tab, an editor, and a compiler that starts after the first second.
+	/// </summary>
+	inline std::vector<process> desktop(long long seconds) {
+		const long long second = 10000000;
+		const unsigned long long mb = 1024 * 1024;
+
+		std::vector<process> processes = {
+			{ 0, "", 0, 7 * second * seconds, 8 * 1024, 8 },
+			{ 4, "System", 1, second / 100 * seconds, 2 * mb, 220 },
+			{ 1200, "explorer.exe", 50, second / 50 * seconds, 180 * mb, 90 },
+			{ 3400, "chrome.exe", 900, second / 10 * seconds, 420 * mb, 40 },
+			{ 3480, "chrome.exe", 910, second / 2 * seconds, 310 * mb, 22 },
+			{ 5120, "code.exe", 1500, 0, 650 * mb, 60 },
+		};
+
+		if (seconds >= 2)
+			processes.push_back({ 7000, "cl.exe", 2000, second * (seconds - 2), 95 * mb, 4 });
+
+		return processes;
+	}
+}
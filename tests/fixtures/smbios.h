@@ -0,0 +1,162 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+// raw SMBIOS tables as GetSystemFirmwareTable returns them, with the 8 byte header in front
+namespace fixtures {
+	// Dell OptiPlex 7070, SMBIOS 3.2: one 8 GB DDR4 DIMM and an empty slot
+	const unsigned char dell_optiplex_7070[489] = {
+		0x00, 0x03, 0x02, 0x00, 0xe1, 0x01, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x01, 0x02, 0x00, 0xf0,
+		0x03, 0xff, 0x00, 0x98, 0xab, 0xb4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x06, 0xff, 0xff,
+		0x00, 0x00, 0x44, 0x65, 0x6c, 0x6c, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x00, 0x31, 0x2e, 0x36, 0x2e,
+		0x33, 0x00, 0x30, 0x34, 0x2f, 0x31, 0x33, 0x2f, 0x32, 0x30, 0x32, 0x30, 0x00, 0x00, 0x01, 0x1b,
+		0x00, 0x01, 0x01, 0x02, 0x00, 0x03, 0x33, 0x34, 0x51, 0x4f, 0xc0, 0xb7, 0x47, 0x80, 0x38, 0x10,
+		0x53, 0x00, 0x44, 0x45, 0x4c, 0x4c, 0x06, 0x04, 0x05, 0x44, 0x65, 0x6c, 0x6c, 0x20, 0x49, 0x6e,
+		0x63, 0x2e, 0x00, 0x4f, 0x70, 0x74, 0x69, 0x50, 0x6c, 0x65, 0x78, 0x20, 0x37, 0x30, 0x37, 0x30,
+		0x00, 0x37, 0x58, 0x4b, 0x32, 0x51, 0x34, 0x33, 0x00, 0x30, 0x38, 0x35, 0x41, 0x00, 0x4f, 0x70,
+		0x74, 0x69, 0x50, 0x6c, 0x65, 0x78, 0x00, 0x00, 0x02, 0x0f, 0x00, 0x02, 0x01, 0x02, 0x03, 0x04,
+		0x00, 0x09, 0x00, 0x00, 0x03, 0x0a, 0x00, 0x44, 0x65, 0x6c, 0x6c, 0x20, 0x49, 0x6e, 0x63, 0x2e,
+		0x00, 0x30, 0x59, 0x4e, 0x56, 0x4a, 0x47, 0x00, 0x41, 0x30, 0x30, 0x00, 0x2f, 0x37, 0x58, 0x4b,
+		0x32, 0x51, 0x34, 0x33, 0x2f, 0x43, 0x4e, 0x43, 0x4d, 0x4b, 0x30, 0x30, 0x30, 0x31, 0x41, 0x30,
+		0x31, 0x32, 0x33, 0x2f, 0x00, 0x00, 0x03, 0x15, 0x00, 0x03, 0x01, 0x03, 0x00, 0x00, 0x00, 0x03,
+		0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x65, 0x6c, 0x6c, 0x20,
+		0x49, 0x6e, 0x63, 0x2e, 0x00, 0x00, 0x11, 0x54, 0x00, 0x11, 0x00, 0x10, 0xfe, 0xff, 0x40, 0x00,
+		0x40, 0x00, 0x00, 0x20, 0x09, 0x00, 0x01, 0x02, 0x1a, 0x80, 0x00, 0x6a, 0x0a, 0x03, 0x04, 0x00,
+		0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6a, 0x0a, 0xb0, 0x04, 0xb0, 0x04, 0xb0, 0x04, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x49, 0x4d, 0x4d, 0x31, 0x00,
+		0x4e, 0x6f, 0x74, 0x20, 0x53, 0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65, 0x64, 0x00, 0x38, 0x30,
+		0x41, 0x44, 0x30, 0x30, 0x30, 0x30, 0x38, 0x30, 0x41, 0x44, 0x00, 0x32, 0x45, 0x33, 0x41, 0x39,
+		0x46, 0x30, 0x31, 0x00, 0x48, 0x4d, 0x41, 0x38, 0x31, 0x47, 0x55, 0x36, 0x43, 0x4a, 0x52, 0x38,
+		0x4e, 0x2d, 0x56, 0x4b, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x11, 0x54, 0x01, 0x11, 0x00, 0x10,
+		0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x02, 0x00, 0x01, 0x02, 0x02, 0x04, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x49,
+		0x4d, 0x4d, 0x32, 0x00, 0x4e, 0x6f, 0x74, 0x20, 0x53, 0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65,
+		0x64, 0x00, 0x00, 0x7f, 0x04, 0x00, 0x7f,
+	};
+
+	// Lenovo ThinkPad X1 Carbon Gen 10, SMBIOS 3.3: soldered LPDDR5
+	const unsigned char lenovo_thinkpad_x1_carbon[648] = {
+		0x00, 0x03, 0x03, 0x00, 0x80, 0x02, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x01, 0x02, 0x00, 0xf0,
+		0x03, 0xff, 0x00, 0x98, 0xab, 0xb4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x25, 0xff, 0xff,
+		0x00, 0x00, 0x4c, 0x45, 0x4e, 0x4f, 0x56, 0x4f, 0x00, 0x4e, 0x33, 0x41, 0x45, 0x54, 0x37, 0x32,
+		0x57, 0x20, 0x28, 0x31, 0x2e, 0x33, 0x37, 0x20, 0x29, 0x00, 0x30, 0x35, 0x2f, 0x31, 0x38, 0x2f,
+		0x32, 0x30, 0x32, 0x33, 0x00, 0x00, 0x01, 0x1b, 0x01, 0x00, 0x01, 0x02, 0x03, 0x04, 0x33, 0x34,
+		0x51, 0x4f, 0xc0, 0xb7, 0x47, 0x80, 0x38, 0x10, 0x53, 0x00, 0x44, 0x45, 0x4c, 0x4c, 0x06, 0x05,
+		0x03, 0x4c, 0x45, 0x4e, 0x4f, 0x56, 0x4f, 0x00, 0x32, 0x31, 0x43, 0x42, 0x30, 0x30, 0x30, 0x47,
+		0x55, 0x53, 0x00, 0x54, 0x68, 0x69, 0x6e, 0x6b, 0x50, 0x61, 0x64, 0x20, 0x58, 0x31, 0x20, 0x43,
+		0x61, 0x72, 0x62, 0x6f, 0x6e, 0x20, 0x47, 0x65, 0x6e, 0x20, 0x31, 0x30, 0x00, 0x50, 0x46, 0x33,
+		0x58, 0x4b, 0x32, 0x51, 0x41, 0x00, 0x4c, 0x45, 0x4e, 0x4f, 0x56, 0x4f, 0x5f, 0x4d, 0x54, 0x5f,
+		0x32, 0x31, 0x43, 0x42, 0x5f, 0x42, 0x55, 0x5f, 0x54, 0x68, 0x69, 0x6e, 0x6b, 0x5f, 0x46, 0x4d,
+		0x5f, 0x54, 0x68, 0x69, 0x6e, 0x6b, 0x50, 0x61, 0x64, 0x20, 0x58, 0x31, 0x20, 0x43, 0x61, 0x72,
+		0x62, 0x6f, 0x6e, 0x20, 0x47, 0x65, 0x6e, 0x20, 0x31, 0x30, 0x00, 0x00, 0x02, 0x0f, 0x02, 0x00,
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x09, 0x06, 0x00, 0x03, 0x0a, 0x00, 0x4c, 0x45, 0x4e, 0x4f, 0x56,
+		0x4f, 0x00, 0x32, 0x31, 0x43, 0x42, 0x30, 0x30, 0x30, 0x47, 0x55, 0x53, 0x00, 0x53, 0x44, 0x4b,
+		0x30, 0x54, 0x37, 0x36, 0x35, 0x33, 0x30, 0x20, 0x57, 0x49, 0x4e, 0x00, 0x4c, 0x31, 0x48, 0x46,
+		0x32, 0x41, 0x42, 0x30, 0x30, 0x41, 0x42, 0x00, 0x4e, 0x6f, 0x74, 0x20, 0x41, 0x76, 0x61, 0x69,
+		0x6c, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x4e, 0x6f, 0x74, 0x20, 0x41, 0x76, 0x61, 0x69, 0x6c, 0x61,
+		0x62, 0x6c, 0x65, 0x00, 0x00, 0x03, 0x15, 0x03, 0x00, 0x01, 0x0a, 0x00, 0x00, 0x00, 0x03, 0x03,
+		0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x45, 0x4e, 0x4f, 0x56, 0x4f,
+		0x00, 0x00, 0x11, 0x5c, 0x40, 0x00, 0x00, 0x10, 0xfe, 0xff, 0x40, 0x00, 0x40, 0x00, 0x00, 0x20,
+		0x0b, 0x00, 0x01, 0x02, 0x23, 0x80, 0x40, 0x50, 0x14, 0x03, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x50, 0x14, 0xb0, 0x04, 0xb0, 0x04, 0xb0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0x6f,
+		0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x30, 0x2d, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65,
+		0x6c, 0x41, 0x2d, 0x44, 0x49, 0x4d, 0x4d, 0x30, 0x00, 0x42, 0x41, 0x4e, 0x4b, 0x20, 0x30, 0x00,
+		0x53, 0x61, 0x6d, 0x73, 0x75, 0x6e, 0x67, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+		0x00, 0x4b, 0x33, 0x4c, 0x4b, 0x43, 0x4b, 0x43, 0x30, 0x42, 0x4d, 0x2d, 0x4d, 0x47, 0x43, 0x50,
+		0x00, 0x00, 0x11, 0x5c, 0x41, 0x00, 0x00, 0x10, 0xfe, 0xff, 0x40, 0x00, 0x40, 0x00, 0x00, 0x20,
+		0x0b, 0x00, 0x01, 0x02, 0x23, 0x80, 0x40, 0x50, 0x14, 0x03, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x50, 0x14, 0xb0, 0x04, 0xb0, 0x04, 0xb0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0x6f,
+		0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x6c, 0x65, 0x72, 0x31, 0x2d, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65,
+		0x6c, 0x41, 0x2d, 0x44, 0x49, 0x4d, 0x4d, 0x30, 0x00, 0x42, 0x41, 0x4e, 0x4b, 0x20, 0x30, 0x00,
+		0x53, 0x61, 0x6d, 0x73, 0x75, 0x6e, 0x67, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+		0x00, 0x4b, 0x33, 0x4c, 0x4b, 0x43, 0x4b, 0x43, 0x30, 0x42, 0x4d, 0x2d, 0x4d, 0x47, 0x43, 0x50,
+		0x00, 0x00, 0x7f, 0x04, 0xff, 0xfe,
+	};
+
+	// Supermicro X11DPi server board, SMBIOS 3.1: 64 GB RDIMMs in the extended size field, an add-in board
+	const unsigned char supermicro_x11dpi[796] = {
+		0x00, 0x03, 0x01, 0x00, 0x14, 0x03, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x01, 0x02, 0x00, 0xf0,
+		0x03, 0xff, 0x00, 0x98, 0xab, 0xb4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x0e, 0xff, 0xff,
+		0x00, 0x00, 0x41, 0x6d, 0x65, 0x72, 0x69, 0x63, 0x61, 0x6e, 0x20, 0x4d, 0x65, 0x67, 0x61, 0x74,
+		0x72, 0x65, 0x6e, 0x64, 0x73, 0x20, 0x49, 0x6e, 0x63, 0x2e, 0x00, 0x33, 0x2e, 0x34, 0x00, 0x31,
+		0x31, 0x2f, 0x30, 0x34, 0x2f, 0x32, 0x30, 0x32, 0x30, 0x00, 0x00, 0x01, 0x1b, 0x01, 0x00, 0x01,
+		0x02, 0x03, 0x04, 0x33, 0x34, 0x51, 0x4f, 0xc0, 0xb7, 0x47, 0x80, 0x38, 0x10, 0x53, 0x00, 0x44,
+		0x45, 0x4c, 0x4c, 0x06, 0x05, 0x05, 0x53, 0x75, 0x70, 0x65, 0x72, 0x6d, 0x69, 0x63, 0x72, 0x6f,
+		0x00, 0x53, 0x59, 0x53, 0x2d, 0x36, 0x30, 0x31, 0x39, 0x50, 0x2d, 0x4d, 0x54, 0x52, 0x00, 0x30,
+		0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x00, 0x41, 0x33, 0x32, 0x38, 0x34, 0x31,
+		0x30, 0x58, 0x30, 0x42, 0x30, 0x31, 0x32, 0x33, 0x34, 0x00, 0x54, 0x6f, 0x20, 0x62, 0x65, 0x20,
+		0x66, 0x69, 0x6c, 0x6c, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x4f, 0x2e, 0x45, 0x2e, 0x4d, 0x2e,
+		0x00, 0x00, 0x02, 0x0f, 0x02, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x09, 0x06, 0x00, 0x03, 0x0a,
+		0x00, 0x53, 0x75, 0x70, 0x65, 0x72, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x00, 0x58, 0x31, 0x31, 0x44,
+		0x50, 0x69, 0x2d, 0x4e, 0x28, 0x54, 0x29, 0x00, 0x31, 0x2e, 0x31, 0x30, 0x00, 0x5a, 0x4d, 0x31,
+		0x39, 0x42, 0x53, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x00, 0x42, 0x61, 0x73, 0x65, 0x20, 0x42,
+		0x6f, 0x61, 0x72, 0x64, 0x20, 0x41, 0x73, 0x73, 0x65, 0x74, 0x20, 0x54, 0x61, 0x67, 0x67, 0x69,
+		0x6e, 0x67, 0x00, 0x50, 0x61, 0x72, 0x74, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e,
+		0x74, 0x00, 0x00, 0x02, 0x0f, 0x3e, 0x00, 0x01, 0x02, 0x03, 0x04, 0x00, 0x09, 0x00, 0x00, 0x03,
+		0x0a, 0x00, 0x53, 0x75, 0x70, 0x65, 0x72, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x00, 0x41, 0x4f, 0x43,
+		0x2d, 0x53, 0x32, 0x35, 0x47, 0x2d, 0x69, 0x32, 0x53, 0x00, 0x31, 0x2e, 0x30, 0x31, 0x00, 0x4f,
+		0x41, 0x31, 0x39, 0x43, 0x53, 0x30, 0x30, 0x31, 0x32, 0x33, 0x34, 0x00, 0x00, 0x11, 0x54, 0x2a,
+		0x00, 0x00, 0x10, 0xfe, 0xff, 0x40, 0x00, 0x40, 0x00, 0xff, 0x7f, 0x09, 0x00, 0x01, 0x02, 0x1a,
+		0x80, 0x20, 0x75, 0x0b, 0x03, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x75, 0x0b, 0xb0,
+		0x04, 0xb0, 0x04, 0xb0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x50, 0x31, 0x2d, 0x44, 0x49, 0x4d, 0x4d, 0x41, 0x31, 0x00, 0x50, 0x30, 0x5f, 0x4e, 0x6f,
+		0x64, 0x65, 0x30, 0x5f, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x5f, 0x44, 0x69, 0x6d,
+		0x6d, 0x30, 0x00, 0x53, 0x61, 0x6d, 0x73, 0x75, 0x6e, 0x67, 0x00, 0x30, 0x34, 0x43, 0x42, 0x33,
+		0x41, 0x31, 0x32, 0x00, 0x4d, 0x33, 0x39, 0x33, 0x41, 0x38, 0x47, 0x34, 0x30, 0x41, 0x42, 0x32,
+		0x2d, 0x43, 0x57, 0x45, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x11, 0x54, 0x2b, 0x00, 0x00, 0x10,
+		0xfe, 0xff, 0x40, 0x00, 0x40, 0x00, 0xff, 0xff, 0x09, 0x00, 0x01, 0x02, 0x02, 0x02, 0x00, 0x00,
+		0x00, 0x03, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb0, 0x04, 0xb0, 0x04,
+		0xb0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x31,
+		0x2d, 0x44, 0x49, 0x4d, 0x4d, 0x41, 0x32, 0x00, 0x50, 0x30, 0x5f, 0x4e, 0x6f, 0x64, 0x65, 0x30,
+		0x5f, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x5f, 0x44, 0x69, 0x6d, 0x6d, 0x31, 0x00,
+		0x4e, 0x4f, 0x20, 0x44, 0x49, 0x4d, 0x4d, 0x00, 0x4e, 0x4f, 0x20, 0x44, 0x49, 0x4d, 0x4d, 0x00,
+		0x4e, 0x4f, 0x20, 0x44, 0x49, 0x4d, 0x4d, 0x00, 0x00, 0x11, 0x54, 0x2c, 0x00, 0x00, 0x10, 0xfe,
+		0xff, 0x40, 0x00, 0x40, 0x00, 0xff, 0x7f, 0x09, 0x00, 0x01, 0x02, 0x1a, 0x80, 0x20, 0x75, 0x0b,
+		0x03, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x75, 0x0b, 0xb0, 0x04, 0xb0, 0x04, 0xb0,
+		0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x32, 0x2d,
+		0x44, 0x49, 0x4d, 0x4d, 0x41, 0x31, 0x00, 0x50, 0x31, 0x5f, 0x4e, 0x6f, 0x64, 0x65, 0x31, 0x5f,
+		0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x5f, 0x44, 0x69, 0x6d, 0x6d, 0x30, 0x00, 0x53,
+		0x61, 0x6d, 0x73, 0x75, 0x6e, 0x67, 0x00, 0x30, 0x34, 0x43, 0x42, 0x33, 0x42, 0x37, 0x37, 0x00,
+		0x4d, 0x33, 0x39, 0x33, 0x41, 0x38, 0x47, 0x34, 0x30, 0x41, 0x42, 0x32, 0x2d, 0x43, 0x57, 0x45,
+		0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x7f, 0x04, 0x7f,
+	};
+}
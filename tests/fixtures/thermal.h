@@ -0,0 +1,58 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+// thermal zone instance names, as the performance counters and WMI list them on a few machines
+namespace fixtures {
+	struct thermal_zone {
+		const char* counter_instance;
+		const char* wmi_instance;
+		const char* zone;
+		bool cpu;
+	};
+
+	const thermal_zone thermal_zones[] = {
+		// Lenovo ThinkPad
+		{ "\\_TZ.THM0", "ACPI\\ThermalZone\\THM0_0", "THM0", false },
+
+		// HP EliteBook
+		{ "\\_TZ.CPUZ", "ACPI\\ThermalZone\\CPUZ_0", "CPUZ", true },
+		{ "\\_TZ.GFXZ", "ACPI\\ThermalZone\\GFXZ_0", "GFXZ", false },
+		{ "\\_TZ.EXTZ", "ACPI\\ThermalZone\\EXTZ_0", "EXTZ", false },
+		{ "\\_TZ.LOCZ", "ACPI\\ThermalZone\\LOCZ_0", "LOCZ", false },
+		{ "\\_TZ.BATZ", "ACPI\\ThermalZone\\BATZ_0", "BATZ", false },
+
+		// Intel reference firmware, e.g. many Dell and MSI laptops
+		{ "\\_TZ.TZ00", "ACPI\\ThermalZone\\TZ00_0", "TZ00", false },
+		{ "\\_TZ.TZ01", "ACPI\\ThermalZone\\TZ01_0", "TZ01", false },
+
+		// Microsoft Surface
+		{ "\\_TZ.TCPU", "ACPI\\ThermalZone\\TCPU_0", "TCPU", true },
+		{ "\\_TZ.SKIN", "ACPI\\ThermalZone\\SKIN_0", "SKIN", false },
+
+		// ASUS, zone names in lower case
+		{ "\\_TZ.PKGz", "ACPI\\ThermalZone\\PKGz_0", "PKGZ", true },
+	};
+}
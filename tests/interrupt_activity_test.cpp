@@ -0,0 +1,133 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/interrupt_activity.h"
+#include "../collectors/interrupt_activity.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+	const long long second = 10000000;
+
+	void replay(interrupt_activity& activity, const fixtures::interrupt_counters& counters, long long time,
+		interrupt_activity::activity_info& info) {
+		activity.replay(reinterpret_cast<const unsigned char*>(counters.performance.data()),
+			reinterpret_cast<const unsigned char*>(counters.interrupts.data()),
+			counters.performance.size(), time, info);
+	}
+}
+
+TEST_CASE(interrupt_activity_server_256) {
+	interrupt_activity activity;
+	interrupt_activity::activity_info info;
+
+	// the first snapshot only primes the counters
+	replay(activity, fixtures::server_256(0), second, info);
+	CHECK(info.cores.empty());
+	CHECK(interrupt_activity::summary(info) == "Measuring ...");
+
+	replay(activity, fixtures::server_256(1), 2 * second, info);
+	CHECK(info.cores.size() == 256);
+
+	if (info.cores.size() != 256)
+		return;
+
+	// core 0's count wrapped, the rate must not
+	CHECK_NEAR(info.cores[0].interrupts, 40000.0, 0.001);
+	CHECK_NEAR(info.cores[0].dpcs, 25000.0, 0.001);
+	CHECK_NEAR(info.cores[0].interrupt_time, 6.0, 0.001);
+	CHECK_NEAR(info.cores[0].dpc_time, 3.0, 0.001);
+	CHECK_NEAR(info.cores[64].interrupts, 28000.0, 0.001);
+	CHECK_NEAR(info.cores[255].interrupts, 120.0, 0.001);
+	CHECK(info.cores[255].number == 255);
+
+	CHECK_NEAR(info.interrupts, 40000.0 + 28000.0 + 254 * 120.0, 0.01);
+	CHECK_NEAR(info.dpcs, 25000.0 + 18000.0 + 254 * 60.0, 0.01);
+	CHECK_NEAR(info.time, 100.0 * (900000.0 + 600000.0 + 254 * 3000.0) / (256 * 10000000.0), 0.0001);
+
+	// the two busy cores stand out, busiest first
+	CHECK(info.hot_spots.size() == 2);
+
+	if (info.hot_spots.size() == 2) {
+		CHECK(info.hot_spots[0] == 0);
+		CHECK(info.hot_spots[1] == 64);
+	}
+
+	CHECK(info.cores[0].hot_spot);
+	CHECK(!info.cores[1].hot_spot);
+	CHECK(interrupt_activity::hot_spot_text(info) == "Core 0 at 9.0%, core 64 at 6.0% (average 0.1%)");
+
+	// a steady load gives the same activity on the next snapshot
+	const auto previous = info;
+	replay(activity, fixtures::server_256(2), 3 * second, info);
+	CHECK(info == previous);
+}
+
+TEST_CASE(interrupt_activity_processor_change) {
+	interrupt_activity activity;
+	interrupt_activity::activity_info info;
+
+	replay(activity, fixtures::server_256(0), second, info);
+	replay(activity, fixtures::server_256(1), 2 * second, info);
+	CHECK(info.cores.size() == 256);
+
+	// processors brought online or offline start the counters afresh
+	auto counters = fixtures::server_256(2);
+	counters.performance.resize(128);
+	counters.interrupts.resize(128);
+	replay(activity, counters, 3 * second, info);
+	CHECK(info.cores.empty());
+}
+
+TEST_CASE(interrupt_activity_read_cost) {
+	// a large server's worth of cores, to show the read stays cheap; the snapshots are built
+	// up front so only the parsing is timed
+	const int passes = 1000;
+	std::vector<fixtures::interrupt_counters> snapshots;
+	for (int pass = 0; pass <= passes; pass++)
+		snapshots.push_back(fixtures::server_256(pass));
+
+	interrupt_activity activity;
+	interrupt_activity::activity_info info;
+	double total = 0.0;
+
+	for (int pass = 0; pass <= passes; pass++) {
+		const auto start = std::chrono::steady_clock::now();
+		replay(activity, snapshots[pass], (pass + 1) * second, info);
+
+		// the first pass only primes the counters
+		if (pass > 0)
+			total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	CHECK(info.cores.size() == 256);
+
+	const double cost = total / passes;
+	printf("interrupt_activity_read_cost: %.1fus per read of 256 cores\n", cost);
+
+	// well under a millisecond even on a slow machine, the refresh runs every second
+	CHECK(cost < 1000.0);
+}
@@ -0,0 +1,58 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+
+#include <cstdio>
+
+namespace {
+	int failures = 0;
+	const char* running = "";
+}
+
+std::vector<test::test_case>& test::cases() {
+	static std::vector<test_case> all;
+	return all;
+}
+
+void test::fail(const char* file, int line, const std::string& expression) {
+	printf("%s(%d): %s failed: %s\n", file, line, running, expression.c_str());
+	failures++;
+}
+
+/// <summary>
+/// Test entry point.
+/// </summary>
+/// <returns>
+/// Returns 1 if any check failed else returns 0.
+/// </returns>
+int main() {
+	for (const auto& test_case : test::cases()) {
+		running = test_case.name;
+		test_case.function();
+	}
+
+	printf("%zu test cases, %d failed checks\n", test::cases().size(), failures);
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/process_scanner.h"
+#include "../collectors/process_scanner.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+	const long long second = 10000000;
+
+	void replay(process_scanner& scanner, const std::vector<fixtures::process>& processes, long long time,
+		size_t top, process_scanner::scan_info& info) {
+		const auto table = fixtures::process_table(processes);
+		scanner.replay(table.data(), table.size(), time, top, info);
+	}
+
+	// cpu usage is shared across every logical processor
+	double share(double seconds) {
+		return 100.0 * seconds / GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	}
+}
+
+TEST_CASE(process_scanner_first_scan) {
+	process_scanner scanner;
+	process_scanner::scan_info info;
+	replay(scanner, fixtures::desktop(0), second, 3, info);
+
+	// the idle process counts towards the totals but is not listed
+	CHECK(info.processes == 6);
+	CHECK(info.threads == 8 + 220 + 90 + 40 + 22 + 60);
+	CHECK(info.top_cpu.size() == 3);
+	CHECK(info.top_memory.size() == 3);
+
+	// the first scan only primes the cpu times
+	for (const auto& process : info.top_cpu)
+		CHECK(process.cpu == 0.0);
+
+	if (info.top_memory.size() == 3) {
+		CHECK(info.top_memory[0].name == "code.exe");
+		CHECK(info.top_memory[1].pid == 3400);
+		CHECK(info.top_memory[2].pid == 3480);
+		CHECK(info.top_memory[0].working_set == 650ull * 1024 * 1024);
+		CHECK(info.top_memory[0].private_bytes == 325ull * 1024 * 1024);
+		CHECK(info.top_memory[0].threads == 60);
+	}
+
+	process_scanner::scan_info all;
+	replay(scanner, fixtures::desktop(0), 2 * second, 10, all);
+	CHECK(all.top_cpu.size() == 5);
+}
+
+TEST_CASE(process_scanner_cpu) {
+	process_scanner scanner;
+	process_scanner::scan_info info;
+	replay(scanner, fixtures::desktop(0), second, 10, info);
+	replay(scanner, fixtures::desktop(1), 2 * second, 10, info);
+
+	CHECK(info.top_cpu.size() == 5);
+
+	if (info.top_cpu.size() == 5) {
+		CHECK(info.top_cpu[0].pid == 3480);
+		CHECK_NEAR(info.top_cpu[0].cpu, share(0.5), 0.0001);
+		CHECK(info.top_cpu[1].pid == 3400);
+		CHECK_NEAR(info.top_cpu[1].cpu, share(0.1), 0.0001);
+		CHECK_NEAR(info.top_cpu[4].cpu, 0.0, 0.0001);
+	}
+
+	// a process that starts between scans is primed, then counted
+	replay(scanner, fixtures::desktop(3), 3 * second, 10, info);
+	CHECK(info.processes == 7);
+	CHECK(info.top_cpu.size() == 6);
+
+	for (const auto& process : info.top_cpu)
+		if (process.pid == 7000)
+			CHECK(process.cpu == 0.0);
+
+	replay(scanner, fixtures::desktop(4), 4 * second, 10, info);
+
+	if (!info.top_cpu.empty()) {
+		CHECK(info.top_cpu[0].name == "cl.exe");
+		CHECK_NEAR(info.top_cpu[0].cpu, share(1.0), 0.0001);
+	}
+}
+
+TEST_CASE(process_scanner_reused_pid) {
+	process_scanner scanner;
+	process_scanner::scan_info info;
+	replay(scanner, fixtures::desktop(0), second, 10, info);
+
+	// explorer exits and its id goes to a new process with less cpu time than it had
+	auto processes = fixtures::desktop(1);
+	for (auto& process : processes)
+		if (process.pid == 1200)
+			process = { 1200, "notepad.exe", 60, 0, 12 * 1024 * 1024, 3 };
+
+	replay(scanner, processes, 2 * second, 10, info);
+
+	bool found = false;
+	for (const auto& process : info.top_memory) {
+		if (process.pid == 1200) {
+			found = true;
+			CHECK(process.name == "notepad.exe");
+			CHECK(process.cpu == 0.0);
+		}
+	}
+
+	CHECK(found);
+}
+
+TEST_CASE(process_scanner_scan_cost) {
+	// a heavily loaded server's worth of processes, to show the repeated scan stays cheap
+	const size_t processes = 10000;
+	std::vector<fixtures::process> table;
+
+	for (size_t i = 0; i < processes; i++)
+		table.push_back({ static_cast<unsigned long>((i + 1) * 4), "process_" + std::to_string(i) + ".exe",
+			static_cast<long long>(i), 0, (i * 7919) % 1000 * 1024 * 1024, 8 });
+
+	auto data = fixtures::process_table(table);
+	const size_t entry_size = data.size() / processes;
+
+	process_scanner scanner;
+	process_scanner::scan_info info;
+
+	// the first pass fills the cache, time the repeated passes that follow
+	long long time = second;
+	scanner.replay(data.data(), data.size(), time, 10, info);
+
+	const int passes = 20;
+	double total = 0.0;
+
+	for (int pass = 0; pass < passes; pass++) {
+		// some cpu time on every process so the cpu path is exercised
+		for (size_t i = 0; i < processes; i++)
+			reinterpret_cast<fixtures::system_process_information*>(data.data() + i * entry_size)->UserTime.QuadPart +=
+			static_cast<LONGLONG>(i % 97);
+
+		time += second;
+
+		const auto start = std::chrono::steady_clock::now();
+		scanner.replay(data.data(), data.size(), time, 10, info);
+		total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	CHECK(info.processes == processes);
+	CHECK(info.top_cpu.size() == 10);
+
+	const double cost = total / passes;
+	printf("process_scanner_scan_cost: %.2fms per scan of %zu processes\n", cost, processes);
+
+	// the window refreshes every two seconds
+	CHECK(cost < 100.0);
+}
@@ -0,0 +1,138 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/smbios.h"
+#include "../collectors/smbios.h"
+
+namespace {
+	std::vector<unsigned char> table(const unsigned char* data, size_t size) {
+		return std::vector<unsigned char>(data, data + size);
+	}
+
+	const unsigned long long gb = 1024ULL * 1024 * 1024;
+}
+
+TEST_CASE(smbios_dell) {
+	const auto raw = table(fixtures::dell_optiplex_7070, sizeof(fixtures::dell_optiplex_7070));
+	smbios::smbios_info info;
+	std::string error;
+	CHECK(smbios::parse_raw(raw, info, error));
+
+	CHECK(info.major_version == 3);
+	CHECK(info.minor_version == 2);
+	CHECK(info.bios.vendor == "Dell Inc.");
+	CHECK(info.bios.version == "1.6.3");
+	CHECK(info.bios.release_date == "04/13/2020");
+	CHECK(info.system.manufacturer == "Dell Inc.");
+	CHECK(info.system.product == "OptiPlex 7070");
+	CHECK(info.system.serial_number == "7XK2Q43");
+	CHECK(info.system.sku == "085A");
+	CHECK(info.system.family == "OptiPlex");
+	CHECK(info.board.product == "0YNVJG");
+
+	CHECK(info.memory_devices.size() == 2);
+
+	if (info.memory_devices.size() == 2) {
+		const auto& dimm = info.memory_devices[0];
+		CHECK(dimm.locator == "DIMM1");
+		CHECK(dimm.size == 8 * gb);
+		CHECK(smbios::memory_type(dimm.type) == "DDR4");
+		CHECK(smbios::form_factor(dimm.form_factor) == "DIMM");
+		CHECK(dimm.speed == 2666);
+		CHECK(dimm.configured_speed == 2666);
+
+		// part numbers are padded with spaces
+		CHECK(dimm.part_number == "HMA81GU6CJR8N-VK");
+
+		const auto& empty = info.memory_devices[1];
+		CHECK(empty.locator == "DIMM2");
+		CHECK(empty.size == 0);
+		CHECK(empty.manufacturer.empty());
+		CHECK(empty.part_number.empty());
+	}
+}
+
+TEST_CASE(smbios_lenovo) {
+	const auto raw = table(fixtures::lenovo_thinkpad_x1_carbon, sizeof(fixtures::lenovo_thinkpad_x1_carbon));
+	smbios::smbios_info info;
+	std::string error;
+	CHECK(smbios::parse_raw(raw, info, error));
+
+	CHECK(info.minor_version == 3);
+
+	// only the ends are trimmed
+	CHECK(info.bios.version == "N3AET72W (1.37 )");
+	CHECK(info.system.product == "21CB000GUS");
+	CHECK(info.system.family == "ThinkPad X1 Carbon Gen 10");
+	CHECK(info.board.serial_number == "L1HF2AB00AB");
+
+	CHECK(info.memory_devices.size() == 2);
+
+	for (const auto& device : info.memory_devices) {
+		CHECK(device.size == 8 * gb);
+		CHECK(smbios::memory_type(device.type) == "LPDDR5");
+		CHECK(smbios::form_factor(device.form_factor) == "Row of chips");
+		CHECK(device.speed == 5200);
+		CHECK(device.manufacturer == "Samsung");
+	}
+}
+
+TEST_CASE(smbios_supermicro) {
+	const auto raw = table(fixtures::supermicro_x11dpi, sizeof(fixtures::supermicro_x11dpi));
+	smbios::smbios_info info;
+	std::string error;
+	CHECK(smbios::parse_raw(raw, info, error));
+
+	CHECK(info.bios.vendor == "American Megatrends Inc.");
+	CHECK(info.system.sku == "To be filled by O.E.M.");
+
+	// the add-in board after the motherboard is not taken for it
+	CHECK(info.board.product == "X11DPi-N(T)");
+
+	CHECK(info.memory_devices.size() == 3);
+
+	if (info.memory_devices.size() == 3) {
+		// too big for the size word, in the extended size field
+		CHECK(info.memory_devices[0].size == 64 * gb);
+		CHECK(info.memory_devices[0].part_number == "M393A8G40AB2-CWE");
+		CHECK(info.memory_devices[1].size == 0);
+		CHECK(info.memory_devices[2].size == 64 * gb);
+		CHECK(info.memory_devices[2].locator == "P2-DIMMA1");
+	}
+}
+
+TEST_CASE(smbios_truncated) {
+	// cut off inside the second memory device, the structures before it still decode
+	const size_t header_size = 8;
+	const size_t size = sizeof(fixtures::dell_optiplex_7070) - header_size - 60;
+
+	smbios::smbios_info info;
+	std::string error;
+	CHECK(smbios::parse(fixtures::dell_optiplex_7070 + header_size, size, info, error));
+	CHECK(info.system.product == "OptiPlex 7070");
+	CHECK(info.memory_devices.size() == 1);
+
+	CHECK(!smbios::parse(fixtures::dell_optiplex_7070 + header_size, 3, info, error));
+}
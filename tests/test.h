@@ -0,0 +1,67 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// A minimal test harness, just enough to check the collectors' decoding against fixtures
+/// without pulling in a test framework.
+/// </summary>
+namespace test {
+	struct test_case {
+		const char* name;
+		void(*function)();
+	};
+
+	/// <summary>
+	/// Get all registered test cases.
+	/// </summary>
+	std::vector<test_case>& cases();
+
+	/// <summary>
+	/// Record a failed check against the running test case.
+	/// </summary>
+	void fail(const char* file, int line, const std::string& expression);
+
+	class registrar {
+	public:
+		registrar(const char* name, void(*function)()) {
+			cases().push_back({ name, function });
+		}
+	};
+}
+
+#define TEST_CASE(name)\
+	static void name();\
+	static const test::registrar name##_registrar(#name, name);\
+	static void name()
+
+#define CHECK(expression)\
+	do { if (!(expression)) test::fail(__FILE__, __LINE__, #expression); } while (false)
+
+#define CHECK_NEAR(value, expected, tolerance)\
+	CHECK(((value) - (expected)) <= (tolerance) && ((expected) - (value)) <= (tolerance))
@@ -0,0 +1,75 @@
+/*
+** MIT License
+**
+** Copyright(c) 2021 Alec Musasa
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files(the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions :
+**
+** The above copyright noticeand this permission notice shall be included in all
+** copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*/
+
+#include "test.h"
+#include "fixtures/thermal.h"
+#include "../collectors/thermal.h"
+
+TEST_CASE(thermal_zone_names) {
+	for (const auto& zone : fixtures::thermal_zones) {
+		// readings and trip points come from different sources and must meet on the zone name
+		CHECK(thermal::zone_name(zone.counter_instance) == zone.zone);
+		CHECK(thermal::zone_name(zone.wmi_instance) == zone.zone);
+
+		const auto group = thermal::classify(thermal::zone_name(zone.counter_instance));
+		CHECK((group == thermal::sensor_group::cpu) == zone.cpu);
+	}
+}
+
+TEST_CASE(thermal_readings) {
+	thermal::thermal_info info;
+
+	thermal::sensor cpu;
+	cpu.name = "CPUZ";
+	cpu.group = thermal::sensor_group::cpu;
+	cpu.temperature = 71.2;
+	cpu.critical = 100.0;
+	info.sensors.push_back(cpu);
+
+	thermal::sensor drive;
+	drive.name = "Samsung SSD 970 EVO Plus 1TB";
+	drive.group = thermal::sensor_group::drive;
+	drive.temperature = 52.0;
+	info.sensors.push_back(drive);
+
+	thermal::sensor board;
+	board.name = "TZ00";
+	board.temperature = 45.0;
+	board.critical = 105.0;
+	info.sensors.push_back(board);
+
+	CHECK(info.hottest() == &info.sensors[0]);
+	CHECK(info.critical_sensors() == 0);
+	CHECK(thermal::to_string(cpu) == "71C (critical 100C)");
+	CHECK(thermal::to_string(drive) == "52C");
+	CHECK(thermal::summary(info) == "71C hottest, 3 sensors");
+
+	// a board zone past its trip point while the cpu is cooler
+	info.sensors[2].temperature = 105.0;
+	CHECK(info.hottest() == &info.sensors[2]);
+	CHECK(info.critical_sensors() == 1);
+	CHECK(thermal::summary(info) == "105C hottest, 3 sensors, 1 critical");
+
+	CHECK(thermal::summary(thermal::thermal_info()) == "No sensors");
+}